@@ -1,4 +1,6 @@
 #include "Commands/multi.h"
+#include "FRM_Benchmark.h"
+#include "FRM_ThreadAudit.h"
 #include <regex>
 
 FChatReturn AFRMCommand::RemoteMonitoringCommand(UObject* WorldContext, class UCommandSender* Sender, TArray<FString> Arguments) {
@@ -15,7 +17,9 @@ FChatReturn AFRMCommand::RemoteMonitoringCommand(UObject* WorldContext, class UC
 			"/frm debug <file/info> <Endpoint>\n"
 			"/frm http <start/stop>\n"
 			"/frm serial <start/stop>\n"
-			"/frm icon"
+			"/frm icon\n"
+			"/frm bench [count ...]\n"
+			"/frm audit <start/stop>"
 		);
 
 		return ChatReturn;
@@ -145,6 +149,45 @@ FChatReturn AFRMCommand::RemoteMonitoringCommand(UObject* WorldContext, class UC
 		return ChatReturn;
 	}
 
+	if (command == "bench") {
+		TArray<int32> Counts;
+
+		for (int32 i = 1; i < argumentsNum; i++) {
+			Counts.Add(FMath::Clamp(FCString::Atoi(*Arguments[i]), 1000, 1000000));
+		}
+
+		ChatReturn.Chat = FFRMBenchmark::RunToDebugFolder(ModSubsystem, Counts);
+		ChatReturn.Color = FLinearColor::White;
+		ChatReturn.Status = EExecutionStatus::COMPLETED;
+
+		return ChatReturn;
+	}
+
+	if (command == "audit") {
+		ChatReturn.Chat = TEXT("Usage: /frm audit <start/stop>");
+
+		if (argumentsNum < 2) {
+			return ChatReturn;
+		}
+
+		FString arg1 = Arguments[1].ToLower();
+
+		if (arg1 == "start") {
+			FFRMThreadAudit::Get().Start();
+
+			ChatReturn.Chat = TEXT("Thread audit started. Use the endpoints as usual, then stop it with /frm audit stop.");
+			ChatReturn.Color = FLinearColor::Green;
+			ChatReturn.Status = EExecutionStatus::COMPLETED;
+		}
+		else if (arg1 == "stop") {
+			ChatReturn.Chat = FFRMThreadAudit::Get().StopToDebugFolder();
+			ChatReturn.Color = FLinearColor::White;
+			ChatReturn.Status = EExecutionStatus::COMPLETED;
+		}
+
+		return ChatReturn;
+	}
+
 	ChatReturn.Chat = TEXT("Unable to find command " + command + ", please refer to the documentation at docs.ficsit.app.");
 
 	return ChatReturn;
@@ -0,0 +1,281 @@
+#include "FRM_AccessLog.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/Paths.h"
+#include "Misc/StringBuilder.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+namespace
+{
+	// the writer polls, waking it for every request isn't worth it
+	constexpr uint32 WriterIntervalMs = 250;
+
+	const char* MonthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+	void CopyTruncated(char* Out, const size_t Size, const std::string_view Value)
+	{
+		const size_t Length = FMath::Min(Value.size(), Size - 1);
+		FMemory::Memcpy(Out, Value.data(), Length);
+		Out[Length] = '\0';
+	}
+
+	void AppendAddress(FAnsiStringBuilderBase& Out, const uint8* Address, const uint8 Length)
+	{
+		static constexpr uint8 MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+		if (Length == 16 && FMemory::Memcmp(Address, MappedPrefix, 12) == 0) {
+			Address += 12;
+			Out.Appendf("%u.%u.%u.%u", Address[0], Address[1], Address[2], Address[3]);
+		}
+		else if (Length == 16) {
+			for (int32 Group = 0; Group < 8; Group++) {
+				Out.Appendf(Group ? ":%x" : "%x", (Address[Group * 2] << 8) | Address[Group * 2 + 1]);
+			}
+		}
+		else if (Length == 4) {
+			Out.Appendf("%u.%u.%u.%u", Address[0], Address[1], Address[2], Address[3]);
+		}
+		else {
+			Out << '-';
+		}
+	}
+}
+
+FFRMAccessLog& FFRMAccessLog::Get()
+{
+	static FFRMAccessLog Instance;
+	return Instance;
+}
+
+FFRMAccessLog::~FFRMAccessLog()
+{
+	Stop();
+}
+
+void FFRMAccessLog::Start(const FString& InPath, const FFRMAccessLogSettings& InSettings)
+{
+	Stop();
+
+	Path = InPath;
+	Settings = InSettings;
+	Settings.SampleRate = FMath::Max(Settings.SampleRate, 1);
+	Settings.MaxFiles = FMath::Max(Settings.MaxFiles, 1);
+	SetLevel(Settings.Level);
+
+	if (!Slots) {
+		Slots = MakeUnique<FSlot[]>(Capacity);
+	}
+	for (uint64 Index = 0; Index < Capacity; Index++) {
+		Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+	}
+	Head.store(0, std::memory_order_relaxed);
+	Tail = 0;
+
+	bStopRequested = false;
+	WakeUp = FPlatformProcess::GetSynchEventFromPool(false);
+	bRunning = true;
+
+	Writer = Async(EAsyncExecution::Thread, [this]() {
+		WriterLoop();
+	});
+}
+
+void FFRMAccessLog::Stop()
+{
+	if (!bRunning) return;
+
+	bRunning = false;
+	bStopRequested = true;
+	WakeUp->Trigger();
+	Writer.Wait();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeUp);
+	WakeUp = nullptr;
+}
+
+void FFRMAccessLog::Record(const std::string_view Address, const std::string_view Method, const std::string_view Path, const std::string_view Query, const uint16 Status, const uint64 Bytes)
+{
+	const int32 CurrentLevel = GetLevel();
+	if (CurrentLevel <= 0 || !bRunning.load(std::memory_order_acquire)) return;
+
+	if (Status < 400) {
+		if (CurrentLevel < 2) return;
+		if (SampleCounter.fetch_add(1, std::memory_order_relaxed) % Settings.SampleRate != 0) return;
+	}
+
+	FRecord NewRecord;
+	NewRecord.Ticks = FDateTime::UtcNow().GetTicks();
+	NewRecord.Bytes = Bytes;
+	NewRecord.Status = Status;
+
+	NewRecord.AddressLength = static_cast<uint8>(FMath::Min<size_t>(Address.size(), sizeof(NewRecord.Address)));
+	FMemory::Memcpy(NewRecord.Address, Address.data(), NewRecord.AddressLength);
+
+	CopyTruncated(NewRecord.Method, sizeof(NewRecord.Method), Method);
+
+	// path and query are copied separately, the query is what gets cut if both don't fit
+	CopyTruncated(NewRecord.Target, sizeof(NewRecord.Target), Path);
+	if (!Query.empty()) {
+		const size_t PathLength = FCStringAnsi::Strlen(NewRecord.Target);
+		if (PathLength + 2 < sizeof(NewRecord.Target)) {
+			NewRecord.Target[PathLength] = '?';
+			CopyTruncated(NewRecord.Target + PathLength + 1, sizeof(NewRecord.Target) - PathLength - 1, Query);
+		}
+	}
+
+	if (!Push(NewRecord)) {
+		Dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool FFRMAccessLog::Push(const FRecord& InRecord)
+{
+	// bounded multi-producer ring: a slot is free for position Pos once its sequence equals Pos
+	uint64 Position = Head.load(std::memory_order_relaxed);
+	FSlot* Slot = nullptr;
+
+	while (true) {
+		Slot = &Slots[Position & (Capacity - 1)];
+		const int64 Difference = static_cast<int64>(Slot->Sequence.load(std::memory_order_acquire)) - static_cast<int64>(Position);
+
+		if (Difference == 0) {
+			if (Head.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed)) break;
+		}
+		else if (Difference < 0) {
+			// the writer has not caught up with a whole ring
+			return false;
+		}
+		else {
+			Position = Head.load(std::memory_order_relaxed);
+		}
+	}
+
+	Slot->Record = InRecord;
+	Slot->Sequence.store(Position + 1, std::memory_order_release);
+	return true;
+}
+
+bool FFRMAccessLog::Pop(FRecord& OutRecord)
+{
+	FSlot& Slot = Slots[Tail & (Capacity - 1)];
+	if (Slot.Sequence.load(std::memory_order_acquire) != Tail + 1) return false;
+
+	OutRecord = Slot.Record;
+	Slot.Sequence.store(Tail + Capacity, std::memory_order_release);
+	Tail++;
+	return true;
+}
+
+void FFRMAccessLog::WriterLoop()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*Path, true, true));
+	if (!File) {
+		UE_LOGFMT(LogHttpServer, Error, "Access log could not be opened: {Path}", Path);
+	}
+
+	TAnsiStringBuilder<16384> Lines;
+
+	while (true) {
+		// read before draining, requests recorded before Stop() are written
+		const bool bStop = bStopRequested;
+
+		FRecord NextRecord;
+		while (Pop(NextRecord)) {
+			Format(NextRecord, Lines);
+
+			if (Lines.Len() > 12 * 1024) {
+				if (File) File->Write(reinterpret_cast<const uint8*>(Lines.GetData()), Lines.Len());
+				Lines.Reset();
+			}
+		}
+
+		if (Lines.Len() > 0) {
+			if (File) File->Write(reinterpret_cast<const uint8*>(Lines.GetData()), Lines.Len());
+			Lines.Reset();
+		}
+
+		if (const uint64 Lost = Dropped.exchange(0, std::memory_order_relaxed)) {
+			UE_LOGFMT(LogHttpServer, Warning, "Access log dropped {Lost} requests, the writer fell behind", Lost);
+		}
+
+		if (File && File->Size() >= Settings.MaxFileSize) {
+			File.Reset();
+			Rotate();
+			File.Reset(PlatformFile.OpenWrite(*Path, true, true));
+		}
+
+		if (bStop) break;
+
+		WakeUp->Wait(WriterIntervalMs);
+	}
+
+	if (File) File->Flush();
+}
+
+void FFRMAccessLog::Rotate()
+{
+	IFileManager& FileManager = IFileManager::Get();
+	const FString Base = FPaths::GetBaseFilename(Path, false);
+	const FString Extension = FPaths::GetExtension(Path, true);
+
+	const auto GetRotatedPath = [&Base, &Extension](const int32 Index) {
+		return FString::Printf(TEXT("%s.%d%s"), *Base, Index, *Extension);
+	};
+
+	FileManager.Delete(*GetRotatedPath(Settings.MaxFiles - 1), false, true, true);
+	for (int32 Index = Settings.MaxFiles - 2; Index >= 1; Index--) {
+		FileManager.Move(*GetRotatedPath(Index + 1), *GetRotatedPath(Index), true, true, false, true);
+	}
+
+	if (Settings.MaxFiles > 1) {
+		FileManager.Move(*GetRotatedPath(1), *Path, true, true, false, true);
+	}
+	else {
+		FileManager.Delete(*Path, false, true, true);
+	}
+}
+
+void FFRMAccessLog::Format(const FRecord& InRecord, FAnsiStringBuilderBase& Out)
+{
+	// host ident authuser [date] "request" status bytes
+	const FDateTime Time(InRecord.Ticks);
+
+	AppendAddress(Out, InRecord.Address, InRecord.AddressLength);
+	Out.Appendf(" - - [%02d/%s/%04d:%02d:%02d:%02d +0000] \"",
+		Time.GetDay(), MonthNames[Time.GetMonth() - 1], Time.GetYear(), Time.GetHour(), Time.GetMinute(), Time.GetSecond());
+
+	for (const char* Char = InRecord.Method; *Char; Char++) {
+		Out << FCharAnsi::ToUpper(*Char);
+	}
+
+	// quotes and control characters would break the line apart
+	Out << ' ';
+	for (const char* Char = InRecord.Target; *Char; Char++) {
+		Out << (*Char == '"' || static_cast<uint8>(*Char) < 0x20 ? '_' : *Char);
+	}
+
+	if (InRecord.Bytes > 0) {
+		Out.Appendf(" HTTP/1.1\" %u %llu\n", InRecord.Status, InRecord.Bytes);
+	}
+	else {
+		Out.Appendf(" HTTP/1.1\" %u -\n", InRecord.Status);
+	}
+}
+
+static FAutoConsoleCommand FRMAccessLogCommand(
+	TEXT("FRM.AccessLog"),
+	TEXT("Sets what the FRM access log records: 0 = nothing, 1 = failed requests, 2 = everything. Usage: FRM.AccessLog <level>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		if (Args.Num() && Args[0].IsNumeric()) {
+			FFRMAccessLog::Get().SetLevel(FCString::Atoi(*Args[0]));
+		}
+		UE_LOG(LogHttpServer, Display, TEXT("Access log level: %d"), FFRMAccessLog::Get().GetLevel());
+	})
+);
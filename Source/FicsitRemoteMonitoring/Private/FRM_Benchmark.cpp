@@ -0,0 +1,441 @@
+#include "FRM_Benchmark.h"
+
+#include <string>
+
+#include "FicsitRemoteMonitoring.h"
+#include "FRM_Library.h"
+#include "FRM_Request.h"
+#include "FRM_ResponseCache.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+
+namespace
+{
+	// Satisfactory's playable area, in cm
+	constexpr float WorldMinX = -320000.0f;
+	constexpr float WorldMaxX = 420000.0f;
+	constexpr float WorldMinY = -370000.0f;
+	constexpr float WorldMaxY = 370000.0f;
+
+	// a request mix seen by the web UI and common third party dashboards
+	const std::string SampleQueries[] = {
+		"",
+		"timing=1",
+		"ID=Build_AssemblerMk1_C_2147480000",
+		"bbox=-120000.5%2C-80000%2C40000%2C95000.25&lod=2",
+		"id=Build_ConveyorBeltMk5_C_1%2CBuild_ConveyorBeltMk5_C_2%2CBuild_ConveyorBeltMk5_C_3&name=Iron+Plate",
+	};
+
+	constexpr int32 FixedOperations = 10000;
+
+	FInventoryStack MakeStack(const TSubclassOf<UFGItemDescriptor>& Item, const int32 NumItems)
+	{
+		FInventoryStack Stack;
+		Stack.Item = FInventoryItem(Item);
+		Stack.NumItems = NumItems;
+		return Stack;
+	}
+
+	// loaded, instantiable subclasses of T by name, so the same seed picks the same classes on every run
+	template<typename T>
+	TArray<TSubclassOf<T>> GetLoadedClasses(const int32 MaxClasses)
+	{
+		TArray<TSubclassOf<T>> Classes;
+		for (TObjectIterator<UClass> It; It; ++It)
+		{
+			UClass* Class = *It;
+			if (!Class->IsChildOf(T::StaticClass()) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists)) continue;
+			if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_"))) continue;
+
+			Classes.Add(Class);
+		}
+
+		Classes.Sort([](const TSubclassOf<T>& A, const TSubclassOf<T>& B) { return A->GetName() < B->GetName(); });
+		if (Classes.Num() > MaxClasses) Classes.SetNum(MaxClasses);
+		if (Classes.IsEmpty()) Classes.Add(T::StaticClass());
+
+		return Classes;
+	}
+
+	FString ResultKey(const FString& Name, const int32 Count)
+	{
+		return FString::Printf(TEXT("%s@%d"), *Name, Count);
+	}
+}
+
+void FFRMSyntheticWorld::Generate(const int32 Count, const int32 Seed)
+{
+	FRandomStream Random(Seed);
+
+	Items = GetLoadedClasses<UFGItemDescriptor>(256);
+	const TArray<TSubclassOf<UFGRecipe>> Recipes = GetLoadedClasses<UFGRecipe>(200);
+	const TArray<TSubclassOf<AFGBuildableManufacturer>> Manufacturers = GetLoadedClasses<AFGBuildableManufacturer>(16);
+
+	auto RandomItem = [this, &Random]() { return Items[Random.RandHelper(Items.Num())]; };
+	auto RandomLocation = [&Random]() {
+		return FVector(Random.FRandRange(WorldMinX, WorldMaxX), Random.FRandRange(WorldMinY, WorldMaxY), Random.FRandRange(-5000.0f, 40000.0f));
+	};
+
+	Factories.SetNum(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		FFRMFactoryRow& Factory = Factories[i];
+		Factory.ID = FString::Printf(TEXT("Build_AssemblerMk1_C_%d"), i);
+		Factory.Name = TEXT("Assembler");
+		Factory.Class = Manufacturers[Random.RandHelper(Manufacturers.Num())];
+		Factory.Recipe = Recipes[Random.RandHelper(Recipes.Num())];
+		Factory.Location = RandomLocation();
+		Factory.Yaw = Random.FRandRange(-180.0f, 180.0f);
+		Factory.CycleTime = Random.FRandRange(2.0f, 60.0f);
+		Factory.Productivity = Random.FRand();
+		Factory.Potential = Random.FRandRange(0.01f, 2.5f);
+		Factory.ManufacturingSpeed = Factory.Potential;
+		Factory.bIsConfigured = true;
+		Factory.bIsProducing = Factory.Productivity > 0.05f;
+		Factory.bIsPaused = Random.RandHelper(50) == 0;
+		Factory.PowerInfo.CircuitGroupID = Factory.PowerInfo.CircuitID = Random.RandHelper(FMath::Max(1, Count / 500));
+		Factory.PowerInfo.MaxPowerConsumed = Random.FRandRange(4.0f, 1500.0f);
+		Factory.PowerInfo.PowerConsumed = Factory.PowerInfo.MaxPowerConsumed * Factory.Productivity;
+
+		for (int32 p = Random.RandRange(1, 2); p > 0; p--)
+		{
+			Factory.Products.Add({RandomItem(), Random.RandRange(1, 10), Random.RandRange(0, 200)});
+		}
+		for (int32 p = Random.RandRange(1, 4); p > 0; p--)
+		{
+			Factory.Ingredients.Add({RandomItem(), Random.RandRange(1, 30), Random.RandRange(0, 200)});
+		}
+	}
+
+	const TSharedRef<FFRMWorldSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FFRMWorldSnapshot, ESPMode::ThreadSafe>();
+
+	Snapshot->Belts.SetNum(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		// connection points are relative to the belt, like the live snapshot stores them
+		FFRMBeltRow& Belt = Snapshot->Belts[i];
+		Belt.ID = FName(*FString::Printf(TEXT("Build_ConveyorBeltMk5_C_%d"), i));
+		Belt.Name = TEXT("Conveyor Belt Mk.5");
+		Belt.ClassName = TEXT("Build_ConveyorBeltMk5_C");
+		Belt.Location = RandomLocation();
+		Belt.Length = Random.FRandRange(100.0f, 5600.0f);
+		Belt.Location1 = Random.GetUnitVector() * Belt.Length;
+		Belt.bConnected0 = Belt.bConnected1 = true;
+		Belt.Speed = 1560.0f;
+	}
+
+	Snapshot->Storages.SetNum(FMath::Max(1, Count / 10));
+	Snapshot->WorldInventory.Amounts.SetNumZeroed(FFRMItemRegistry::Get().Num());
+
+	TArray<FInventoryStack> Inventory;
+	for (int32 i = 0; i < Snapshot->Storages.Num(); i++)
+	{
+		FFRMStorageRow& Storage = Snapshot->Storages[i];
+		Storage.ID = FName(*FString::Printf(TEXT("Build_StorageContainerMk2_C_%d"), i));
+		Storage.Name = TEXT("Storage Container Mk.2");
+		Storage.ClassName = TEXT("Build_StorageContainerMk2_C");
+		Storage.Location = RandomLocation();
+		Storage.Yaw = Random.FRandRange(-180.0f, 180.0f);
+
+		// a handful of items spread over 48 slots, so grouping has duplicates to merge
+		const auto First = RandomItem();
+		const auto Second = RandomItem();
+		Inventory.Reset();
+		for (int32 Slot = 0; Slot < 48; Slot++)
+		{
+			Inventory.Add(MakeStack(Random.RandHelper(4) == 0 ? RandomItem() : (Slot % 2 ? First : Second), Random.RandRange(1, 500)));
+		}
+
+		// the same passes FFRMWorldSnapshot::Build makes
+		UFRM_Library::GetGroupedInventoryItems(Inventory, Storage.Inventory);
+		Snapshot->WorldInventory.Add(Storage.Inventory);
+	}
+
+	Snapshots.Publish(Snapshot);
+}
+
+TArray<TSharedPtr<FJsonValue>> FFRMSyntheticWorld::GetFactory() const
+{
+	// what getFactory's time slicer does for each manufacturer, minus reading the actor
+	TArray<TSharedPtr<FJsonValue>> JFactoryArray;
+	JFactoryArray.Reserve(Factories.Num());
+
+	for (const FFRMFactoryRow& Factory : Factories)
+	{
+		JFactoryArray.Add(MakeShared<FJsonValueObject>(UFRM_Factory::GetFactoryRowJSON(Factory)));
+	}
+
+	return JFactoryArray;
+}
+
+TArray<TSharedPtr<FJsonValue>> FFRMSyntheticWorld::GetBelts() const
+{
+	return UFRM_Factory::getBelts(nullptr, FRequestData(), Polylines, Snapshots);
+}
+
+TArray<TSharedPtr<FJsonValue>> FFRMSyntheticWorld::GetStorageInv() const
+{
+	return UFRM_Factory::getStorageInv(nullptr, FRequestData(), Snapshots);
+}
+
+TArray<TSharedPtr<FJsonValue>> FFRMSyntheticWorld::GetWorldInv() const
+{
+	return UFRM_Factory::getWorldInv(nullptr, FRequestData(), Snapshots);
+}
+
+FFRMBenchmark::FFRMBenchmark(const AFicsitRemoteMonitoring* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+}
+
+void FFRMBenchmark::Measure(const FString& Name, const int32 Count, const int32 Iterations, TFunctionRef<uint64()> Body)
+{
+	FFRMBenchmarkResult Result;
+	Result.Name = Name;
+	Result.Count = Count;
+	Result.Iterations = Iterations;
+
+	// warm-up, the first pass pays for allocator growth and cold CDO lookups
+	Result.Bytes = Body();
+
+	TArray<double> Samples;
+	Samples.Reserve(Iterations);
+
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const double StartedAt = FPlatformTime::Seconds();
+		Result.Bytes = Body();
+		Samples.Add(FPlatformTime::Seconds() - StartedAt);
+	}
+
+	Samples.Sort();
+
+	double Total = 0.0;
+	for (const double Sample : Samples) Total += Sample;
+
+	Result.MinSeconds = Samples[0];
+	Result.MedianSeconds = Samples[Samples.Num() / 2];
+	Result.MeanSeconds = Total / Samples.Num();
+
+	UE_LOGFMT(LogFRMDebug, Log, "Benchmark {Name} ({Count}): median {Median} ms, min {Min} ms over {Iterations} iterations",
+		Name, Count, Result.MedianSeconds * 1000, Result.MinSeconds * 1000, Iterations);
+
+	Results.Add(Result);
+}
+
+void FFRMBenchmark::Run(const TArray<int32>& Counts)
+{
+	Results.Reset();
+
+	// request plumbing that does not depend on the world size
+	if (Subsystem && Subsystem->APIEndpoints.Num())
+	{
+		TArray<FString> Names;
+		for (const FAPIEndpoint& Endpoint : Subsystem->APIEndpoints) Names.Add(Endpoint.APIName);
+		Names.Add(TEXT("getUnknownEndpoint"));
+
+		Measure(TEXT("router.findEndpoint"), FixedOperations, 20, [this, &Names]() {
+			uint64 Found = 0;
+			TArray<FString> AvailableMethods;
+			for (int32 i = 0; i < FixedOperations; i++)
+			{
+				AvailableMethods.Reset();
+				Found += Subsystem->FindEndpoint(Names[i % Names.Num()], TEXT("GET"), AvailableMethods) != nullptr;
+			}
+			return Found;
+		});
+	}
+
+	Measure(TEXT("query.parse"), FixedOperations, 20, []() {
+		uint64 Pairs = 0;
+		for (int32 i = 0; i < FixedOperations; i++)
+		{
+			Pairs += ParseQueryString(SampleQueries[i % UE_ARRAY_COUNT(SampleQueries)]).size();
+		}
+		return Pairs;
+	});
+
+	{
+		FFRMResponseCache Cache;
+		FCachedResponse Cached;
+		Cached.Payload = MakeShared<std::string, ESPMode::ThreadSafe>(4096, 'x');
+		Cached.bSuccess = true;
+
+		// fills the entry every hit below is served from
+		if (Cache.Acquire(TEXT("getFactory?"), 60.0, Cached, [](const FCachedResponse&) {}) == EFRMCacheLookup::Miss)
+		{
+			Cache.Complete(TEXT("getFactory?"), 60.0, Cached);
+		}
+
+		Measure(TEXT("cache.hit"), FixedOperations, 20, [&Cache]() {
+			FCachedResponse Response;
+			uint64 Hits = 0;
+			for (int32 i = 0; i < FixedOperations; i++)
+			{
+				Hits += Cache.Acquire(TEXT("getFactory?"), 60.0, Response, [](const FCachedResponse&) {}) == EFRMCacheLookup::Hit;
+			}
+			return Hits;
+		});
+
+		// an expired entry goes through the single-flight path on every lookup
+		Measure(TEXT("cache.miss"), FixedOperations, 20, [&Cache, &Cached]() {
+			FCachedResponse Response;
+			uint64 Misses = 0;
+			for (int32 i = 0; i < FixedOperations; i++)
+			{
+				if (Cache.Acquire(TEXT("getFactory?"), -1.0, Response, [](const FCachedResponse&) {}) == EFRMCacheLookup::Miss)
+				{
+					Cache.Complete(TEXT("getFactory?"), -1.0, Cached);
+					Misses++;
+				}
+			}
+			return Misses;
+		});
+	}
+
+	for (const int32 Count : Counts)
+	{
+		FFRMSyntheticWorld World;
+		World.Generate(Count);
+
+		// keep the total runtime of the big worlds bounded
+		const int32 Iterations = FMath::Clamp(200000 / Count, 3, 50);
+
+		TArray<TSharedPtr<FJsonValue>> Rows;
+
+		Measure(TEXT("collect.getBelts"), Count, Iterations, [&World, &Rows]() { Rows = World.GetBelts(); return 0; });
+		Measure(TEXT("collect.getStorageInv"), Count, Iterations, [&World, &Rows]() { Rows = World.GetStorageInv(); return 0; });
+		Measure(TEXT("collect.getWorldInv"), Count, Iterations, [&World, &Rows]() { Rows = World.GetWorldInv(); return 0; });
+
+		// getFactory is the largest payload, so it is the one run through the serializers
+		Measure(TEXT("collect.getFactory"), Count, Iterations, [&World, &Rows]() { Rows = World.GetFactory(); return 0; });
+
+		FString Json;
+		Measure(TEXT("serialize.condensed"), Count, Iterations, [&Rows, &Json]() {
+			Json = UFRM_RequestLibrary::JsonArrayToString(Rows, false);
+			return static_cast<uint64>(Json.Len()) * sizeof(TCHAR);
+		});
+
+		Measure(TEXT("serialize.pretty"), Count, Iterations, [&Rows]() {
+			const FString Pretty = UFRM_RequestLibrary::JsonArrayToString(Rows, true);
+			return static_cast<uint64>(Pretty.Len()) * sizeof(TCHAR);
+		});
+
+		Measure(TEXT("serialize.utf8"), Count, Iterations, [&Json]() {
+			const FTCHARToUTF8 Converted(*Json);
+			const std::string Payload(Converted.Get(), Converted.Length());
+			return static_cast<uint64>(Payload.size());
+		});
+	}
+}
+
+FString FFRMBenchmark::Summary() const
+{
+	FString Summary;
+
+	for (const FFRMBenchmarkResult& Result : Results)
+	{
+		Summary += FString::Printf(TEXT("%-22s %8d  %10.3f ms\n"), *Result.Name, Result.Count, Result.MedianSeconds * 1000);
+	}
+
+	return Summary;
+}
+
+bool FFRMBenchmark::Save(const FString& Path, const FString& BaselinePath) const
+{
+	TMap<FString, double> Baseline;
+
+	FString BaselineJson;
+	if (FFileHelper::LoadFileToString(BaselineJson, *BaselinePath))
+	{
+		TSharedPtr<FJsonObject> JBaseline;
+		if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineJson), JBaseline) && JBaseline.IsValid())
+		{
+			const TArray<TSharedPtr<FJsonValue>>* JResults;
+			if (JBaseline->TryGetArrayField(TEXT("results"), JResults))
+			{
+				for (const TSharedPtr<FJsonValue>& JValue : *JResults)
+				{
+					const TSharedPtr<FJsonObject> JResult = JValue->AsObject();
+					if (!JResult.IsValid()) continue;
+
+					Baseline.Add(ResultKey(JResult->GetStringField(TEXT("name")), JResult->GetIntegerField(TEXT("count"))), JResult->GetNumberField(TEXT("medianMs")));
+				}
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JResults;
+
+	for (const FFRMBenchmarkResult& Result : Results)
+	{
+		TSharedPtr<FJsonObject> JResult = MakeShared<FJsonObject>();
+		const double MedianMs = Result.MedianSeconds * 1000;
+
+		JResult->Values.Add("name", MakeShared<FJsonValueString>(Result.Name));
+		JResult->Values.Add("count", MakeShared<FJsonValueNumber>(Result.Count));
+		JResult->Values.Add("iterations", MakeShared<FJsonValueNumber>(Result.Iterations));
+		JResult->Values.Add("minMs", MakeShared<FJsonValueNumber>(Result.MinSeconds * 1000));
+		JResult->Values.Add("medianMs", MakeShared<FJsonValueNumber>(MedianMs));
+		JResult->Values.Add("meanMs", MakeShared<FJsonValueNumber>(Result.MeanSeconds * 1000));
+		JResult->Values.Add("nsPerItem", MakeShared<FJsonValueNumber>(Result.Count ? Result.MedianSeconds * 1e9 / Result.Count : 0));
+		JResult->Values.Add("bytes", MakeShared<FJsonValueNumber>(Result.Bytes));
+
+		if (const double* BaselineMs = Baseline.Find(ResultKey(Result.Name, Result.Count)))
+		{
+			JResult->Values.Add("baselineMedianMs", MakeShared<FJsonValueNumber>(*BaselineMs));
+			JResult->Values.Add("changePercent", MakeShared<FJsonValueNumber>(100 * UKismetMathLibrary::SafeDivide(MedianMs - *BaselineMs, *BaselineMs)));
+		}
+
+		JResults.Add(MakeShared<FJsonValueObject>(JResult));
+	}
+
+	TSharedPtr<FJsonObject> JBenchmark = MakeShared<FJsonObject>();
+	JBenchmark->Values.Add("version", MakeShared<FJsonValueNumber>(1));
+	JBenchmark->Values.Add("timestamp", MakeShared<FJsonValueString>(FDateTime::UtcNow().ToIso8601()));
+	JBenchmark->Values.Add("engine", MakeShared<FJsonValueString>(FEngineVersion::Current().ToString()));
+	JBenchmark->Values.Add("cpu", MakeShared<FJsonValueString>(FPlatformMisc::GetCPUBrand().TrimStartAndEnd()));
+	JBenchmark->Values.Add("cores", MakeShared<FJsonValueNumber>(FPlatformMisc::NumberOfCoresIncludingHyperthreads()));
+	JBenchmark->Values.Add("results", MakeShared<FJsonValueArray>(JResults));
+
+	return FFileHelper::SaveStringToFile(UFRM_RequestLibrary::JsonObjectToString(JBenchmark, true), *Path);
+}
+
+FString FFRMBenchmark::RunToDebugFolder(const AFicsitRemoteMonitoring* Subsystem, const TArray<int32>& Counts)
+{
+	FFRMBenchmark Benchmark(Subsystem);
+	Benchmark.Run(Counts.Num() ? Counts : TArray<int32>{1000, 10000, 100000});
+
+	const FString Folder = FPaths::ProjectDir() + "Mods/FicsitRemoteMonitoring/Debug/";
+	const FString Path = Folder + "Benchmark.json";
+
+	if (!Benchmark.Save(Path, Folder + "Benchmark.baseline.json"))
+	{
+		return TEXT("Benchmark finished, but the results could not be written to ") + Path;
+	}
+
+	UE_LOGFMT(LogFRMDebug, Log, "Benchmark results:\n{Summary}", Benchmark.Summary());
+
+	return TEXT("Benchmark saved to the Debug folder as Benchmark.json. Rename it to Benchmark.baseline.json to compare later runs against it.");
+}
+
+static FAutoConsoleCommandWithWorldAndArgs FRMBenchmarkCommand(
+	TEXT("FRM.Benchmark"),
+	TEXT("Benchmarks the FRM request pipeline against synthetic worlds. Usage: FRM.Benchmark [count ...], counts between 1000 and 1000000."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+		TArray<int32> Counts;
+		for (const FString& Arg : Args)
+		{
+			Counts.Add(FMath::Clamp(FCString::Atoi(*Arg), 1000, 1000000));
+		}
+
+		UE_LOG(LogFRMDebug, Display, TEXT("%s"), *FFRMBenchmark::RunToDebugFolder(World ? AFicsitRemoteMonitoring::Get(World) : nullptr, Counts));
+	})
+);
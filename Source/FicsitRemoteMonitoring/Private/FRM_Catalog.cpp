@@ -0,0 +1,145 @@
+#include "FRM_Catalog.h"
+
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Governor.h"
+#include "FRM_Request.h"
+#include "FRM_ThreadAudit.h"
+
+FFRMCatalogCache::FFRMCatalogCache()
+	: State(MakeShared<FState, ESPMode::ThreadSafe>())
+{
+}
+
+void FFRMCatalogCache::Register(const FString& APIName, const bool bProgress, FBuildFunction Build)
+{
+	FScopeLock Lock(&State->Mutex);
+
+	FEntry& Entry = State->Entries.FindOrAdd(APIName);
+	Entry.Build = MoveTemp(Build);
+	Entry.bProgress = bProgress;
+	Entry.Generation = ++State->Generation;
+}
+
+void FFRMCatalogCache::Start(const bool bInDebugMode)
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	bDebugMode = bInDebugMode;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFRMCatalogCache::Tick));
+}
+
+void FFRMCatalogCache::Stop()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	// serializations still running find no entry to store into
+	FScopeLock Lock(&State->Mutex);
+	State->Entries.Empty();
+}
+
+void FFRMCatalogCache::Invalidate()
+{
+	FScopeLock Lock(&State->Mutex);
+
+	for (TPair<FString, FEntry>& Entry : State->Entries) {
+		if (!Entry.Value.bProgress) continue;
+
+		Entry.Value.Generation = ++State->Generation;
+		Entry.Value.bBuilt = false;
+		Entry.Value.JsonValues.Empty();
+		Entry.Value.Payload.Reset();
+	}
+}
+
+TSharedPtr<const std::string, ESPMode::ThreadSafe> FFRMCatalogCache::FindPayload(const FString& APIName) const
+{
+	FScopeLock Lock(&State->Mutex);
+
+	const FEntry* Entry = State->Entries.Find(APIName);
+	return Entry ? Entry->Payload : nullptr;
+}
+
+bool FFRMCatalogCache::Get(const FString& APIName, TArray<TSharedPtr<FJsonValue>>& OutJsonArray)
+{
+	{
+		FScopeLock Lock(&State->Mutex);
+
+		const FEntry* Entry = State->Entries.Find(APIName);
+		if (!Entry) return false;
+
+		if (Entry->bBuilt) {
+			FRM_AUDIT_CACHE("FFRMCatalogCache");
+			OutJsonArray = Entry->JsonValues;
+			return true;
+		}
+	}
+
+	OutJsonArray = Build(APIName);
+	return true;
+}
+
+bool FFRMCatalogCache::Tick(float DeltaTime)
+{
+	FString Cold;
+	{
+		FScopeLock Lock(&State->Mutex);
+
+		for (const TPair<FString, FEntry>& Entry : State->Entries) {
+			if (!Entry.Value.bBuilt) {
+				Cold = Entry.Key;
+				break;
+			}
+		}
+	}
+
+	if (Cold.IsEmpty()) return true;
+
+	// one catalog per frame, getRecipes alone calls a Blueprint event for every recipe
+	FRM_TRACE_SCOPE("FRM::CatalogWarmUp");
+	FFRMGovernor::FScope GovernorScope;
+	Build(Cold);
+
+	return true;
+}
+
+TArray<TSharedPtr<FJsonValue>> FFRMCatalogCache::Build(const FString& APIName)
+{
+	FBuildFunction BuildFunction;
+	uint32 Generation = 0;
+	{
+		FScopeLock Lock(&State->Mutex);
+
+		const FEntry* Entry = State->Entries.Find(APIName);
+		if (!Entry) return {};
+
+		BuildFunction = Entry->Build;
+		Generation = Entry->Generation;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JsonValues = BuildFunction();
+
+	FScopeLock Lock(&State->Mutex);
+
+	FEntry* Entry = State->Entries.Find(APIName);
+	if (!Entry || Entry->Generation != Generation || Entry->bBuilt) return JsonValues;
+
+	Entry->JsonValues = JsonValues;
+	Entry->bBuilt = true;
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [State = State, APIName, Generation, JsonValues, bDebug = bDebugMode]() {
+		FRM_TRACE_SCOPE("FRM::CatalogSerialize");
+
+		const FString Json = UFRM_RequestLibrary::JsonArrayToString(JsonValues, bDebug);
+		const TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload = MakeShared<const std::string, ESPMode::ThreadSafe>(TCHAR_TO_UTF8(*Json));
+
+		FScopeLock Lock(&State->Mutex);
+		if (FEntry* Entry = State->Entries.Find(APIName); Entry && Entry->Generation == Generation) {
+			Entry->Payload = Payload;
+		}
+	});
+
+	return JsonValues;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "FRM_Drones.h"
+#include "FRM_NameCache.h"
+#include "FRM_ThreadAudit.h"
 
 FString UFRM_Drones::getDronePortName(AFGBuildableDroneStation* DroneStation) {
 	AFGDroneStationInfo* StationInfo = DroneStation->GetInfo();
@@ -8,11 +10,16 @@ FString UFRM_Drones::getDronePortName(AFGBuildableDroneStation* DroneStation) {
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDroneStation(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getDroneStation");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableDroneStation*> DroneStations;
 
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableDroneStation>(DroneStations);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableDroneStation>(DroneStations);
+	}
 
 	TArray<TSharedPtr<FJsonValue>> JDroneStationArray;
 
@@ -60,7 +67,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDroneStation(UObject* WorldContex
 
 		TSharedPtr<FJsonObject> JActiveFuel = MakeShared<FJsonObject>();
 		FFGDroneFuelInformation ActiveFuelInfo =  StationInfo->GetActiveFuelInfo();
-		JActiveFuel->SetStringField("FuelName", UFGItemDescriptor::GetItemName(ActiveFuelInfo.FuelItemDescriptor).ToString());
+		JActiveFuel->Values.Add("FuelName", FFRMNameCache::Find(ActiveFuelInfo.FuelItemDescriptor)->JDisplayName);
 		JActiveFuel->SetNumberField("SingleTripFuelCost", ActiveFuelInfo.SingleTripFuelCost);
 		JActiveFuel->SetNumberField("EstimatedTransportRate", ActiveFuelInfo.EstimatedTransportRate);
 		JActiveFuel->SetNumberField("EstimatedRoundTripTime", ActiveFuelInfo.EstimatedRoundTripTime);
@@ -73,7 +80,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDroneStation(UObject* WorldContex
 
 			TSharedPtr<FJsonObject> JFuelInfo = MakeShared<FJsonObject>();
 
-			JFuelInfo->SetStringField("FuelName", UFGItemDescriptor::GetItemName(FuelInfo.FuelItemDescriptor).ToString());
+			JFuelInfo->Values.Add("FuelName", FFRMNameCache::Find(FuelInfo.FuelItemDescriptor)->JDisplayName);
 			JFuelInfo->SetNumberField("SingleTripFuelCost", FuelInfo.SingleTripFuelCost);
 			JFuelInfo->SetNumberField("EstimatedTransportRate", FuelInfo.EstimatedTransportRate);
 			JFuelInfo->SetNumberField("EstimatedRoundTripTime", FuelInfo.EstimatedRoundTripTime);
@@ -82,7 +89,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDroneStation(UObject* WorldContex
 		}
 
 		JDroneStation->Values.Add("Name", MakeShared<FJsonValueString>(UFRM_Drones::getDronePortName(DroneStation)));
-		JDroneStation->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(DroneStation->GetClass())));
+		JDroneStation->Values.Add("ClassName", FFRMNameCache::Find(DroneStation->GetClass())->JClassName);
 		JDroneStation->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(DroneStation)));
 		JDroneStation->Values.Add("InputInventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(InputInventory)));
 		JDroneStation->Values.Add("OutputInventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(OutputInventory)));
@@ -123,11 +130,15 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDroneStation(UObject* WorldContex
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDrone(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getDrone");
 
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JDroneArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGDroneVehicle::StaticClass(), FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGDroneVehicle::StaticClass(), FoundActors);
+	}
 
 	for (AActor* FoundActor : FoundActors) {
 		AFGDroneVehicle* Drone = Cast<AFGDroneVehicle>(FoundActor);
@@ -158,7 +169,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Drones::getDrone(UObject* WorldContext) {
 		};
 
 		JDrone->Values.Add("Name", MakeShared<FJsonValueString>(Drone->mDisplayName.ToString()));
-		JDrone->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Drone->GetClass())));
+		JDrone->Values.Add("ClassName", FFRMNameCache::Find(Drone->GetClass())->JClassName);
 		JDrone->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Drone)));
 		JDrone->Values.Add("HomeStation", MakeShared<FJsonValueString>(UFRM_Drones::getDronePortName(Drone->GetHomeStation())));
 		JDrone->Values.Add("PairedStation", MakeShared<FJsonValueString>(PairedStation));
@@ -0,0 +1,267 @@
+#include "FRM_EntityIndex.h"
+
+#include "EngineUtils.h"
+#include "FGCharacterPlayer.h"
+#include "FGDropPod.h"
+#include "FGDroneVehicle.h"
+#include "FGItemPickup.h"
+#include "FGRailroadVehicle.h"
+#include "FGTrain.h"
+#include "FGVehicle.h"
+#include "Buildables/FGBuildable.h"
+#include "Buildables/FGBuildableWire.h"
+#include "FGLocomotive.h"
+#include "Creature/FGCreature.h"
+#include "Resources/FGResourceNodeBase.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Polylines.h"
+#include "FRM_ThreadAudit.h"
+
+void FFRMEntityIndex::Start(UWorld* World)
+{
+	FRM_TRACE_SCOPE("FRM::EntityIndex::Start");
+
+	Stop();
+	if (!World) return;
+
+	BoundWorld = World;
+
+	for (TActorIterator<AActor> It(World); It; ++It) {
+		Add(*It);
+	}
+
+	SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FFRMEntityIndex::Add));
+	DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FFRMEntityIndex::Remove));
+
+	UE_LOGFMT(LogFRMAPI, Log, "Entity index started with {0} entities", Num());
+}
+
+void FFRMEntityIndex::Stop()
+{
+	if (UWorld* World = BoundWorld.Get()) {
+		World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(DestroyedHandle);
+	}
+
+	BoundWorld.Reset();
+	SpawnedHandle.Reset();
+	DestroyedHandle.Reset();
+
+	FWriteScopeLock WriteLock(Lock);
+	Entities.Empty();
+	CompactIDs.Empty();
+	NextCompactID = 1;
+	Unplaced.Empty();
+	Mobile.Empty();
+	Spatial.Reset();
+}
+
+bool FFRMEntityIndex::Find(const FString& ID, FFRMEntity& OutEntity) const
+{
+	FRM_AUDIT_CACHE("FFRMEntityIndex");
+
+	// FNAME_Find never adds client supplied strings to the name table
+	const FName Name(*ID, FNAME_Find);
+	if (Name.IsNone()) return false;
+
+	FReadScopeLock ReadLock(Lock);
+	const FFRMEntity* Entity = Entities.Find(Name);
+	if (!Entity) return false;
+
+	OutEntity = *Entity;
+	return true;
+}
+
+bool FFRMEntityIndex::FindByCompactID(const uint32 CompactID, FFRMEntity& OutEntity) const
+{
+	FRM_AUDIT_CACHE("FFRMEntityIndex");
+
+	FReadScopeLock ReadLock(Lock);
+	const FName* Name = CompactIDs.Find(CompactID);
+	if (!Name) return false;
+
+	OutEntity = Entities.FindChecked(*Name);
+	return true;
+}
+
+uint32 FFRMEntityIndex::GetCompactID(const AActor* Actor) const
+{
+	if (!Actor) return 0;
+
+	FReadScopeLock ReadLock(Lock);
+	const FFRMEntity* Entity = Entities.Find(Actor->GetFName());
+	return Entity && Entity->Actor == Actor ? Entity->CompactID : 0;
+}
+
+int32 FFRMEntityIndex::Num() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Entities.Num();
+}
+
+void FFRMEntityIndex::GetMobile(TArray<FFRMEntity>& OutEntities) const
+{
+	FRM_AUDIT_CACHE("FFRMEntityIndex");
+	FReadScopeLock ReadLock(Lock);
+
+	OutEntities.Reset(Mobile.Num());
+	for (const FName ID : Mobile) {
+		OutEntities.Add(Entities.FindChecked(ID));
+	}
+}
+
+bool FFRMEntityIndex::Contains(const FName ID) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Entities.Contains(ID);
+}
+
+void FFRMEntityIndex::RefreshSpatial()
+{
+	FRM_TRACE_SCOPE("FRM::EntityIndex::RefreshSpatial");
+
+	TArray<TPair<FName, FFRMEntity>> Refresh;
+	{
+		FWriteScopeLock WriteLock(Lock);
+
+		Refresh.Reserve(Unplaced.Num() + Mobile.Num());
+		for (const FName ID : Unplaced) {
+			if (const FFRMEntity* Entity = Entities.Find(ID)) Refresh.Emplace(ID, *Entity);
+		}
+		for (const FName ID : Mobile) {
+			if (!Unplaced.Contains(ID)) Refresh.Emplace(ID, Entities.FindChecked(ID));
+		}
+		Unplaced.Reset();
+	}
+
+	// only the game thread modifies the index, an entity removed meanwhile cannot be resolved anymore
+	for (const TPair<FName, FFRMEntity>& Entry : Refresh) {
+		AActor* Actor = Entry.Value.Actor.Get();
+		FBox2D Bounds;
+		if (Actor && GetBounds(Actor, Entry.Value.Kind, Bounds)) {
+			Spatial.Update(Entry.Key, Bounds);
+		}
+	}
+}
+
+void FFRMEntityIndex::QuerySpatial(const FFRMSpatialQuery& Query, TSet<FName>& OutIDs) const
+{
+	Spatial.Query(Query, OutIDs);
+}
+
+bool FFRMEntityIndex::GetBounds(AActor* Actor, const EFRMEntityKind Kind, FBox2D& OutBounds)
+{
+	if (Kind == EFRMEntityKind::Train) {
+		// a train has no location of its own, it is where its leading locomotive is
+		AFGTrain* Train = Cast<AFGTrain>(Actor);
+		Actor = Train ? Train->GetMultipleUnitMaster() : nullptr;
+		if (!Actor) return false;
+	}
+
+	OutBounds = FBox2D(ForceInit);
+
+	if (const AFGBuildableWire* Wire = Cast<AFGBuildableWire>(Actor)) {
+		OutBounds += FVector2D(Wire->GetConnectionLocation(0));
+		OutBounds += FVector2D(Wire->GetConnectionLocation(1));
+		return true;
+	}
+
+	// belts, pipes, hypertubes and rails; a curve can bulge past its control points, the samples cannot
+	TArray<FVector> Samples;
+	if (FFRMPolylineCache::Sample(Actor, Samples)) {
+		for (const FVector& Sample : Samples) {
+			OutBounds += FVector2D(Sample);
+		}
+		if (OutBounds.bIsValid) return true;
+	}
+
+	const FVector Location = Actor->GetActorLocation();
+	OutBounds = FBox2D(FVector2D(Location), FVector2D(Location));
+	return true;
+}
+
+EFRMEntityKind FFRMEntityIndex::GetKind(const AActor* Actor)
+{
+	// most specific classes first, drones and railroad vehicles are vehicles as well
+	if (Actor->IsA<AFGBuildable>()) return EFRMEntityKind::Buildable;
+	if (Actor->IsA<AFGDroneVehicle>()) return EFRMEntityKind::Drone;
+	if (Actor->IsA<AFGRailroadVehicle>()) return EFRMEntityKind::RailroadVehicle;
+	if (Actor->IsA<AFGVehicle>()) return EFRMEntityKind::Vehicle;
+	if (Actor->IsA<AFGTrain>()) return EFRMEntityKind::Train;
+	if (Actor->IsA<AFGCharacterPlayer>()) return EFRMEntityKind::Player;
+	if (Actor->IsA<AFGCreature>()) return EFRMEntityKind::Creature;
+	if (Actor->IsA<AFGResourceNodeBase>()) return EFRMEntityKind::ResourceNode;
+	if (Actor->IsA<AFGDropPod>()) return EFRMEntityKind::DropPod;
+	if (Actor->IsA<AFGItemPickup>()) return EFRMEntityKind::ItemPickup;
+
+	return EFRMEntityKind::Num;
+}
+
+FString FFRMEntityIndex::GetKindName(const EFRMEntityKind Kind)
+{
+	switch (Kind) {
+		case EFRMEntityKind::Buildable: return TEXT("Buildable");
+		case EFRMEntityKind::Drone: return TEXT("Drone");
+		case EFRMEntityKind::RailroadVehicle: return TEXT("RailroadVehicle");
+		case EFRMEntityKind::Vehicle: return TEXT("Vehicle");
+		case EFRMEntityKind::Train: return TEXT("Train");
+		case EFRMEntityKind::Player: return TEXT("Player");
+		case EFRMEntityKind::Creature: return TEXT("Creature");
+		case EFRMEntityKind::ResourceNode: return TEXT("ResourceNode");
+		case EFRMEntityKind::DropPod: return TEXT("DropPod");
+		case EFRMEntityKind::ItemPickup: return TEXT("ItemPickup");
+		default: return TEXT("Unknown");
+	}
+}
+
+void FFRMEntityIndex::Add(AActor* Actor)
+{
+	if (!IsValid(Actor)) return;
+
+	const EFRMEntityKind Kind = GetKind(Actor);
+	if (Kind == EFRMEntityKind::Num) return;
+
+	FWriteScopeLock WriteLock(Lock);
+
+	FFRMEntity& Entity = Entities.FindOrAdd(Actor->GetFName());
+
+	// a name freed by a destroyed actor can be taken by a new one, which gets a new compact ID
+	if (Entity.CompactID != 0) {
+		if (Entity.Actor == Actor) return;
+		CompactIDs.Remove(Entity.CompactID);
+	}
+
+	Entity.Actor = Actor;
+	Entity.Kind = Kind;
+	Entity.CompactID = NextCompactID++;
+	CompactIDs.Add(Entity.CompactID, Actor->GetFName());
+
+	// the location is not final while the actor is spawning, it is placed with the next refresh
+	Unplaced.Add(Actor->GetFName());
+
+	if (Kind != EFRMEntityKind::Buildable && Kind != EFRMEntityKind::ResourceNode && Kind != EFRMEntityKind::DropPod && Kind != EFRMEntityKind::ItemPickup) {
+		Mobile.Add(Actor->GetFName());
+	}
+	else {
+		Mobile.Remove(Actor->GetFName());
+	}
+}
+
+void FFRMEntityIndex::Remove(AActor* Actor)
+{
+	if (!Actor) return;
+
+	FWriteScopeLock WriteLock(Lock);
+
+	const FName Name = Actor->GetFName();
+	const FFRMEntity* Entity = Entities.Find(Name);
+	if (!Entity || Entity->Actor != Actor) return;
+
+	CompactIDs.Remove(Entity->CompactID);
+	Entities.Remove(Name);
+	Unplaced.Remove(Name);
+	Mobile.Remove(Name);
+	Spatial.Remove(Name);
+}
@@ -2,13 +2,18 @@
 #include "FGFallingGiftBundle.h"
 #include "FRM_Library.h"
 #include "Kismet/GameplayStatics.h"
+#include "FRM_ThreadAudit.h"
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Events::GetFallingGiftBundles(UObject* WorldContext)
 {
+	FRM_TRACE_SCOPE("FRM::GetFallingGiftBundles");
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JBundleArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGFallingGiftBundle::StaticClass(), FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGFallingGiftBundle::StaticClass(), FoundActors);
+	}
 
 	for (AActor* Actor : FoundActors)
 	{
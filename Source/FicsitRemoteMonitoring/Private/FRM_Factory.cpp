@@ -3,34 +3,50 @@
 #include <FicsitRemoteMonitoring.h>
 
 #include "FGBuildableWire.h"
+#include "FRM_NameCache.h"
+#include "FRM_Request.h"
+#include "FRM_ThreadAudit.h"
 
 #undef GetForm
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getBelts(UObject* WorldContext, FRequestData RequestData) {
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
+TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getBelts(UObject* WorldContext, FRequestData RequestData, const FFRMPolylineCache& Polylines, const FFRMSnapshotStore& Snapshots) {
+	FRM_TRACE_SCOPE("FRM::getBelts");
+
+	FString LodError;
+	const int32 Lod = FFRMPolylineCache::ParseLod(RequestData.QueryParams, LodError);
+	if (!LodError.IsEmpty()) {
+		return {MakeShared<FJsonValueObject>(UFRM_RequestLibrary::GenerateError(LodError))};
+	}
 
-	TArray<AFGBuildableConveyorBase*> ConveyorBelts;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableConveyorBase>(ConveyorBelts);
+	// read from the latest snapshot, the belts themselves are never touched off the game thread
+	const TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Snapshot = Snapshots.Get();
 	TArray<TSharedPtr<FJsonValue>> JConveyorBeltArray;
+	if (!Snapshot.IsValid()) return JConveyorBeltArray;
 
-	for (AFGBuildableConveyorBase* ConveyorBelt : ConveyorBelts) {
+	for (const FFRMBeltRow& ConveyorBelt : Snapshot->Belts) {
 
-		if (!IsValid(ConveyorBelt)) { continue; }
+		if (RequestData.IsOutsideArea(ConveyorBelt.ID)) { continue; }
 
-		TSharedPtr<FJsonObject> JConveyorBelt = UFRM_Library::CreateBaseJsonObject(ConveyorBelt);
-		
-		UFGFactoryConnectionComponent* ConnectionZero = ConveyorBelt->GetConnection0();
-		UFGFactoryConnectionComponent* ConnectionOne = ConveyorBelt->GetConnection1();
-
-		JConveyorBelt->Values.Add("Name", MakeShared<FJsonValueString>(ConveyorBelt->mDisplayName.ToString()));
-		JConveyorBelt->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(ConveyorBelt->GetClass())));
-		JConveyorBelt->Values.Add("location0", MakeShared<FJsonValueObject>(UFRM_Library::getActorFactoryCompXYZ(ConnectionZero)));
-		JConveyorBelt->Values.Add("Connected0", MakeShared<FJsonValueBoolean>(ConnectionZero->IsConnected()));
-		JConveyorBelt->Values.Add("location1", MakeShared<FJsonValueObject>(UFRM_Library::getActorFactoryCompXYZ(ConnectionOne)));
-		JConveyorBelt->Values.Add("Connected1", MakeShared<FJsonValueBoolean>(ConnectionOne->IsConnected()));
-		JConveyorBelt->Values.Add("Length", MakeShared<FJsonValueNumber>(ConveyorBelt->GetLength()));
-		JConveyorBelt->Values.Add("ItemsPerMinute", MakeShared<FJsonValueNumber>((UFRM_Library::SafeDivide_Float(ConveyorBelt->GetSpeed(), 2))));
-		JConveyorBelt->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(Cast<AActor>(ConveyorBelt), ConveyorBelt->mDisplayName.ToString(), ConveyorBelt->mDisplayName.ToString())));
+		TSharedPtr<FJsonObject> JConveyorBelt = MakeShared<FJsonObject>();
+
+		JConveyorBelt->Values.Add("ID", MakeShared<FJsonValueString>(ConveyorBelt.ID.ToString()));
+		JConveyorBelt->Values.Add("Name", MakeShared<FJsonValueString>(ConveyorBelt.Name));
+		JConveyorBelt->Values.Add("ClassName", MakeShared<FJsonValueString>(ConveyorBelt.ClassName));
+		JConveyorBelt->Values.Add("location0", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(ConveyorBelt.Location0)));
+		JConveyorBelt->Values.Add("Connected0", MakeShared<FJsonValueBoolean>(ConveyorBelt.bConnected0));
+		JConveyorBelt->Values.Add("location1", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(ConveyorBelt.Location1)));
+		JConveyorBelt->Values.Add("Connected1", MakeShared<FJsonValueBoolean>(ConveyorBelt.bConnected1));
+		JConveyorBelt->Values.Add("Length", MakeShared<FJsonValueNumber>(ConveyorBelt.Length));
+		JConveyorBelt->Values.Add("ItemsPerMinute", MakeShared<FJsonValueNumber>((UFRM_Library::SafeDivide_Float(ConveyorBelt.Speed, 2))));
+
+		// with ?lod= the feature follows the belt's curve, lifts have no spline and stay a point
+		TArray<FVector> Points;
+		if (Lod != INDEX_NONE && Polylines.Find(ConveyorBelt.Key, Lod, Points)) {
+			JConveyorBelt->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetActorLineFeaturesJSON(Points, ConveyorBelt.Name, ConveyorBelt.Name)));
+		}
+		else {
+			JConveyorBelt->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetPointFeaturesJSON(ConveyorBelt.Location, ConveyorBelt.Name, ConveyorBelt.Name)));
+		}
 
 		JConveyorBeltArray.Add(MakeShared<FJsonValueObject>(JConveyorBelt));
 
@@ -40,6 +56,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getBelts(UObject* WorldContext, FRe
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getModList(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getModList");
+	FRM_AUDIT_TOUCH("UModLoadingLibrary");
 
 	const UGameInstance* GameInstance = WorldContext->GetWorld()->GetGameInstance();
 	UModLoadingLibrary* ModLoadingLibrary = GameInstance->GetSubsystem<UModLoadingLibrary>();
@@ -69,123 +87,172 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getModList(UObject* WorldContext, F
 
 }
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getFactory(UObject* WorldContext, FRequestData RequestData, UClass* TypedBuildable)
+TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getFactory(UObject* WorldContext, FRequestData RequestData, FFRMTimeSlicer& TimeSlicer, UClass* TypedBuildable)
 {
-	
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildable*> Buildables;
-	BuildableSubsystem->GetTypedBuildable(TypedBuildable, Buildables);
-	TArray<TSharedPtr<FJsonValue>> JFactoryArray;
+	FRM_TRACE_SCOPE("FRM::getFactory");
 
-	//UE_LOGFMT(LogFRMAPI, Warning, "Initial variables configured, executing getProdStats");
+	TArray<TSharedPtr<FJsonValue>> JFactoryArray;
 
-	for (AFGBuildable* Buildable : Buildables) {
+	// a megabase has thousands of manufacturers, they are converted a few hundred per frame
+	TimeSlicer.Collect([WorldContext, TypedBuildable](TArray<UObject*>& OutObjects) {
+		FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
+		AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
+		TArray<AFGBuildable*> Buildables;
+		{
+			FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+			BuildableSubsystem->GetTypedBuildable(TypedBuildable, Buildables);
+		}
+		OutObjects.Append(Buildables);
+	}, [RequestData](UObject* Object) -> TSharedPtr<FJsonValue> {
+		AFGBuildableManufacturer* Manufacturer = Cast<AFGBuildableManufacturer>(Object);
+		if (!Manufacturer || RequestData.IsOutsideArea(Manufacturer)) { return nullptr; }
 
-		AFGBuildableManufacturer* Manufacturer = Cast<AFGBuildableManufacturer>(Buildable);
+		return MakeShared<FJsonValueObject>(getFactoryJSON(Manufacturer));
+	}, JFactoryArray);
 
-		TSharedPtr<FJsonObject> JFactory = UFRM_Library::CreateBaseJsonObject(Buildable);
-		TArray<TSharedPtr<FJsonValue>> JProductArray;
-		TArray<TSharedPtr<FJsonValue>> JIngredientsArray;
+	return JFactoryArray;
+}
 
-		float Productivity = 0;
+TSharedPtr<FJsonObject> UFRM_Factory::getFactoryJSON(AFGBuildableManufacturer* Manufacturer)
+{
+	return GetFactoryRowJSON(GetFactoryRow(Manufacturer));
+}
 
-		//UE_LOGFMT(LogFRMAPI, Warning, "Loading FGBuildable {Manufacturer} to get data.", UKismetSystemLibrary::GetClassDisplayName(Manufacturer->GetClass()));
+FFRMFactoryRow UFRM_Factory::GetFactoryRow(AFGBuildableManufacturer* Manufacturer)
+{
+	FRM_AUDIT_TOUCH("AFGBuildable");
+	FFRMFactoryRow Factory;
+
+	Factory.ID = Manufacturer->GetName();
+	Factory.Name = Manufacturer->mDisplayName.ToString();
+	Factory.Class = Manufacturer->GetClass();
+	Factory.Recipe = Manufacturer->GetCurrentRecipe();
+	Factory.Location = Manufacturer->GetActorLocation();
+	Factory.Yaw = Manufacturer->GetActorRotation().Yaw;
+	Factory.ManufacturingSpeed = Manufacturer->GetManufacturingSpeed();
+	Factory.bIsConfigured = Manufacturer->IsConfigured();
+	Factory.bIsProducing = Manufacturer->IsProducing();
+	Factory.bIsPaused = Manufacturer->IsProductionPaused();
+	Factory.PowerInfo = UFRM_Library::GetPowerInfoRow(Manufacturer->GetPowerInfo());
+
+	if (IsValid(Factory.Recipe)) {
+		Factory.CycleTime = Manufacturer->GetProductionCycleTimeForRecipe(Factory.Recipe);
+		Factory.Potential = Manufacturer->GetCurrentPotential();
+		Factory.Productivity = Manufacturer->GetProductivity();
+		Factory.ProductionBoost = Manufacturer->mProductionShardBoostMultiplier;
+
+		for (const FItemAmount& Product : Factory.Recipe.GetDefaultObject()->GetProducts()) {
+			Factory.Products.Add({Product.ItemClass, Product.Amount, Manufacturer->GetOutputInventory()->GetNumItems(Product.ItemClass)});
+		}
 
-		if (IsValid(Manufacturer->GetCurrentRecipe())) {
-			auto CurrentRecipe = Manufacturer->GetCurrentRecipe();
-			auto ProdCycle = 60 / Manufacturer->GetProductionCycleTimeForRecipe(Manufacturer->GetCurrentRecipe());
-			auto CurrentPotential = Manufacturer->GetCurrentPotential();
-			Productivity = Manufacturer->GetProductivity();
-			auto ProductionBoost = Manufacturer->mProductionShardBoostMultiplier;
-						
-			//UE_LOGFMT(LogFRMAPI, Warning, "Loading FGRecipe {Recipe} to get data.", UKismetSystemLibrary::GetClassDisplayName(CurrentRecipe->GetClass()));
+		for (const FItemAmount& Ingredient : Factory.Recipe.GetDefaultObject()->GetIngredients()) {
+			Factory.Ingredients.Add({Ingredient.ItemClass, Ingredient.Amount, Manufacturer->GetInputInventory()->GetNumItems(Ingredient.ItemClass)});
+		}
+	}
 
-			for (FItemAmount Product : CurrentRecipe.GetDefaultObject()->GetProducts()) {
-				TSharedPtr<FJsonObject> JProduct = MakeShared<FJsonObject>();
-				
-				auto Amount = UFGInventoryLibrary::GetAmountConvertedByForm(Manufacturer->GetOutputInventory()->GetNumItems(Product.ItemClass), UFGItemDescriptor::GetForm(Product.ItemClass));
-				auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Product.Amount, UFGItemDescriptor::GetForm(Product.ItemClass));
-				auto CurrentProd = RecipeAmount * ProdCycle * Productivity * CurrentPotential * ProductionBoost;
-				auto MaxProd = RecipeAmount * ProdCycle * CurrentPotential * ProductionBoost;
-
-				JProduct->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Product.ItemClass).ToString()));
-				JProduct->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Product.ItemClass)));
-				JProduct->Values.Add("Amount", MakeShared<FJsonValueNumber>(Amount));
-				JProduct->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(CurrentProd));
-				JProduct->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(MaxProd));
-				JProduct->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>((100 * (UKismetMathLibrary::SafeDivide(CurrentProd, MaxProd)))));
-
-				JProductArray.Add(MakeShared<FJsonValueObject>(JProduct));
-			};
+	return Factory;
+}
 
-			for (FItemAmount Ingredients : CurrentRecipe.GetDefaultObject()->GetIngredients()) {
-				TSharedPtr<FJsonObject> JIngredients = MakeShared<FJsonObject>();
+TSharedPtr<FJsonObject> UFRM_Factory::GetFactoryRowJSON(const FFRMFactoryRow& Factory)
+{
+	TSharedPtr<FJsonObject> JFactory = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> JProductArray;
+	TArray<TSharedPtr<FJsonValue>> JIngredientsArray;
 
-				auto Amount = UFGInventoryLibrary::GetAmountConvertedByForm(Manufacturer->GetInputInventory()->GetNumItems(Ingredients.ItemClass), UFGItemDescriptor::GetForm(Ingredients.ItemClass));
-				auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Ingredients.Amount, UFGItemDescriptor::GetForm(Ingredients.ItemClass));
-				auto CurrentConsumed = RecipeAmount * ProdCycle * Productivity * CurrentPotential;
-				auto MaxConsumed = RecipeAmount * ProdCycle * CurrentPotential;
+	JFactory->Values.Add("ID", MakeShared<FJsonValueString>(Factory.ID));
 
-				JIngredients->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Ingredients.ItemClass).ToString()));
-				JIngredients->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Ingredients.ItemClass)));
-				JIngredients->Values.Add("Amount", MakeShared<FJsonValueNumber>(Amount));
-				JIngredients->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(CurrentConsumed));
-				JIngredients->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(MaxConsumed));
-				JIngredients->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>((100 * (UKismetMathLibrary::SafeDivide(CurrentConsumed, MaxConsumed)))));
+	if (IsValid(Factory.Recipe)) {
+		const float ProdCycle = 60 / Factory.CycleTime;
 
-				JIngredientsArray.Add(MakeShared<FJsonValueObject>(JIngredients));
-			};
-			
-		}
-		else {
+		for (const FFRMRecipeItemRow& Product : Factory.Products) {
 			TSharedPtr<FJsonObject> JProduct = MakeShared<FJsonObject>();
-			TSharedPtr<FJsonObject> JIngredients = MakeShared<FJsonObject>();
 
-			JProduct->Values.Add("Name", MakeShared<FJsonValueString>(TEXT("Unassigned")));
-			JProduct->Values.Add("ClassName", MakeShared<FJsonValueString>(TEXT("Unassigned")));
-			JProduct->Values.Add("Amount", MakeShared<FJsonValueNumber>(0));
-			JProduct->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(0));
-			JProduct->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(0));
-			JProduct->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>(0));
+			auto Amount = UFGInventoryLibrary::GetAmountConvertedByForm(Product.Stored, UFGItemDescriptor::GetForm(Product.ItemClass));
+			auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Product.RecipeAmount, UFGItemDescriptor::GetForm(Product.ItemClass));
+			auto CurrentProd = RecipeAmount * ProdCycle * Factory.Productivity * Factory.Potential * Factory.ProductionBoost;
+			auto MaxProd = RecipeAmount * ProdCycle * Factory.Potential * Factory.ProductionBoost;
 
-			JIngredients->Values.Add("Name", MakeShared<FJsonValueString>(TEXT("Unassigned")));
-			JIngredients->Values.Add("ClassName", MakeShared<FJsonValueString>(TEXT("Unassigned")));
-			JIngredients->Values.Add("Amount", MakeShared<FJsonValueNumber>(0));
-			JIngredients->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(0));
-			JIngredients->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(0));
-			JIngredients->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>(0));
+			JProduct->Values.Add("Name", FFRMNameCache::Find(Product.ItemClass)->JDisplayName);
+			JProduct->Values.Add("ClassName", FFRMNameCache::Find(Product.ItemClass)->JClassName);
+			JProduct->Values.Add("Amount", MakeShared<FJsonValueNumber>(Amount));
+			JProduct->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(CurrentProd));
+			JProduct->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(MaxProd));
+			JProduct->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>((100 * (UKismetMathLibrary::SafeDivide(CurrentProd, MaxProd)))));
 
 			JProductArray.Add(MakeShared<FJsonValueObject>(JProduct));
+		};
+
+		for (const FFRMRecipeItemRow& Ingredients : Factory.Ingredients) {
+			TSharedPtr<FJsonObject> JIngredients = MakeShared<FJsonObject>();
+
+			auto Amount = UFGInventoryLibrary::GetAmountConvertedByForm(Ingredients.Stored, UFGItemDescriptor::GetForm(Ingredients.ItemClass));
+			auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Ingredients.RecipeAmount, UFGItemDescriptor::GetForm(Ingredients.ItemClass));
+			auto CurrentConsumed = RecipeAmount * ProdCycle * Factory.Productivity * Factory.Potential;
+			auto MaxConsumed = RecipeAmount * ProdCycle * Factory.Potential;
+
+			JIngredients->Values.Add("Name", FFRMNameCache::Find(Ingredients.ItemClass)->JDisplayName);
+			JIngredients->Values.Add("ClassName", FFRMNameCache::Find(Ingredients.ItemClass)->JClassName);
+			JIngredients->Values.Add("Amount", MakeShared<FJsonValueNumber>(Amount));
+			JIngredients->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(CurrentConsumed));
+			JIngredients->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(MaxConsumed));
+			JIngredients->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>((100 * (UKismetMathLibrary::SafeDivide(CurrentConsumed, MaxConsumed)))));
+
 			JIngredientsArray.Add(MakeShared<FJsonValueObject>(JIngredients));
 		};
+		
+	}
+	else {
+		TSharedPtr<FJsonObject> JProduct = MakeShared<FJsonObject>();
+		TSharedPtr<FJsonObject> JIngredients = MakeShared<FJsonObject>();
+
+		JProduct->Values.Add("Name", MakeShared<FJsonValueString>(TEXT("Unassigned")));
+		JProduct->Values.Add("ClassName", MakeShared<FJsonValueString>(TEXT("Unassigned")));
+		JProduct->Values.Add("Amount", MakeShared<FJsonValueNumber>(0));
+		JProduct->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(0));
+		JProduct->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(0));
+		JProduct->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>(0));
+
+		JIngredients->Values.Add("Name", MakeShared<FJsonValueString>(TEXT("Unassigned")));
+		JIngredients->Values.Add("ClassName", MakeShared<FJsonValueString>(TEXT("Unassigned")));
+		JIngredients->Values.Add("Amount", MakeShared<FJsonValueNumber>(0));
+		JIngredients->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(0));
+		JIngredients->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(0));
+		JIngredients->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>(0));
 
-		JFactory->Values.Add("Name", MakeShared<FJsonValueString>(Manufacturer->mDisplayName.ToString()));
-		JFactory->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Manufacturer->GetClass())));
-		JFactory->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Cast<AActor>(Manufacturer))));
-		JFactory->Values.Add("Recipe", MakeShared<FJsonValueString>(UFGRecipe::GetRecipeName(Manufacturer->GetCurrentRecipe()).ToString()));
-		JFactory->Values.Add("RecipeClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Manufacturer->GetCurrentRecipe())));
-		JFactory->Values.Add("production", MakeShared<FJsonValueArray>(JProductArray));
-		JFactory->Values.Add("ingredients", MakeShared<FJsonValueArray>(JIngredientsArray));
-		JFactory->Values.Add("Productivity", MakeShared<FJsonValueNumber>(Productivity * 100));
-		JFactory->Values.Add("ManuSpeed", MakeShared<FJsonValueNumber>(Manufacturer->GetManufacturingSpeed() * 100));
-		JFactory->Values.Add("IsConfigured", MakeShared<FJsonValueBoolean>(Manufacturer->IsConfigured()));
-		JFactory->Values.Add("IsProducing", MakeShared<FJsonValueBoolean>(Manufacturer->IsProducing()));
-		JFactory->Values.Add("IsPaused", MakeShared<FJsonValueBoolean>(Manufacturer->IsProductionPaused()));
-		JFactory->Values.Add("PowerInfo", MakeShared<FJsonValueObject>(UFRM_Library::getPowerConsumptionJSON(Manufacturer->GetPowerInfo())));
-		JFactory->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(Cast<AActor>(Manufacturer), Manufacturer->mDisplayName.ToString(), Manufacturer->mDisplayName.ToString())));
-
-		JFactoryArray.Add(MakeShared<FJsonValueObject>(JFactory));
+		JProductArray.Add(MakeShared<FJsonValueObject>(JProduct));
+		JIngredientsArray.Add(MakeShared<FJsonValueObject>(JIngredients));
 	};
 
-	return JFactoryArray;
+	JFactory->Values.Add("Name", MakeShared<FJsonValueString>(Factory.Name));
+	JFactory->Values.Add("ClassName", FFRMNameCache::Find(Factory.Class)->JClassName);
+	JFactory->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::GetLocationJSON(Factory.Location, Factory.Yaw)));
+	JFactory->Values.Add("Recipe", MakeShared<FJsonValueString>(UFGRecipe::GetRecipeName(Factory.Recipe).ToString()));
+	JFactory->Values.Add("RecipeClassName", FFRMNameCache::Find(Factory.Recipe)->JClassName);
+	JFactory->Values.Add("production", MakeShared<FJsonValueArray>(JProductArray));
+	JFactory->Values.Add("ingredients", MakeShared<FJsonValueArray>(JIngredientsArray));
+	JFactory->Values.Add("Productivity", MakeShared<FJsonValueNumber>(Factory.Productivity * 100));
+	JFactory->Values.Add("ManuSpeed", MakeShared<FJsonValueNumber>(Factory.ManufacturingSpeed * 100));
+	JFactory->Values.Add("IsConfigured", MakeShared<FJsonValueBoolean>(Factory.bIsConfigured));
+	JFactory->Values.Add("IsProducing", MakeShared<FJsonValueBoolean>(Factory.bIsProducing));
+	JFactory->Values.Add("IsPaused", MakeShared<FJsonValueBoolean>(Factory.bIsPaused));
+	JFactory->Values.Add("PowerInfo", MakeShared<FJsonValueObject>(UFRM_Library::GetPowerInfoJSON(Factory.PowerInfo)));
+	JFactory->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetPointFeaturesJSON(Factory.Location, Factory.Name, Factory.Name)));
+
+	return JFactory;
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHubTerminal(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getHubTerminal");
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
+	FRM_AUDIT_TOUCH("AFGSchematicManager::Get");
 	AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildableHubTerminal*> Buildables;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableHubTerminal>(Buildables);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableHubTerminal>(Buildables);
+	}
 	TArray<TSharedPtr<FJsonValue>> JHubTerminalArray;
 
 	for (AFGBuildableHubTerminal* HubTerminal : Buildables) {
@@ -261,7 +328,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHubTerminal(UObject* WorldContex
 			}
 
 			JSchematic->Values.Add("Name", MakeShared<FJsonValueString>(UFGSchematic::GetSchematicDisplayName(ActiveSchematic).ToString()));
-			JSchematic->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(ActiveSchematic->GetClass())));
+			JSchematic->Values.Add("ClassName", FFRMNameCache::Find(ActiveSchematic->GetClass())->JClassName);
 			JSchematic->Values.Add("TechTier", MakeShared<FJsonValueNumber>(UFGSchematic::GetTechTier(ActiveSchematic)));
 			JSchematic->Values.Add("Type", MakeShared<FJsonValueString>(SchematicType));
 			JSchematic->Values.Add("Recipes", MakeShared<FJsonValueArray>(JRecipeArray));
@@ -282,7 +349,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHubTerminal(UObject* WorldContex
 		}		
 		
 		JHubTerminal->Values.Add("Name", MakeShared<FJsonValueString>(HubTerminal->mDisplayName.ToString()));
-		JHubTerminal->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(HubTerminal->GetClass())));
+		JHubTerminal->Values.Add("ClassName", FFRMNameCache::Find(HubTerminal->GetClass())->JClassName);
 		JHubTerminal->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Cast<AActor>(HubTerminal))));
 		//JHubTerminal->Values.Add("HUBLevel", MakeShared<FJsonValueNumber>(TradingPost->GetTradingPostLevel()));
 		JHubTerminal->Values.Add("ActiveMilestone", MakeShared<FJsonValueObject>(JSchematic));
@@ -299,12 +366,16 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHubTerminal(UObject* WorldContex
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPowerSlug(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getPowerSlug");
 
-	UClass* CrystalClass = LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Resource/Environment/Crystal/BP_Crystal.BP_Crystal_C"));
+	UClass* CrystalClass = UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Resource/Environment/Crystal/BP_Crystal.BP_Crystal_C"));
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JSlugArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), CrystalClass, FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), CrystalClass, FoundActors);
+	}
 	for (AActor* PowerActor : FoundActors) {
 		const auto ItemPickup = Cast<AFGItemPickup>(PowerActor);
 		if (!ItemPickup) continue;
@@ -327,7 +398,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPowerSlug(UObject* WorldContext,
 		};
 
 		JPowerSlug->Values.Add("Name", MakeShared<FJsonValueString>(SlugName));
-		JPowerSlug->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(PowerActor->GetClass())));
+		JPowerSlug->Values.Add("ClassName", FFRMNameCache::Find(PowerActor->GetClass())->JClassName);
 		JPowerSlug->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(PowerActor)));
 		JPowerSlug->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(Cast<AActor>(PowerActor), SlugName, "Power Slug")));
 
@@ -337,27 +408,25 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPowerSlug(UObject* WorldContext,
 	return JSlugArray;
 };
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getStorageInv(UObject* WorldContext, FRequestData RequestData) {
-		
-	TMap<TSubclassOf<UFGItemDescriptor>, int32> CurrentProduced;
+TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getStorageInv(UObject* WorldContext, FRequestData RequestData, const FFRMSnapshotStore& Snapshots) {
+	FRM_TRACE_SCOPE("FRM::getStorageInv");
 
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildableStorage*> StorageContainers;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableStorage>(StorageContainers);
+	const TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Snapshot = Snapshots.Get();
 	TArray<TSharedPtr<FJsonValue>> JStorageArray;
+	if (!Snapshot.IsValid()) return JStorageArray;
 
-	for (AFGBuildableStorage* StorageContainer : StorageContainers) {
+	for (const FFRMStorageRow& StorageContainer : Snapshot->Storages) {
 
-		TSharedPtr<FJsonObject> JStorage = UFRM_Library::CreateBaseJsonObject(StorageContainer);
+		if (RequestData.IsOutsideArea(StorageContainer.ID)) { continue; }
 
-		// get inventory
-		TMap<TSubclassOf<UFGItemDescriptor>, int32> StorageInventory = UFRM_Library::GetGroupedInventoryItems(StorageContainer->GetStorageInventory());
+		TSharedPtr<FJsonObject> JStorage = MakeShared<FJsonObject>();
 
-		JStorage->Values.Add("Name", MakeShared<FJsonValueString>(StorageContainer->mDisplayName.ToString()));
-		JStorage->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(StorageContainer->GetClass())));
-		JStorage->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(StorageContainer)));
-		JStorage->Values.Add("Inventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(StorageInventory)));
-		JStorage->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(StorageContainer, StorageContainer->mDisplayName.ToString(), TEXT("Storage Container"))));
+		JStorage->Values.Add("ID", MakeShared<FJsonValueString>(StorageContainer.ID.ToString()));
+		JStorage->Values.Add("Name", MakeShared<FJsonValueString>(StorageContainer.Name));
+		JStorage->Values.Add("ClassName", MakeShared<FJsonValueString>(StorageContainer.ClassName));
+		JStorage->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::GetLocationJSON(StorageContainer.Location, StorageContainer.Yaw)));
+		JStorage->Values.Add("Inventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(StorageContainer.Inventory)));
+		JStorage->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetPointFeaturesJSON(StorageContainer.Location, StorageContainer.Name, TEXT("Storage Container"))));
 
 		JStorageArray.Add(MakeShared<FJsonValueObject>(JStorage));
 
@@ -367,34 +436,30 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getStorageInv(UObject* WorldContext
 
 };
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getWorldInv(UObject* WorldContext, FRequestData RequestData) {
+TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getWorldInv(UObject* WorldContext, FRequestData RequestData, const FFRMSnapshotStore& Snapshots) {
+	FRM_TRACE_SCOPE("FRM::getWorldInv");
 
-	TMap<TSubclassOf<UFGItemDescriptor>, int32> CurrentProduced;
+	// summed up while the snapshot was taken
+	TArray<FFRMItemStack> Items;
 
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildableStorage*> StorageContainers;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableStorage>(StorageContainers);
-	TArray<TSharedPtr<FJsonValue>> JStorageArray;
-
-	TMap<TSubclassOf<UFGItemDescriptor>, int32> StorageTMap;
-
-	for (AFGBuildableStorage* StorageContainer : StorageContainers) {
-
-		TSharedPtr<FJsonObject> JStorage = MakeShared<FJsonObject>();
-
-		// get inventory of the storage container
-		UFRM_Library::GetGroupedInventoryItems(StorageContainer->GetStorageInventory(), StorageTMap);
+	const TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Snapshot = Snapshots.Get();
+	if (Snapshot.IsValid()) {
+		Snapshot->WorldInventory.GetStacks(Items);
 	}
 
-	return UFRM_Library::GetInventoryJSON(StorageTMap);
+	return UFRM_Library::GetInventoryJSON(Items);
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getDropPod(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getDropPod");
 
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JDropPodArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGDropPod::StaticClass(), FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGDropPod::StaticClass(), FoundActors);
+	}
 
 	for (AActor* FoundActor : FoundActors) {
 
@@ -441,10 +506,15 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getDropPod(UObject* WorldContext, F
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceExtractor(UObject* WorldContext, FRequestData RequestData)
 {
+	FRM_TRACE_SCOPE("FRM::getResourceExtractor");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableResourceExtractor*> Extractors;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceExtractor>(Extractors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceExtractor>(Extractors);
+	}
 	TArray<TSharedPtr<FJsonValue>> JExtractorArray;
 
 	for (AFGBuildableResourceExtractor* Extractor : Extractors) {
@@ -462,8 +532,9 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceExtractor(UObject* World
 		TScriptInterface<IFGExtractableResourceInterface> ResourceClass = Extractor->GetExtractableResource();
 		if (ResourceClass != nullptr) {
 			TSubclassOf<UFGResourceDescriptor> ItemClass = ResourceClass->GetResourceClass();
-			ItemName = UFGItemDescriptor::GetItemName(ItemClass).ToString();
-			ItemClassName = UKismetSystemLibrary::GetClassDisplayName(ItemClass);
+			const TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> Names = FFRMNameCache::Find(ItemClass);
+			ItemName = Names->DisplayName;
+			ItemClassName = Names->ClassName;
 			const float ProdCycle = Extractor->GetExtractionPerMinute();
 			const float Productivity = Extractor->GetProductivity();
 			const UFGInventoryComponent* ExtractorInventory = Extractor->GetOutputInventory();
@@ -506,11 +577,15 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceExtractor(UObject* World
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceNode(UObject* WorldContext, FRequestData RequestData, UClass* ResourceActor) {
+	FRM_TRACE_SCOPE("FRM::getResourceNode");
 
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JResourceNodeArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), ResourceActor, FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), ResourceActor, FoundActors);
+	}
 
 	for (AActor* FoundActor : FoundActors) {
 		TSharedPtr<FJsonObject> JResourceNode = UFRM_Library::GetResourceNodeJSON(FoundActor, true);
@@ -526,11 +601,16 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceNode(UObject* WorldConte
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext, FRequestData RequestData)
 {
+	FRM_TRACE_SCOPE("FRM::getRadarTower");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildableRadarTower*> RadarTowers;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableRadarTower>(RadarTowers);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableRadarTower>(RadarTowers);
+	}
 
 	TArray<TSharedPtr<FJsonValue>> JRadarTowerArray;
 
@@ -585,8 +665,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext
 
 			TSharedPtr<FJsonObject> JFlora = MakeShared<FJsonObject>();
 
-			JFlora->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Flora).ToString()));
-			JFlora->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Flora)));
+			JFlora->Values.Add("Name", FFRMNameCache::Find(Flora)->JDisplayName);
+			JFlora->Values.Add("ClassName", FFRMNameCache::Find(Flora)->JClassName);
 			JFlora->Values.Add("Amount", MakeShared<FJsonValueNumber>(FloraTMap.FindRef(Flora)));
 
 			JFloraArray.Add(MakeShared<FJsonValueObject>(JFlora));
@@ -599,8 +679,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext
 
 			TSharedPtr<FJsonObject> JFauna = MakeShared<FJsonObject>();
 
-			JFauna->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Fauna).ToString()));
-			JFauna->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Fauna)));
+			JFauna->Values.Add("Name", FFRMNameCache::Find(Fauna)->JDisplayName);
+			JFauna->Values.Add("ClassName", FFRMNameCache::Find(Fauna)->JClassName);
 			JFauna->Values.Add("Amount", MakeShared<FJsonValueNumber>(FaunaTMap.FindRef(Fauna)));
 
 			JFaunaArray.Add(MakeShared<FJsonValueObject>(JFauna));
@@ -612,7 +692,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext
 			TSharedPtr<FJsonObject> JSignal = MakeShared<FJsonObject>();
 
 			JSignal->Values.Add("Name", MakeShared<FJsonValueString>((Signal.ItemDescriptor.GetDefaultObject()->mDisplayName).ToString()));
-			JSignal->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Signal.ItemDescriptor)));
+			JSignal->Values.Add("ClassName", FFRMNameCache::Find(Signal.ItemDescriptor)->JClassName);
 			JSignal->Values.Add("Amount", MakeShared<FJsonValueNumber>(Signal.NumActorsFound));
 
 			JSignalArray.Add(MakeShared<FJsonValueObject>(JSignal));
@@ -629,7 +709,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext
 		}
 
 		JRadarTower->Values.Add("Name", MakeShared<FJsonValueString>(RadarTower->mDisplayName.ToString()));
-		JRadarTower->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(RadarTower->GetClass())));
+		JRadarTower->Values.Add("ClassName", FFRMNameCache::Find(RadarTower->GetClass())->JClassName);
 		JRadarTower->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Cast<AActor>(RadarTower))));
 		JRadarTower->Values.Add("RevealRadius", MakeShared<FJsonValueNumber>(RadarData->GetFogOfWarRevealRadius()));
 		JRadarTower->Values.Add("RevealType", MakeShared<FJsonValueString>(UEnum::GetDisplayValueAsText(RadarData->GetFogOfWarRevealType()).ToString()));
@@ -647,11 +727,16 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getRadarTower(UObject* WorldContext
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceSinkBuilding(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getResourceSinkBuilding");
 
 	TArray<TSharedPtr<FJsonValue>> JResourceSinkBuildingArray;
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableResourceSink*> Buildables;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceSink>(Buildables);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceSink>(Buildables);
+	}
 
 	for (AFGBuildableResourceSink* Sink : Buildables) {
 		TSharedPtr<FJsonObject> JSinkBuilding = UFRM_Library::CreateBaseJsonObject(Sink);
@@ -663,12 +748,17 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getResourceSinkBuilding(UObject* Wo
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPump(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getPump");
 
 	TArray<TSharedPtr<FJsonValue>> JPumpArray;
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildablePipelinePump*> BuildablePumps;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildablePipelinePump>(BuildablePumps);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildablePipelinePump>(BuildablePumps);
+	}
 
 	for (AFGBuildablePipelinePump* Pump : BuildablePumps) {
 		TSharedPtr<FJsonObject> JPump = UFRM_Library::CreateBaseJsonObject(Pump);
@@ -681,12 +771,17 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPump(UObject* WorldContext, FReq
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPortal(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getPortal");
 
 	TArray<TSharedPtr<FJsonValue>> JPortalArray;
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildablePortal*> BuildablePortal;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildablePortal>(BuildablePortal);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildablePortal>(BuildablePortal);
+	}
 
 	for (AFGBuildablePortal* Portal : BuildablePortal) {
 		TSharedPtr<FJsonObject> JPortal = UFRM_Library::CreateBaseJsonObject(Portal);
@@ -697,7 +792,10 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPortal(UObject* WorldContext, FR
 	}
 
 	TArray<AFGBuildablePortalSatellite*> BuildablePortalSatellite;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildablePortalSatellite>(BuildablePortalSatellite);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildablePortalSatellite>(BuildablePortalSatellite);
+	}
 
 	for (AFGBuildablePortalSatellite* Portal : BuildablePortalSatellite) {
 		TSharedPtr<FJsonObject> JPortal = UFRM_Library::CreateBaseJsonObject(Portal);
@@ -711,12 +809,17 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPortal(UObject* WorldContext, FR
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHypertube(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getHypertube");
 
 	TArray<TSharedPtr<FJsonValue>> JHypertubeArray;
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGPipeHyperStart*> HyperStart;
-	BuildableSubsystem->GetTypedBuildable<AFGPipeHyperStart>(HyperStart);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGPipeHyperStart>(HyperStart);
+	}
 
 	for (AFGPipeHyperStart* Hypertube : HyperStart) {
 		TSharedPtr<FJsonObject> JHypertube = UFRM_Library::CreateBaseJsonObject(Hypertube);
@@ -729,12 +832,17 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getHypertube(UObject* WorldContext,
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getFrackingActivator(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getFrackingActivator");
 
 	TArray<TSharedPtr<FJsonValue>> JFrackingActivatorArray;
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildableFrackingActivator*> FrackingActivator;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableFrackingActivator>(FrackingActivator);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableFrackingActivator>(FrackingActivator);
+	}
 
 	for (AFGBuildableFrackingActivator* Fracking : FrackingActivator) {
 		TSharedPtr<FJsonObject> JFrackingActivator = UFRM_Library::CreateBaseJsonObject(Fracking);
@@ -747,12 +855,17 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getFrackingActivator(UObject* World
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSpaceElevator(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getSpaceElevator");
 
 	TMap<TSubclassOf<UFGItemDescriptor>, int32> CurrentProduced;
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableSpaceElevator*> SpaceElevators;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableSpaceElevator>(SpaceElevators);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableSpaceElevator>(SpaceElevators);
+	}
 	TArray<TSharedPtr<FJsonValue>> JSpaceElevatorArray;
 
 	for (AFGBuildableSpaceElevator* SpaceElevator : SpaceElevators) {
@@ -762,6 +875,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSpaceElevator(UObject* WorldCont
 		TArray<TSharedPtr<FJsonValue>> JCurrentPhaseArray;
 		TArray<FRemainingPhaseCost> RemainingPhaseCost;
 
+		FRM_AUDIT_TOUCH("AFGGamePhaseManager::Get");
 		AFGGamePhaseManager* GamePhaseManager = AFGGamePhaseManager::Get(WorldContext->GetWorld());
 		GamePhaseManager->GetRemainingPhaseCosts(RemainingPhaseCost);
 
@@ -770,7 +884,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSpaceElevator(UObject* WorldCont
 			TSharedPtr<FJsonObject> JCurrentPhase = MakeShared<FJsonObject>();
 
 			JCurrentPhase->Values.Add("Name", MakeShared<FJsonValueString>((CurrentPhase.ItemClass.GetDefaultObject()->mDisplayName.ToString())));
-			JCurrentPhase->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(CurrentPhase.ItemClass)));
+			JCurrentPhase->Values.Add("ClassName", FFRMNameCache::Find(CurrentPhase.ItemClass)->JClassName);
 			JCurrentPhase->Values.Add("Amount", MakeShared<FJsonValueNumber>(CurrentPhase.TotalCost - CurrentPhase.RemainingCost));
 			JCurrentPhase->Values.Add("RemainingCost", MakeShared<FJsonValueNumber>(CurrentPhase.RemainingCost));
 			JCurrentPhase->Values.Add("TotalCost", MakeShared<FJsonValueNumber>(CurrentPhase.TotalCost));
@@ -780,7 +894,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSpaceElevator(UObject* WorldCont
 		};
 
 		JSpaceElevator->Values.Add("Name", MakeShared<FJsonValueString>(SpaceElevator->mDisplayName.ToString()));
-		JSpaceElevator->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(SpaceElevator->GetClass())));
+		JSpaceElevator->Values.Add("ClassName", FFRMNameCache::Find(SpaceElevator->GetClass())->JClassName);
 		JSpaceElevator->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(SpaceElevator)));
 		JSpaceElevator->Values.Add("CurrentPhase", MakeShared<FJsonValueArray>(JCurrentPhaseArray));
 		JSpaceElevator->Values.Add("FullyUpgraded", MakeShared<FJsonValueBoolean>(SpaceElevator->IsFullyUpgraded()));
@@ -795,8 +909,10 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSpaceElevator(UObject* WorldCont
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getCloudInv(UObject* WorldContext, FRequestData RequestData)
 {
+	FRM_TRACE_SCOPE("FRM::getCloudInv");
 	TMap<TSubclassOf<UFGItemDescriptor>, int32> CurrentProduced;
 
+	FRM_AUDIT_TOUCH("AFGCentralStorageSubsystem::Get");
 	AFGCentralStorageSubsystem* CloudSubsystem = AFGCentralStorageSubsystem::Get(WorldContext->GetWorld());
 	TArray<FItemAmount> CloudInventory;
 	TArray<TSharedPtr<FJsonValue>> JCloudArray;
@@ -808,7 +924,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getCloudInv(UObject* WorldContext,
 		TSharedPtr<FJsonObject> JCloud = MakeShared<FJsonObject>();
 
 		JCloud->Values.Add("Name", MakeShared<FJsonValueString>((Storage.ItemClass.GetDefaultObject()->mDisplayName).ToString()));
-		JCloud->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Storage.ItemClass.GetDefaultObject()->GetClass())));
+		JCloud->Values.Add("ClassName", FFRMNameCache::Find(Storage.ItemClass.GetDefaultObject()->GetClass())->JClassName);
 		JCloud->Values.Add("Amount", MakeShared<FJsonValueNumber>(Storage.Amount));
 
 		JCloudArray.Add(MakeShared<FJsonValueObject>(JCloud));
@@ -819,21 +935,28 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getCloudInv(UObject* WorldContext,
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPipes(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getPipes");
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildablePipeline*> Pipes;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildablePipeline>(Pipes);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildablePipeline>(Pipes);
+	}
 	TArray<TSharedPtr<FJsonValue>> JPipeArray;
 
 	for (AFGBuildablePipeline* Pipe : Pipes) {
 
+		if (RequestData.IsOutsideArea(Pipe)) { continue; }
+
 		TSharedPtr<FJsonObject> JPipe = UFRM_Library::CreateBaseJsonObject(Pipe);
 
 		UFGPipeConnectionComponent* ConnectionZero = Pipe->GetPipeConnection0();
 		UFGPipeConnectionComponent* ConnectionOne = Pipe->GetPipeConnection1();
 
 		JPipe->Values.Add("Name", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetDisplayName(Pipe)));
-		JPipe->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Pipe->GetClass())));
+		JPipe->Values.Add("ClassName", FFRMNameCache::Find(Pipe->GetClass())->JClassName);
 		JPipe->Values.Add("location0", MakeShared<FJsonValueObject>(UFRM_Library::getActorPipeXYZ(ConnectionZero)));
 		JPipe->Values.Add("Connected0", MakeShared<FJsonValueBoolean>(ConnectionZero->IsConnected()));
 		JPipe->Values.Add("location1", MakeShared<FJsonValueObject>(UFRM_Library::getActorPipeXYZ(ConnectionOne)));
@@ -850,8 +973,10 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getPipes(UObject* WorldContext, FRe
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSessionInfo(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getSessionInfo");
 
 	const auto GameState = WorldContext->GetWorld()->GetGameState<AFGGameState>();
+	FRM_AUDIT_TOUCH("AFGTimeOfDaySubsystem::Get");
 	const AFGTimeOfDaySubsystem* TimeOfDaySubSystem = AFGTimeOfDaySubsystem::Get(WorldContext);
 
 	const auto PlayDuration = GameState->GetTotalPlayDuration();
@@ -876,20 +1001,26 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getSessionInfo(UObject* WorldContex
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getCables(UObject* WorldContext, FRequestData RequestData) {
+	FRM_TRACE_SCOPE("FRM::getCables");
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildableWire*> PowerWires;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableWire>(PowerWires);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableWire>(PowerWires);
+	}
 	TArray<TSharedPtr<FJsonValue>> JPowerWireArray;
 
 	for (AFGBuildableWire* PowerWire : PowerWires) {
 
 		if (!IsValid(PowerWire)) { continue; }
+		if (RequestData.IsOutsideArea(PowerWire)) { continue; }
 
 		TSharedPtr<FJsonObject> JPowerWire = UFRM_Library::CreateBaseJsonObject(PowerWire);
 
 		JPowerWire->Values.Add("Name", MakeShared<FJsonValueString>(PowerWire->mDisplayName.ToString()));
-		JPowerWire->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(PowerWire->GetClass())));
+		JPowerWire->Values.Add("ClassName", FFRMNameCache::Find(PowerWire->GetClass())->JClassName);
 		JPowerWire->Values.Add("location0", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(PowerWire->GetConnectionLocation(0))));
 		JPowerWire->Values.Add("location1", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(PowerWire->GetConnectionLocation(1))));
 		JPowerWire->Values.Add("Length", MakeShared<FJsonValueNumber>(PowerWire->GetLength()));
@@ -900,4 +1031,100 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getCables(UObject* WorldContext, FR
 	};
 
 	return JPowerWireArray;
-};
\ No newline at end of file
+};
+TArray<TSharedPtr<FJsonValue>> UFRM_Factory::getById(UObject* WorldContext, FRequestData RequestData, const FFRMEntityIndex& EntityIndex) {
+	FRM_TRACE_SCOPE("FRM::getById");
+
+	TArray<TSharedPtr<FJsonValue>> JEntityArray;
+
+	const FString* IDParam = RequestData.QueryParams.Find("id");
+	if (!IDParam || IDParam->IsEmpty()) {
+		JEntityArray.Add(MakeShared<FJsonValueObject>(UFRM_RequestLibrary::GenerateError("Missing query parameter id.")));
+		return JEntityArray;
+	}
+
+	TArray<FString> IDs;
+	IDParam->ParseIntoArray(IDs, TEXT(","));
+
+	for (const FString& ID : IDs) {
+		// numeric IDs are the compact IDs, actor names always start with a letter
+		FFRMEntity Entity;
+		const bool bFound = ID.IsNumeric()
+			? EntityIndex.FindByCompactID(FCString::Strtoui64(*ID, nullptr, 10), Entity)
+			: EntityIndex.Find(ID, Entity);
+
+		AActor* Actor = bFound ? Entity.Actor.Get() : nullptr;
+		if (!Actor) {
+			const TSharedPtr<FJsonObject> JError = UFRM_RequestLibrary::GenerateError("Entity not found.");
+			JError->Values.Add("ID", MakeShared<FJsonValueString>(ID));
+			JEntityArray.Add(MakeShared<FJsonValueObject>(JError));
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> JEntity = UFRM_Library::CreateBaseJsonObject(Actor);
+		const FString ClassName = FFRMNameCache::Find(Actor->GetClass())->ClassName;
+		FString Name = ClassName;
+		AActor* LocationActor = Actor;
+
+		if (const AFGBuildable* Buildable = Cast<AFGBuildable>(Actor)) {
+			Name = Buildable->mDisplayName.ToString();
+		}
+		else if (AFGTrain* Train = Cast<AFGTrain>(Actor)) {
+			// a train has no location of its own, it is where its leading locomotive is
+			Name = Train->GetTrainName().ToString();
+			if (AFGLocomotive* MultiUnitMaster = Train->GetMultipleUnitMaster()) {
+				LocationActor = MultiUnitMaster;
+			}
+		}
+
+		JEntity->Values.Add("CompactID", MakeShared<FJsonValueNumber>(Entity.CompactID));
+		JEntity->Values.Add("Kind", MakeShared<FJsonValueString>(FFRMEntityIndex::GetKindName(Entity.Kind)));
+		JEntity->Values.Add("Name", MakeShared<FJsonValueString>(Name));
+		JEntity->Values.Add("ClassName", MakeShared<FJsonValueString>(ClassName));
+		JEntity->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(LocationActor)));
+
+		if (AFGBuildableFactory* Factory = Cast<AFGBuildableFactory>(Actor)) {
+			JEntity->Values.Add("Productivity", MakeShared<FJsonValueNumber>(Factory->GetProductivity() * 100));
+			JEntity->Values.Add("Potential", MakeShared<FJsonValueNumber>(Factory->GetCurrentPotential() * 100));
+			JEntity->Values.Add("IsProducing", MakeShared<FJsonValueBoolean>(Factory->IsProducing()));
+			JEntity->Values.Add("IsPaused", MakeShared<FJsonValueBoolean>(Factory->IsProductionPaused()));
+			JEntity->Values.Add("PowerInfo", MakeShared<FJsonValueObject>(UFRM_Library::getPowerConsumptionJSON(Factory->GetPowerInfo())));
+		}
+
+		if (const AFGBuildableManufacturer* Manufacturer = Cast<AFGBuildableManufacturer>(Actor)) {
+			JEntity->Values.Add("Recipe", MakeShared<FJsonValueString>(UFGRecipe::GetRecipeName(Manufacturer->GetCurrentRecipe()).ToString()));
+			JEntity->Values.Add("RecipeClassName", FFRMNameCache::Find(Manufacturer->GetCurrentRecipe())->JClassName);
+		}
+
+		if (Entity.Kind == EFRMEntityKind::ResourceNode) {
+			// same fields as getResourceNode, without the ones already set
+			if (const TSharedPtr<FJsonObject> JResourceNode = UFRM_Library::GetResourceNodeJSON(Actor)) {
+				for (const auto& Field : JResourceNode->Values) {
+					if (!JEntity->HasField(Field.Key)) JEntity->Values.Add(Field.Key, Field.Value);
+				}
+			}
+		}
+
+		if (Entity.Kind != EFRMEntityKind::Buildable && Entity.Kind != EFRMEntityKind::ResourceNode) {
+			// cm/s to km/h
+			JEntity->Values.Add("Speed", MakeShared<FJsonValueNumber>(LocationActor->GetVelocity().Size() * 0.036));
+		}
+
+		// every inventory the actor owns, e.g. input and output of a factory or fuel and storage of a vehicle
+		TArray<TSharedPtr<FJsonValue>> JInventoryArray;
+		TInlineComponentArray<UFGInventoryComponent*> Inventories(Actor);
+		for (const UFGInventoryComponent* Inventory : Inventories) {
+			TSharedPtr<FJsonObject> JInventory = MakeShared<FJsonObject>();
+			JInventory->Values.Add("Name", MakeShared<FJsonValueString>(Inventory->GetName()));
+			JInventory->Values.Add("Inventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(UFRM_Library::GetGroupedInventoryItems(Inventory))));
+			JInventoryArray.Add(MakeShared<FJsonValueObject>(JInventory));
+		}
+		JEntity->Values.Add("Inventories", MakeShared<FJsonValueArray>(JInventoryArray));
+
+		JEntity->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(LocationActor, Name, FFRMEntityIndex::GetKindName(Entity.Kind))));
+
+		JEntityArray.Add(MakeShared<FJsonValueObject>(JEntity));
+	}
+
+	return JEntityArray;
+}
@@ -0,0 +1,106 @@
+#include "FRM_Governor.h"
+
+#include "Engine/Engine.h"
+#include "Logging/StructuredLog.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+namespace
+{
+	// smoothing of the per frame cost, about the last 30 frames
+	constexpr double CostSmoothing = 1.0 / 30.0;
+
+	// seconds over budget before going up a level, and below half of it before coming down
+	constexpr double RaiseAfter = 1.0;
+	constexpr double LowerAfter = 5.0;
+}
+
+FFRMGovernor& FFRMGovernor::Get()
+{
+	static FFRMGovernor Instance;
+	return Instance;
+}
+
+void FFRMGovernor::Start(const FFRMGovernorSettings& InSettings)
+{
+	Stop();
+
+	Settings = InSettings;
+	if (Settings.Budget <= 0.0) return;
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFRMGovernor::Tick));
+}
+
+void FFRMGovernor::Stop()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	FrameCost = 0.0;
+	OverSeconds = 0.0;
+	UnderSeconds = 0.0;
+	Level = 0;
+	Cost = 0.0;
+	EffectiveBudget = 0.0;
+}
+
+bool FFRMGovernor::ShouldDefer(const FString& APIName) const
+{
+	return GetLevel() >= 2 && Settings.LowPriority.Contains(APIName);
+}
+
+FFRMGovernor::FScope::FScope()
+{
+	if (!IsInGameThread()) return;
+
+	FFRMGovernor& Governor = FFRMGovernor::Get();
+	bOutermost = Governor.ScopeDepth++ == 0;
+	if (bOutermost) {
+		StartedAt = FPlatformTime::Seconds();
+	}
+}
+
+FFRMGovernor::FScope::~FScope()
+{
+	if (!IsInGameThread()) return;
+
+	FFRMGovernor& Governor = FFRMGovernor::Get();
+	Governor.ScopeDepth--;
+	if (bOutermost) {
+		Governor.FrameCost += FPlatformTime::Seconds() - StartedAt;
+	}
+}
+
+bool FFRMGovernor::Tick(const float DeltaTime)
+{
+	// an uncapped server is held to the frame time it actually runs at
+	const float MaxTickRate = GEngine ? GEngine->GetMaxTickRate(DeltaTime, false) : 0.0f;
+	const double FrameTime = MaxTickRate > 0.0f ? 1.0 / MaxTickRate : DeltaTime;
+	const double Budget = FMath::Min(Settings.Budget, Settings.FrameShare * FrameTime);
+
+	const double Smoothed = FMath::Lerp(Cost.load(std::memory_order_relaxed), FrameCost, CostSmoothing);
+	FrameCost = 0.0;
+
+	Cost.store(Smoothed, std::memory_order_relaxed);
+	EffectiveBudget.store(Budget, std::memory_order_relaxed);
+
+	OverSeconds = Smoothed > Budget ? OverSeconds + DeltaTime : 0.0;
+	UnderSeconds = Smoothed < Budget * 0.5 ? UnderSeconds + DeltaTime : 0.0;
+
+	int32 NewLevel = GetLevel();
+	if (OverSeconds >= RaiseAfter && NewLevel < MaxLevel) {
+		NewLevel++;
+		OverSeconds = 0.0;
+	}
+	else if (UnderSeconds >= LowerAfter && NewLevel > 0) {
+		NewLevel--;
+		UnderSeconds = 0.0;
+	}
+
+	if (NewLevel != GetLevel()) {
+		UE_LOGFMT(LogHttpServer, Log, "Game thread governor at level {Level}: {Cost} ms per frame against a budget of {Budget} ms",
+			NewLevel, Smoothed * 1000.0, Budget * 1000.0);
+		Level.store(NewLevel, std::memory_order_relaxed);
+	}
+
+	return true;
+}
@@ -0,0 +1,195 @@
+#include "FRM_History.h"
+
+#include "Misc/ScopeRWLock.h"
+
+FFRMHistoryBuckets::FFRMHistoryBuckets(const double InFrom, const double InTo, const double InStep)
+	: From(InFrom)
+	, To(FMath::Max(InFrom, InTo))
+	, Step(FMath::Max3(InStep, 0.001, (InTo - InFrom) / MaxBuckets))
+{
+	Start = FMath::FloorToDouble(From / Step) * Step;
+	NumBuckets = FMath::Max(1, FMath::CeilToInt32((To - Start) / Step) + 1);
+}
+
+bool FFRMHistoryBuckets::Matches(const FString& Pattern, const FString& Metric)
+{
+	if (Pattern.EndsWith(TEXT("*"))) {
+		return Metric.StartsWith(Pattern.LeftChop(1), ESearchCase::CaseSensitive);
+	}
+	return Metric.Equals(Pattern, ESearchCase::CaseSensitive);
+}
+
+int32 FFRMHistoryBuckets::AddSeries(const FString& Metric)
+{
+	if (const int32* Found = SeriesIndex.Find(Metric)) return *Found;
+
+	FBuckets& Buckets = Series.AddDefaulted_GetRef();
+	Buckets.Metric = Metric;
+	Buckets.Min.Init(MAX_flt, NumBuckets);
+	Buckets.Max.Init(-MAX_flt, NumBuckets);
+	Buckets.Sum.Init(0.0f, NumBuckets);
+	Buckets.Count.Init(0, NumBuckets);
+
+	return SeriesIndex.Add(Metric, Series.Num() - 1);
+}
+
+void FFRMHistoryBuckets::Add(const int32 Index, const double Time, const float Min, const float Max, const float Sum, const int32 Count)
+{
+	if (Time < From || Time > To) return;
+
+	FBuckets& Buckets = Series[Index];
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt32((Time - Start) / Step), 0, NumBuckets - 1);
+
+	Buckets.Min[Bucket] = FMath::Min(Buckets.Min[Bucket], Min);
+	Buckets.Max[Bucket] = FMath::Max(Buckets.Max[Bucket], Max);
+	Buckets.Sum[Bucket] += Sum;
+	Buckets.Count[Bucket] += Count;
+}
+
+TArray<FFRMHistorySeries> FFRMHistoryBuckets::ToSeries() const
+{
+	TArray<FFRMHistorySeries> Result;
+
+	for (const FBuckets& Buckets : Series) {
+		FFRMHistorySeries& Out = Result.AddDefaulted_GetRef();
+		Out.Metric = Buckets.Metric;
+		Out.Step = Step;
+
+		// empty buckets are left out, clients see the gap in the timestamps
+		for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++) {
+			if (Buckets.Count[Bucket] == 0) continue;
+
+			Out.Times.Add(Start + Bucket * Step);
+			Out.Min.Add(Buckets.Min[Bucket]);
+			Out.Max.Add(Buckets.Max[Bucket]);
+			Out.Avg.Add(Buckets.Sum[Bucket] / Buckets.Count[Bucket]);
+		}
+	}
+
+	return Result;
+}
+
+void FFRMHistory::Reset(const int32 InCapacity)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	Capacity = FMath::Max(InCapacity, 1);
+	Head = 0;
+	Num = 0;
+	BaseMs = 0;
+
+	Offsets.Init(0, Capacity);
+	SeriesIndex.Empty();
+	SeriesNames.Empty();
+	Values.Empty();
+}
+
+void FFRMHistory::Append(const double Timestamp, const TArray<TPair<FString, float>>& Sample)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	if (Capacity == 0) return;
+
+	int64 TimeMs = static_cast<int64>(Timestamp * 1000.0);
+
+	if (Num == 0) {
+		BaseMs = TimeMs;
+	}
+	else {
+		// the wall clock can be set back, keep the column monotonic
+		TimeMs = FMath::Max(TimeMs, BaseMs + Offsets[GetSlot(Num - 1)]);
+
+		// offsets run out after 49 days, move the base up to the oldest sample that is kept
+		if (TimeMs - BaseMs > MAX_uint32) {
+			const int32 Oldest = GetSlot(Num == Capacity ? 1 : 0);
+			const uint32 Shift = Offsets[Oldest];
+
+			for (int32 Age = 0; Age < Num; Age++) {
+				uint32& Offset = Offsets[GetSlot(Age)];
+				Offset = Offset > Shift ? Offset - Shift : 0;
+			}
+			BaseMs += Shift;
+
+			// nothing was sampled for longer than the offsets can span
+			if (TimeMs - BaseMs > MAX_uint32) {
+				Num = 0;
+				BaseMs = TimeMs;
+			}
+		}
+	}
+
+	const int32 Slot = Head;
+	Offsets[Slot] = static_cast<uint32>(TimeMs - BaseMs);
+
+	// the slot may still hold the oldest sample of a series that is not part of this one
+	for (TArray<float>& Column : Values) {
+		Column[Slot] = NAN;
+	}
+
+	for (const TPair<FString, float>& Value : Sample) {
+		int32 Series;
+		if (const int32* Found = SeriesIndex.Find(Value.Key)) {
+			Series = *Found;
+		}
+		else {
+			Series = SeriesNames.Add(Value.Key);
+			SeriesIndex.Add(Value.Key, Series);
+			Values.AddDefaulted_GetRef().Init(NAN, Capacity);
+		}
+
+		Values[Series][Slot] = Value.Value;
+	}
+
+	Head = (Head + 1) % Capacity;
+	Num = FMath::Min(Num + 1, Capacity);
+}
+
+void FFRMHistory::Query(const FString& Metric, FFRMHistoryBuckets& Buckets) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	if (Num == 0 || Buckets.To < Buckets.From) return;
+
+	// timestamps are sorted by age, skip everything before From
+	int32 First = 0, Last = Num;
+	while (First < Last) {
+		const int32 Middle = (First + Last) / 2;
+		if (GetTime(GetSlot(Middle)) < Buckets.From) First = Middle + 1;
+		else Last = Middle;
+	}
+
+	for (int32 Series = 0; Series < SeriesNames.Num(); Series++) {
+		if (!FFRMHistoryBuckets::Matches(Metric, SeriesNames[Series])) continue;
+
+		const int32 Target = Buckets.AddSeries(SeriesNames[Series]);
+		const TArray<float>& Column = Values[Series];
+
+		for (int32 Age = First; Age < Num; Age++) {
+			const int32 Slot = GetSlot(Age);
+			const double Time = GetTime(Slot);
+			if (Time > Buckets.To) break;
+
+			const float Value = Column[Slot];
+			if (FMath::IsNaN(Value)) continue;
+
+			Buckets.Add(Target, Time, Value, Value, Value, 1);
+		}
+	}
+}
+
+TArray<FString> FFRMHistory::GetMetricNames() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return SeriesNames;
+}
+
+bool FFRMHistory::GetTimeRange(double& OutOldest, double& OutNewest) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	if (Num == 0) return false;
+
+	OutOldest = GetTime(GetSlot(0));
+	OutNewest = GetTime(GetSlot(Num - 1));
+	return true;
+}
@@ -0,0 +1,811 @@
+#include "FRM_HistoryStore.h"
+
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Metrics.h"
+
+namespace
+{
+	constexpr uint32 SegmentMagic = 0x534D5246; // "FRMS"
+	constexpr uint32 BlockMagic = 0x424D5246;   // "FRMB"
+	constexpr uint8 SegmentVersion = 1;
+	constexpr int64 SegmentHeaderSize = 8;
+
+	// magic, payload size
+	constexpr int64 BlockHeaderSize = 8;
+
+	// a block is written once it holds this many samples or is older than the flush interval of its tier;
+	// series names are repeated per block, so rollups are written less often
+	constexpr int32 MaxBlockSamples = 360;
+
+	// late samples still reach a rollup bucket or segment for this long after it ended
+	constexpr int64 GraceMs = 5000;
+
+	constexpr double RetentionCheckSeconds = 600.0;
+
+	const TCHAR* TierNames[] = { TEXT("raw"), TEXT("1m"), TEXT("1h") };
+	constexpr int64 TierStepMs[] = { 0, 60 * 1000, 3600 * 1000 };
+	constexpr int64 TierWindowMs[] = { 3600 * 1000, 86400 * 1000, 30LL * 86400 * 1000 };
+	constexpr double TierFlushSeconds[] = { 600.0, 3600.0, 6 * 3600.0 };
+
+	class FBitWriter
+	{
+	public:
+		void Write(const uint64 Value, const int32 Bits)
+		{
+			for (int32 Bit = Bits - 1; Bit >= 0; Bit--) {
+				if ((NumBits & 7) == 0) Bytes.Add(0);
+				if ((Value >> Bit) & 1) Bytes.Last() |= 0x80 >> (NumBits & 7);
+				NumBits++;
+			}
+		}
+
+		TArray<uint8> Bytes;
+
+	private:
+		int64 NumBits = 0;
+	};
+
+	class FBitReader
+	{
+	public:
+		FBitReader(const uint8* InData, const int64 InSize) : Data(InData), SizeBits(InSize * 8) {}
+
+		uint64 Read(const int32 Bits)
+		{
+			uint64 Value = 0;
+			for (int32 Bit = 0; Bit < Bits; Bit++) {
+				if (Position >= SizeBits) {
+					bOverflow = true;
+					return 0;
+				}
+				Value = (Value << 1) | ((Data[Position >> 3] >> (7 - (Position & 7))) & 1);
+				Position++;
+			}
+			return Value;
+		}
+
+		bool bOverflow = false;
+
+	private:
+		const uint8* Data;
+		int64 SizeBits;
+		int64 Position = 0;
+	};
+
+	// Gorilla delta-of-delta, buckets widened to millisecond timestamps
+	void EncodeTimes(const TArray<int64>& Times, FBitWriter& Writer)
+	{
+		int64 PrevDelta = 0;
+		for (int32 Index = 0; Index < Times.Num(); Index++) {
+			if (Index == 0) {
+				Writer.Write(static_cast<uint64>(Times[0]), 64);
+				continue;
+			}
+
+			const int64 Delta = Times[Index] - Times[Index - 1];
+			const int64 DeltaOfDelta = Delta - PrevDelta;
+			PrevDelta = Delta;
+
+			if (DeltaOfDelta == 0) {
+				Writer.Write(0, 1);
+			}
+			else if (DeltaOfDelta >= -63 && DeltaOfDelta <= 64) {
+				Writer.Write(0b10, 2);
+				Writer.Write(DeltaOfDelta & 0x7F, 7);
+			}
+			else if (DeltaOfDelta >= -255 && DeltaOfDelta <= 256) {
+				Writer.Write(0b110, 3);
+				Writer.Write(DeltaOfDelta & 0x1FF, 9);
+			}
+			else if (DeltaOfDelta >= -2047 && DeltaOfDelta <= 2048) {
+				Writer.Write(0b1110, 4);
+				Writer.Write(DeltaOfDelta & 0xFFF, 12);
+			}
+			else {
+				Writer.Write(0b1111, 4);
+				Writer.Write(static_cast<uint64>(DeltaOfDelta), 64);
+			}
+		}
+	}
+
+	bool DecodeTimes(FBitReader& Reader, const int32 Num, TArray<int64>& OutTimes)
+	{
+		// the windows above are asymmetric, values past the positive end are negative
+		const auto SignExtend = [](const uint64 Value, const int32 Bits) {
+			const int64 Signed = static_cast<int64>(Value);
+			return Signed > (1LL << (Bits - 1)) ? Signed - (1LL << Bits) : Signed;
+		};
+
+		OutTimes.Reset(Num);
+		int64 PrevDelta = 0;
+
+		for (int32 Index = 0; Index < Num && !Reader.bOverflow; Index++) {
+			if (Index == 0) {
+				OutTimes.Add(static_cast<int64>(Reader.Read(64)));
+				continue;
+			}
+
+			int64 DeltaOfDelta;
+			if (Reader.Read(1) == 0) DeltaOfDelta = 0;
+			else if (Reader.Read(1) == 0) DeltaOfDelta = SignExtend(Reader.Read(7), 7);
+			else if (Reader.Read(1) == 0) DeltaOfDelta = SignExtend(Reader.Read(9), 9);
+			else if (Reader.Read(1) == 0) DeltaOfDelta = SignExtend(Reader.Read(12), 12);
+			else DeltaOfDelta = static_cast<int64>(Reader.Read(64));
+
+			PrevDelta += DeltaOfDelta;
+			OutTimes.Add(OutTimes.Last() + PrevDelta);
+		}
+
+		return !Reader.bOverflow && OutTimes.Num() == Num;
+	}
+
+	// Gorilla XOR, with 5 bit leading zero and length fields for 32-bit floats
+	void EncodeValues(const float* Values, const int32 Num, const int32 Stride, FBitWriter& Writer)
+	{
+		uint32 Prev = 0;
+		int32 PrevLeading = -1;
+		int32 PrevTrailing = 0;
+
+		for (int32 Index = 0; Index < Num; Index++) {
+			const uint32 Value = FMath::Float32ToUInt32Bits(Values[Index * Stride]);
+
+			if (Index == 0) {
+				Writer.Write(Value, 32);
+				Prev = Value;
+				continue;
+			}
+
+			const uint32 Xor = Value ^ Prev;
+			Prev = Value;
+
+			if (Xor == 0) {
+				Writer.Write(0, 1);
+				continue;
+			}
+
+			Writer.Write(1, 1);
+
+			const int32 Leading = FMath::CountLeadingZeros(Xor);
+			const int32 Trailing = FMath::CountTrailingZeros(Xor);
+
+			if (PrevLeading >= 0 && Leading >= PrevLeading && Trailing >= PrevTrailing) {
+				Writer.Write(0, 1);
+				Writer.Write(Xor >> PrevTrailing, 32 - PrevLeading - PrevTrailing);
+			}
+			else {
+				const int32 Meaningful = 32 - Leading - Trailing;
+				Writer.Write(1, 1);
+				Writer.Write(Leading, 5);
+				Writer.Write(Meaningful - 1, 5);
+				Writer.Write(Xor >> Trailing, Meaningful);
+				PrevLeading = Leading;
+				PrevTrailing = Trailing;
+			}
+		}
+	}
+
+	bool DecodeValues(FBitReader& Reader, const int32 Num, TArray<float>& OutValues)
+	{
+		OutValues.Reset(Num);
+
+		uint32 Prev = 0;
+		int32 PrevLeading = 0;
+		int32 PrevTrailing = 0;
+
+		for (int32 Index = 0; Index < Num && !Reader.bOverflow; Index++) {
+			if (Index == 0) {
+				Prev = static_cast<uint32>(Reader.Read(32));
+			}
+			else if (Reader.Read(1) == 1) {
+				if (Reader.Read(1) == 1) {
+					PrevLeading = static_cast<int32>(Reader.Read(5));
+					PrevTrailing = 32 - PrevLeading - (static_cast<int32>(Reader.Read(5)) + 1);
+					if (PrevTrailing < 0) return false;
+				}
+				Prev ^= static_cast<uint32>(Reader.Read(32 - PrevLeading - PrevTrailing) << PrevTrailing);
+			}
+
+			OutValues.Add(FMath::UInt32BitsToFloat(Prev));
+		}
+
+		return !Reader.bOverflow && OutValues.Num() == Num;
+	}
+
+	template<typename T>
+	void Append(TArray<uint8>& Bytes, const T Value)
+	{
+		Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	void AppendStream(TArray<uint8>& Bytes, const FBitWriter& Writer)
+	{
+		Append<uint32>(Bytes, Writer.Bytes.Num());
+		Bytes.Append(Writer.Bytes);
+	}
+
+	class FByteReader
+	{
+	public:
+		FByteReader(const uint8* InData, const int64 InSize) : Data(InData), Size(InSize) {}
+
+		template<typename T>
+		bool Read(T& OutValue)
+		{
+			if (Position + static_cast<int64>(sizeof(T)) > Size) return false;
+			FMemory::Memcpy(&OutValue, Data + Position, sizeof(T));
+			Position += sizeof(T);
+			return true;
+		}
+
+		/* Returns the next Length bytes and skips them, nullptr if the block is shorter */
+		const uint8* Take(const int64 Length)
+		{
+			if (Length < 0 || Position + Length > Size) return nullptr;
+			const uint8* Result = Data + Position;
+			Position += Length;
+			return Result;
+		}
+
+	private:
+		const uint8* Data;
+		int64 Size;
+		int64 Position = 0;
+	};
+
+	int64 GetWindowStart(const int64 TimeMs, const int64 WindowMs)
+	{
+		return FMath::FloorToInt64(static_cast<double>(TimeMs) / WindowMs) * WindowMs;
+	}
+
+	int64 GetNowMs()
+	{
+		return static_cast<int64>(FDateTime::UtcNow().ToUnixTimestampDecimal() * 1000.0);
+	}
+
+	void FindSegments(const FString& Directory, TArray<FString>& OutFiles)
+	{
+		IFileManager::Get().FindFiles(OutFiles, *(Directory / TEXT("*.seg")), true, false);
+
+		TArray<FString> OpenFiles;
+		IFileManager::Get().FindFiles(OpenFiles, *(Directory / TEXT("*.open")), true, false);
+		OutFiles.Append(OpenFiles);
+	}
+
+	int64 GetSegmentStartMs(const FString& File)
+	{
+		return FCString::Atoi64(*FPaths::GetBaseFilename(File)) * 1000;
+	}
+}
+
+FFRMHistoryStore::~FFRMHistoryStore()
+{
+	Stop();
+}
+
+void FFRMHistoryStore::Start(const FString& InDirectory, const FFRMHistoryStoreSettings& InSettings)
+{
+	Stop();
+
+	Directory = InDirectory;
+	Settings = InSettings;
+	Tiers.Reset();
+
+	for (int32 Index = 0; Index < static_cast<int32>(EFRMHistoryTier::Num); Index++) {
+		if (Settings.Retention[Index] <= 0.0) continue;
+
+		FTier& Tier = Tiers.AddDefaulted_GetRef();
+		Tier.Tier = static_cast<EFRMHistoryTier>(Index);
+		Tier.Directory = Directory / TierNames[Index];
+		Tier.StepMs = TierStepMs[Index];
+		Tier.WindowMs = TierWindowMs[Index];
+		Tier.RetentionMs = static_cast<int64>(Settings.Retention[Index] * 1000.0);
+	}
+
+	if (Tiers.IsEmpty()) return;
+
+	bStopRequested = false;
+	WakeUp = FPlatformProcess::GetSynchEventFromPool(false);
+	bRunning = true;
+
+	Writer = Async(EAsyncExecution::Thread, [this]() {
+		WriterLoop();
+	});
+}
+
+void FFRMHistoryStore::Stop()
+{
+	if (!bRunning) return;
+
+	bStopRequested = true;
+	WakeUp->Trigger();
+	Writer.Wait();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeUp);
+	WakeUp = nullptr;
+	bRunning = false;
+}
+
+void FFRMHistoryStore::Enqueue(const double Timestamp, TArray<TPair<FString, float>> Sample)
+{
+	if (!bRunning) return;
+
+	// the writer polls the queue, waking it for every sample isn't worth it
+	Queue.Enqueue(FPendingSample{ static_cast<int64>(Timestamp * 1000.0), MoveTemp(Sample) });
+}
+
+void FFRMHistoryStore::WriterLoop()
+{
+	for (FTier& Tier : Tiers) {
+		IFileManager::Get().MakeDirectory(*Tier.Directory, true);
+		RecoverSegments(Tier);
+	}
+
+	double LastRetentionCheck = 0.0;
+
+	while (true) {
+		// read before draining, samples queued before Stop() are written
+		const bool bStop = bStopRequested;
+
+		FPendingSample Sample;
+		while (Queue.Dequeue(Sample)) {
+			FRM_TRACE_SCOPE("FRM::HistoryStore::Append");
+			Process(Sample);
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		const int64 NowMs = GetNowMs();
+
+		for (FTier& Tier : Tiers) {
+			// the bucket is complete once samples for it can't arrive anymore
+			if (Tier.Rollup.BucketMs >= 0 && (bStop || NowMs >= Tier.Rollup.BucketMs + Tier.StepMs + GraceMs)) {
+				FlushRollup(Tier);
+			}
+
+			if (!Tier.Block.Times.IsEmpty() && (bStop || Now - Tier.BlockStarted >= TierFlushSeconds[static_cast<int32>(Tier.Tier)])) {
+				FlushBlock(Tier);
+			}
+
+			if (Tier.SegmentFile && Tier.Block.Times.IsEmpty() && NowMs >= Tier.SegmentStartMs + Tier.WindowMs + GraceMs) {
+				FWriteScopeLock WriteLock(SegmentLock);
+				SealSegment(Tier);
+			}
+		}
+
+		if (Now - LastRetentionCheck >= RetentionCheckSeconds) {
+			LastRetentionCheck = Now;
+			for (const FTier& Tier : Tiers) {
+				ApplyRetention(Tier, NowMs);
+			}
+		}
+
+		if (bStop) {
+			FWriteScopeLock WriteLock(SegmentLock);
+			for (FTier& Tier : Tiers) {
+				// stays .open and is appended to by the next session if its window hasn't passed
+				Tier.SegmentFile.Reset();
+			}
+			break;
+		}
+
+		WakeUp->Wait(FTimespan::FromSeconds(1.0));
+	}
+}
+
+void FFRMHistoryStore::Process(const FPendingSample& Sample)
+{
+	for (FTier& Tier : Tiers) {
+		if (Tier.Tier != EFRMHistoryTier::Raw) {
+			AddToRollup(Tier, Sample.TimeMs, Sample.Values);
+			continue;
+		}
+
+		TArray<FString> Names;
+		TArray<float> Values;
+		Names.Reserve(Sample.Values.Num());
+		Values.Reserve(Sample.Values.Num());
+
+		for (const TPair<FString, float>& Value : Sample.Values) {
+			Names.Add(Value.Key);
+			Values.Add(Value.Value);
+		}
+
+		AddToBlock(Tier, Sample.TimeMs, Names, Values);
+	}
+}
+
+void FFRMHistoryStore::AddToBlock(FTier& Tier, int64 TimeMs, const TArray<FString>& Names, const TArray<float>& Values)
+{
+	const int32 ValuesPerSeries = GetValuesPerSeries(Tier.Tier);
+	FTierBlock& Block = Tier.Block;
+
+	TimeMs = FMath::Max(TimeMs, Tier.LastTimeMs);
+	Tier.LastTimeMs = TimeMs;
+
+	// a block never spans two segments
+	if (!Block.Times.IsEmpty() && GetWindowStart(Block.Times[0], Tier.WindowMs) != GetWindowStart(TimeMs, Tier.WindowMs)) {
+		FlushBlock(Tier);
+	}
+
+	if (Block.Times.IsEmpty()) {
+		Tier.BlockStarted = FPlatformTime::Seconds();
+	}
+
+	const int32 Row = Block.Times.Add(TimeMs);
+
+	for (TArray<float>& Column : Block.Values) {
+		Column.AddUninitialized(ValuesPerSeries);
+		for (int32 Value = 0; Value < ValuesPerSeries; Value++) {
+			Column[Row * ValuesPerSeries + Value] = NAN;
+		}
+	}
+
+	for (int32 Index = 0; Index < Names.Num(); Index++) {
+		int32 Series;
+		if (const int32* Found = Block.SeriesIndex.Find(Names[Index])) {
+			Series = *Found;
+		}
+		else {
+			Series = Block.SeriesNames.Add(Names[Index]);
+			Block.SeriesIndex.Add(Names[Index], Series);
+			Block.Values.AddDefaulted_GetRef().Init(NAN, (Row + 1) * ValuesPerSeries);
+		}
+
+		for (int32 Value = 0; Value < ValuesPerSeries; Value++) {
+			Block.Values[Series][Row * ValuesPerSeries + Value] = Values[Index * ValuesPerSeries + Value];
+		}
+	}
+
+	if (Block.Times.Num() >= MaxBlockSamples) {
+		FlushBlock(Tier);
+	}
+}
+
+void FFRMHistoryStore::AddToRollup(FTier& Tier, const int64 TimeMs, const TArray<TPair<FString, float>>& Values)
+{
+	FRollup& Rollup = Tier.Rollup;
+	const int64 BucketMs = GetWindowStart(TimeMs, Tier.StepMs);
+
+	if (Rollup.BucketMs >= 0 && Rollup.BucketMs != BucketMs) {
+		FlushRollup(Tier);
+	}
+	Rollup.BucketMs = BucketMs;
+
+	for (const TPair<FString, float>& Value : Values) {
+		if (FMath::IsNaN(Value.Value)) continue;
+
+		int32 Series;
+		if (const int32* Found = Rollup.SeriesIndex.Find(Value.Key)) {
+			Series = *Found;
+		}
+		else {
+			Series = Rollup.SeriesNames.Add(Value.Key);
+			Rollup.SeriesIndex.Add(Value.Key, Series);
+			Rollup.Min.Add(MAX_flt);
+			Rollup.Max.Add(-MAX_flt);
+			Rollup.Sum.Add(0.0);
+			Rollup.Count.Add(0);
+		}
+
+		Rollup.Min[Series] = FMath::Min(Rollup.Min[Series], Value.Value);
+		Rollup.Max[Series] = FMath::Max(Rollup.Max[Series], Value.Value);
+		Rollup.Sum[Series] += Value.Value;
+		Rollup.Count[Series]++;
+	}
+}
+
+void FFRMHistoryStore::FlushRollup(FTier& Tier)
+{
+	FRollup& Rollup = Tier.Rollup;
+
+	if (!Rollup.SeriesNames.IsEmpty()) {
+		TArray<float> Values;
+		Values.Reserve(Rollup.SeriesNames.Num() * 3);
+
+		for (int32 Series = 0; Series < Rollup.SeriesNames.Num(); Series++) {
+			Values.Add(Rollup.Min[Series]);
+			Values.Add(Rollup.Max[Series]);
+			Values.Add(static_cast<float>(Rollup.Sum[Series] / Rollup.Count[Series]));
+		}
+
+		AddToBlock(Tier, Rollup.BucketMs, Rollup.SeriesNames, Values);
+	}
+
+	Rollup = FRollup();
+}
+
+void FFRMHistoryStore::FlushBlock(FTier& Tier)
+{
+	FRM_TRACE_SCOPE("FRM::HistoryStore::FlushBlock");
+
+	FTierBlock& Block = Tier.Block;
+	if (Block.Times.IsEmpty()) return;
+
+	const TArray<uint8> Bytes = EncodeBlock(Block, GetValuesPerSeries(Tier.Tier));
+	const int64 WindowStartMs = GetWindowStart(Block.Times[0], Tier.WindowMs);
+	Block = FTierBlock();
+
+	FWriteScopeLock WriteLock(SegmentLock);
+
+	if (Tier.SegmentFile && Tier.SegmentStartMs != WindowStartMs) {
+		SealSegment(Tier);
+	}
+
+	if (!Tier.SegmentFile) {
+		const FString Path = Tier.Directory / FString::Printf(TEXT("%lld.open"), WindowStartMs / 1000);
+		const bool bExists = FPaths::FileExists(Path);
+
+		Tier.SegmentFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true, true));
+		if (!Tier.SegmentFile) {
+			UE_LOG(LogFRMAPI, Warning, TEXT("History: could not open segment %s"), *Path);
+			return;
+		}
+		Tier.SegmentStartMs = WindowStartMs;
+
+		if (!bExists || Tier.SegmentFile->Size() == 0) {
+			TArray<uint8> Header;
+			Append<uint32>(Header, SegmentMagic);
+			Append<uint8>(Header, SegmentVersion);
+			Append<uint8>(Header, static_cast<uint8>(Tier.Tier));
+			Append<uint16>(Header, 0);
+			Tier.SegmentFile->Write(Header.GetData(), Header.Num());
+		}
+	}
+
+	if (!Tier.SegmentFile->Write(Bytes.GetData(), Bytes.Num()) || !Tier.SegmentFile->Flush()) {
+		UE_LOG(LogFRMAPI, Warning, TEXT("History: writing to the %s segment failed"), TierNames[static_cast<int32>(Tier.Tier)]);
+	}
+}
+
+void FFRMHistoryStore::SealSegment(FTier& Tier)
+{
+	if (!Tier.SegmentFile) return;
+	Tier.SegmentFile.Reset();
+
+	const FString Name = FString::Printf(TEXT("%lld"), Tier.SegmentStartMs / 1000);
+	IFileManager::Get().Move(*(Tier.Directory / Name + TEXT(".seg")), *(Tier.Directory / Name + TEXT(".open")));
+
+	Tier.LastTimeMs = FMath::Max(Tier.LastTimeMs, Tier.SegmentStartMs + Tier.WindowMs);
+	Tier.SegmentStartMs = -1;
+}
+
+void FFRMHistoryStore::RecoverSegments(FTier& Tier)
+{
+	TArray<FString> Files;
+	FindSegments(Tier.Directory, Files);
+
+	const int64 NowMs = GetNowMs();
+
+	for (const FString& File : Files) {
+		const FString Path = Tier.Directory / File;
+		const int64 StartMs = GetSegmentStartMs(File);
+
+		if (File.EndsWith(TEXT(".seg"))) {
+			Tier.LastTimeMs = FMath::Max(Tier.LastTimeMs, StartMs + Tier.WindowMs);
+			continue;
+		}
+
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Path)) continue;
+
+		int64 LastMs = 0;
+		const int64 ValidSize = ScanSegment(Bytes.GetData(), Bytes.Num(), LastMs);
+
+		FWriteScopeLock WriteLock(SegmentLock);
+
+		if (ValidSize < SegmentHeaderSize) {
+			IFileManager::Get().Delete(*Path);
+			continue;
+		}
+
+		if (ValidSize < Bytes.Num()) {
+			UE_LOG(LogFRMAPI, Warning, TEXT("History: dropping %lld bytes of an incomplete block from %s"), Bytes.Num() - ValidSize, *Path);
+			FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Bytes.GetData(), ValidSize), *Path);
+		}
+
+		Tier.LastTimeMs = FMath::Max(Tier.LastTimeMs, LastMs);
+
+		if (NowMs >= StartMs + Tier.WindowMs) {
+			IFileManager::Get().Move(*FPaths::ChangeExtension(Path, TEXT("seg")), *Path);
+			Tier.LastTimeMs = FMath::Max(Tier.LastTimeMs, StartMs + Tier.WindowMs);
+		}
+	}
+}
+
+void FFRMHistoryStore::ApplyRetention(const FTier& Tier, const int64 NowMs)
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(Tier.Directory / TEXT("*.seg")), true, false);
+
+	for (const FString& File : Files) {
+		if (GetSegmentStartMs(File) + Tier.WindowMs >= NowMs - Tier.RetentionMs) continue;
+
+		FWriteScopeLock WriteLock(SegmentLock);
+		IFileManager::Get().Delete(*(Tier.Directory / File));
+	}
+}
+
+TArray<uint8> FFRMHistoryStore::EncodeBlock(const FTierBlock& Block, const int32 ValuesPerSeries)
+{
+	TArray<uint8> Payload;
+	Append<int64>(Payload, Block.Times[0]);
+	Append<int64>(Payload, Block.Times.Last());
+	Append<uint32>(Payload, Block.Times.Num());
+	Append<uint32>(Payload, Block.SeriesNames.Num());
+
+	for (const FString& Name : Block.SeriesNames) {
+		const FTCHARToUTF8 Utf8(*Name);
+		Append<uint16>(Payload, Utf8.Length());
+		Payload.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	FBitWriter TimeWriter;
+	EncodeTimes(Block.Times, TimeWriter);
+	AppendStream(Payload, TimeWriter);
+
+	for (const TArray<float>& Column : Block.Values) {
+		for (int32 Value = 0; Value < ValuesPerSeries; Value++) {
+			FBitWriter ValueWriter;
+			EncodeValues(Column.GetData() + Value, Block.Times.Num(), ValuesPerSeries, ValueWriter);
+			AppendStream(Payload, ValueWriter);
+		}
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(BlockHeaderSize + Payload.Num());
+	Append<uint32>(Bytes, BlockMagic);
+	Append<uint32>(Bytes, Payload.Num());
+	Bytes.Append(Payload);
+
+	return Bytes;
+}
+
+int64 FFRMHistoryStore::ScanSegment(const uint8* Data, const int64 Size, int64& OutLastMs)
+{
+	FByteReader Reader(Data, Size);
+
+	uint32 Magic = 0;
+	if (!Reader.Read(Magic) || Magic != SegmentMagic || !Reader.Take(SegmentHeaderSize - sizeof(uint32))) return 0;
+
+	int64 ValidSize = SegmentHeaderSize;
+
+	uint32 PayloadSize = 0;
+	while (Reader.Read(Magic) && Magic == BlockMagic && Reader.Read(PayloadSize)) {
+		const uint8* Payload = Reader.Take(PayloadSize);
+		if (!Payload || PayloadSize < 2 * sizeof(int64)) break;
+
+		FMemory::Memcpy(&OutLastMs, Payload + sizeof(int64), sizeof(int64));
+		ValidSize += BlockHeaderSize + PayloadSize;
+	}
+
+	return ValidSize;
+}
+
+void FFRMHistoryStore::DecodeSegment(const uint8* Data, const int64 Size, const int32 ValuesPerSeries, const FString& Metric, const int64 FromMs, const int64 ToMs, FFRMHistoryBuckets& Buckets)
+{
+	FByteReader Segment(Data, Size);
+
+	uint32 Magic = 0;
+	if (!Segment.Read(Magic) || Magic != SegmentMagic || !Segment.Take(SegmentHeaderSize - sizeof(uint32))) return;
+
+	TArray<int64> Times;
+	TArray<float> Values[3];
+
+	uint32 PayloadSize = 0;
+	while (Segment.Read(Magic) && Magic == BlockMagic && Segment.Read(PayloadSize)) {
+		const uint8* Payload = Segment.Take(PayloadSize);
+		if (!Payload) return;
+
+		FByteReader Block(Payload, PayloadSize);
+
+		int64 FirstMs = 0, LastMs = 0;
+		uint32 NumSamples = 0, NumSeries = 0;
+		if (!Block.Read(FirstMs) || !Block.Read(LastMs) || !Block.Read(NumSamples) || !Block.Read(NumSeries)) return;
+
+		if (LastMs < FromMs || FirstMs > ToMs) continue;
+
+		TArray<FString> Names;
+		Names.Reserve(NumSeries);
+		for (uint32 Series = 0; Series < NumSeries; Series++) {
+			uint16 Length = 0;
+			const uint8* Name = Block.Read(Length) ? Block.Take(Length) : nullptr;
+			if (!Name) return;
+
+			Names.Add(FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Name), Length)));
+		}
+
+		uint32 StreamSize = 0;
+		const uint8* TimeStream = Block.Read(StreamSize) ? Block.Take(StreamSize) : nullptr;
+		if (!TimeStream) return;
+
+		FBitReader TimeReader(TimeStream, StreamSize);
+		if (!DecodeTimes(TimeReader, NumSamples, Times)) return;
+
+		for (uint32 Series = 0; Series < NumSeries; Series++) {
+			const bool bMatches = FFRMHistoryBuckets::Matches(Metric, Names[Series]);
+
+			for (int32 Value = 0; Value < ValuesPerSeries; Value++) {
+				const uint8* Stream = Block.Read(StreamSize) ? Block.Take(StreamSize) : nullptr;
+				if (!Stream) return;
+				if (!bMatches) continue;
+
+				FBitReader ValueReader(Stream, StreamSize);
+				if (!DecodeValues(ValueReader, NumSamples, Values[Value])) return;
+			}
+
+			if (!bMatches) continue;
+
+			const int32 Target = Buckets.AddSeries(Names[Series]);
+
+			for (uint32 Sample = 0; Sample < NumSamples; Sample++) {
+				if (Times[Sample] < FromMs || Times[Sample] > ToMs) continue;
+
+				const double Time = Times[Sample] / 1000.0;
+
+				if (ValuesPerSeries == 1) {
+					const float Value = Values[0][Sample];
+					if (!FMath::IsNaN(Value)) Buckets.Add(Target, Time, Value, Value, Value, 1);
+				}
+				else if (!FMath::IsNaN(Values[2][Sample])) {
+					Buckets.Add(Target, Time, Values[0][Sample], Values[1][Sample], Values[2][Sample], 1);
+				}
+			}
+		}
+	}
+}
+
+void FFRMHistoryStore::Query(const FString& Metric, const double Before, FFRMHistoryBuckets& Buckets) const
+{
+	FRM_TRACE_SCOPE("FRM::HistoryStore::Query");
+
+	if (!bRunning || Tiers.IsEmpty()) return;
+
+	const int64 NowMs = GetNowMs();
+	const int64 FromMs = static_cast<int64>(Buckets.From * 1000.0);
+	const int64 ToMs = Before <= Buckets.To ? static_cast<int64>(Before * 1000.0) - 1 : static_cast<int64>(Buckets.To * 1000.0);
+	if (ToMs < FromMs) return;
+
+	// the coarsest tier that still resolves the step, or a coarser one if it doesn't reach back far enough
+	int32 Index = 0;
+	while (Index + 1 < Tiers.Num() && Tiers[Index + 1].StepMs <= Buckets.Step * 1000.0) Index++;
+	while (Index + 1 < Tiers.Num() && FromMs < NowMs - Tiers[Index].RetentionMs) Index++;
+
+	const FTier& Tier = Tiers[Index];
+	const int32 ValuesPerSeries = GetValuesPerSeries(Tier.Tier);
+
+	FReadScopeLock ReadLock(SegmentLock);
+
+	TArray<FString> Files;
+	FindSegments(Tier.Directory, Files);
+	Files.Sort([](const FString& A, const FString& B) { return GetSegmentStartMs(A) < GetSegmentStartMs(B); });
+
+	for (const FString& File : Files) {
+		const int64 StartMs = GetSegmentStartMs(File);
+		if (StartMs > ToMs || StartMs + Tier.WindowMs < FromMs) continue;
+
+		const FString Path = Tier.Directory / File;
+
+		// sealed segments never change, map them instead of copying
+		if (File.EndsWith(TEXT(".seg"))) {
+			TUniquePtr<IMappedFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+			if (Handle) {
+				TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion());
+				if (Region) {
+					DecodeSegment(Region->GetMappedPtr(), Region->GetMappedSize(), ValuesPerSeries, Metric, FromMs, ToMs, Buckets);
+					continue;
+				}
+			}
+		}
+
+		TArray<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent | FILEREAD_AllowWrite)) {
+			DecodeSegment(Bytes.GetData(), Bytes.Num(), ValuesPerSeries, Metric, FromMs, ToMs, Buckets);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#include "FRM_ItemRegistry.h"
+
+#include "Logging/StructuredLog.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectIterator.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+FFRMItemRegistry& FFRMItemRegistry::Get()
+{
+	static FFRMItemRegistry Instance;
+	return Instance;
+}
+
+void FFRMItemRegistry::Build()
+{
+	FRM_TRACE_SCOPE("FRM::ItemRegistry::Build");
+
+	TArray<UClass*> Found;
+	for (TObjectIterator<UClass> It; It; ++It) {
+		UClass* Class = *It;
+		if (!Class->IsChildOf(UFGItemDescriptor::StaticClass())) continue;
+		if (Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists)) continue;
+
+		// compile-time copies of Blueprint classes never hold items
+		const FString Name = Class->GetName();
+		if (Name.StartsWith(TEXT("SKEL_")) || Name.StartsWith(TEXT("REINST_"))) continue;
+
+		Found.Add(Class);
+	}
+
+	// the same items get the same IDs in every session, which keeps the order of the inventory lists stable
+	Found.Sort([](const UClass& A, const UClass& B) { return A.GetName() < B.GetName(); });
+
+	FWriteScopeLock WriteLock(Lock);
+	for (const UClass* Class : Found) {
+		if (!IDs.Contains(Class)) {
+			Register(Class);
+		}
+	}
+
+	UE_LOGFMT(LogFRMAPI, Log, "Item registry holds {Count} item descriptors", Items.Num() - 1);
+}
+
+uint16 FFRMItemRegistry::GetID(const UClass* Item)
+{
+	if (!Item) return InvalidID;
+
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const uint16* ID = IDs.Find(Item)) {
+			return *ID;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	if (const uint16* ID = IDs.Find(Item)) {
+		return *ID;
+	}
+
+	return Register(Item);
+}
+
+TSubclassOf<UFGItemDescriptor> FFRMItemRegistry::GetItem(const uint16 ID) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Items.IsValidIndex(ID) ? Items[ID] : nullptr;
+}
+
+int32 FFRMItemRegistry::Num() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Items.Num();
+}
+
+uint16 FFRMItemRegistry::Register(const UClass* Item)
+{
+	if (Items.Num() >= TNumericLimits<uint16>::Max()) {
+		UE_LOGFMT(LogFRMAPI, Error, "Item registry is full, {Item} is left out of inventories", Item->GetName());
+		return InvalidID;
+	}
+
+	const uint16 ID = static_cast<uint16>(Items.Num());
+	Items.Add(const_cast<UClass*>(Item));
+	IDs.Add(Item, ID);
+
+	return ID;
+}
+
+void FFRMItemCounts::Add(const TArray<FFRMItemStack>& Stacks)
+{
+	for (const FFRMItemStack& Stack : Stacks) {
+		if (Stack.ID >= Amounts.Num()) {
+			Amounts.SetNumZeroed(FMath::Max<int32>(Stack.ID + 1, FFRMItemRegistry::Get().Num()));
+		}
+
+		Amounts[Stack.ID] += Stack.Amount;
+	}
+}
+
+void FFRMItemCounts::GetStacks(TArray<FFRMItemStack>& OutStacks) const
+{
+	for (int32 ID = 1; ID < Amounts.Num(); ID++) {
+		if (Amounts[ID] != 0) {
+			OutStacks.Add({static_cast<uint16>(ID), Amounts[ID]});
+		}
+	}
+}
@@ -0,0 +1,125 @@
+#include "FRM_JsonWriter.h"
+
+#include "FRM_NameCache.h"
+
+void FFRMJsonWriter::WriteArray(std::string& Out, const TArray<TSharedPtr<FJsonValue>>& Values)
+{
+	Out.push_back('[');
+
+	for (int32 Index = 0; Index < Values.Num(); Index++) {
+		if (Index > 0) Out.push_back(',');
+		WriteValue(Out, Values[Index]);
+	}
+
+	Out.push_back(']');
+}
+
+void FFRMJsonWriter::WriteObject(std::string& Out, const TSharedPtr<FJsonObject>& Object)
+{
+	if (!Object.IsValid()) {
+		Out.append("null");
+		return;
+	}
+
+	Out.push_back('{');
+
+	bool bFirst = true;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values) {
+		if (!bFirst) Out.push_back(',');
+		bFirst = false;
+
+		WriteString(Out, Field.Key);
+		Out.push_back(':');
+		WriteValue(Out, Field.Value);
+	}
+
+	Out.push_back('}');
+}
+
+void FFRMJsonWriter::WriteString(std::string& Out, const FString& Value)
+{
+	// keys and most values are plain ASCII and are copied as they are
+	bool bPlain = true;
+	for (const TCHAR Char : Value) {
+		if (Char < 0x20 || Char > 0x7e || Char == TEXT('"') || Char == TEXT('\\')) {
+			bPlain = false;
+			break;
+		}
+	}
+
+	if (bPlain) {
+		Out.reserve(Out.size() + Value.Len() + 2);
+		Out.push_back('"');
+		for (const TCHAR Char : Value) {
+			Out.push_back(static_cast<char>(Char));
+		}
+		Out.push_back('"');
+		return;
+	}
+
+	FString Escaped;
+	Escaped.Reserve(Value.Len() + 2);
+	Escaped += TEXT('"');
+
+	for (const TCHAR Char : Value) {
+		switch (Char) {
+			case TEXT('"'): Escaped += TEXT("\\\""); break;
+			case TEXT('\\'): Escaped += TEXT("\\\\"); break;
+			case TEXT('\b'): Escaped += TEXT("\\b"); break;
+			case TEXT('\f'): Escaped += TEXT("\\f"); break;
+			case TEXT('\n'): Escaped += TEXT("\\n"); break;
+			case TEXT('\r'): Escaped += TEXT("\\r"); break;
+			case TEXT('\t'): Escaped += TEXT("\\t"); break;
+			default:
+				if (Char < 0x20) {
+					Escaped += FString::Printf(TEXT("\\u%04x"), Char);
+				}
+				else {
+					Escaped += Char;
+				}
+		}
+	}
+
+	Escaped += TEXT('"');
+
+	const FTCHARToUTF8 Utf8(*Escaped);
+	Out.append(Utf8.Get(), Utf8.Length());
+}
+
+void FFRMJsonWriter::WriteValue(std::string& Out, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid()) {
+		Out.append("null");
+		return;
+	}
+
+	switch (Value->Type) {
+		case EJson::String:
+			// a value held by more than one owner may be a cached name, unique values are never looked up
+			if (Value.GetSharedReferenceCount() > 1 && FFRMNameCache::AppendEncoded(Out, Value.Get())) break;
+			WriteString(Out, Value->AsString());
+			break;
+		case EJson::Number:
+			WriteNumber(Out, Value->AsNumber());
+			break;
+		case EJson::Boolean:
+			Out.append(Value->AsBool() ? "true" : "false");
+			break;
+		case EJson::Array:
+			WriteArray(Out, Value->AsArray());
+			break;
+		case EJson::Object:
+			WriteObject(Out, Value->AsObject());
+			break;
+		default:
+			Out.append("null");
+	}
+}
+
+void FFRMJsonWriter::WriteNumber(std::string& Out, const double Value)
+{
+	// 17 significant digits like TJsonWriter, integers come out without a fraction
+	ANSICHAR Buffer[32];
+	const int32 Length = FCStringAnsi::Snprintf(Buffer, UE_ARRAY_COUNT(Buffer), "%.17g", Value);
+	Out.append(Buffer, FMath::Clamp(Length, 0, static_cast<int32>(UE_ARRAY_COUNT(Buffer)) - 1));
+}
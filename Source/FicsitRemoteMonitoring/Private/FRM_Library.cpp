@@ -3,8 +3,11 @@
 
 #include "FGCircuitConnectionComponent.h"
 #include "FRM_Factory.h"
+#include "FRM_NameCache.h"
+#include "FRM_ThreadAudit.h"
 
 TSharedPtr<FJsonObject> UFRM_Library::getActorJSON(AActor* Actor) {
+	FRM_AUDIT_TOUCH("AActor");
 
 	TSharedPtr<FJsonObject> JLibrary = MakeShared<FJsonObject>();
 
@@ -29,6 +32,7 @@ TSharedPtr<FJsonObject> UFRM_Library::getActorJSON(AActor* Actor) {
 };
 
 TSharedPtr<FJsonObject> UFRM_Library::getActorFactoryCompXYZ(UFGFactoryConnectionComponent* BeltPipe) {
+	FRM_AUDIT_TOUCH("USceneComponent");
 
 	TSharedPtr<FJsonObject> JLibrary = MakeShared<FJsonObject>();
 
@@ -61,6 +65,7 @@ TSharedPtr<FJsonObject> UFRM_Library::ConvertVectorToFJsonObject(FVector PowerWi
 };
 
 TSharedPtr<FJsonObject> UFRM_Library::getActorPipeXYZ(UFGPipeConnectionComponent* BeltPipe) {
+	FRM_AUDIT_TOUCH("USceneComponent");
 
 	TSharedPtr<FJsonObject> JLibrary = MakeShared<FJsonObject>();
 
@@ -77,6 +82,7 @@ TSharedPtr<FJsonObject> UFRM_Library::getActorPipeXYZ(UFGPipeConnectionComponent
 };
 
 TSharedPtr<FJsonObject> UFRM_Library::getActorFeaturesJSON(AActor* Actor, FString DisplayName, FString TypeName) {
+	FRM_AUDIT_TOUCH("AActor");
 
 	TSharedPtr<FJsonObject> JProperties = MakeShared<FJsonObject>();
 
@@ -107,8 +113,45 @@ TSharedPtr<FJsonObject> UFRM_Library::getActorFeaturesJSON(AActor* Actor, FStrin
 
 };
 
+TSharedPtr<FJsonObject> UFRM_Library::GetLocationJSON(const FVector& Location, const float Yaw) {
+
+	// same normalised rotation as getActorJSON
+	TSharedPtr<FJsonObject> JLocation = ConvertVectorToFJsonObject(Location);
+	JLocation->Values.Add("rotation", MakeShared<FJsonValueNumber>(fmod(Yaw + 450.0, 360.0)));
+
+	return JLocation;
+
+};
+
+TSharedPtr<FJsonObject> UFRM_Library::GetPointFeaturesJSON(const FVector& Location, const FString& DisplayName, const FString& TypeName) {
+
+	TSharedPtr<FJsonObject> JProperties = MakeShared<FJsonObject>();
+
+	JProperties->Values.Add("name", MakeShared<FJsonValueString>(DisplayName));
+	JProperties->Values.Add("type", MakeShared<FJsonValueString>(TypeName));
+
+	TSharedPtr<FJsonObject> JGeometry = MakeShared<FJsonObject>();
+
+	JGeometry->Values.Add("coordinates", MakeShared<FJsonValueObject>(ConvertVectorToFJsonObject(Location)));
+	JGeometry->Values.Add("type", MakeShared<FJsonValueString>("Point"));
+
+	TSharedPtr<FJsonObject> JFeatures = MakeShared<FJsonObject>();
+
+	JFeatures->Values.Add("properties", MakeShared<FJsonValueObject>(JProperties));
+	JFeatures->Values.Add("geometry", MakeShared<FJsonValueObject>(JGeometry));
+
+	return JFeatures;
+
+};
+
 TSharedPtr<FJsonObject> UFRM_Library::GetActorLineFeaturesJSON(FVector PointOne, FVector PointTwo, FString DisplayName, FString TypeName) {
 
+	return GetActorLineFeaturesJSON(TArray<FVector>{PointOne, PointTwo}, DisplayName, TypeName);
+
+};
+
+TSharedPtr<FJsonObject> UFRM_Library::GetActorLineFeaturesJSON(const TArray<FVector>& Points, FString DisplayName, FString TypeName) {
+
 	TSharedRef<FJsonObject> JProperties = MakeShareable(new FJsonObject());
 
 	JProperties->SetStringField("name", DisplayName);
@@ -116,18 +159,15 @@ TSharedPtr<FJsonObject> UFRM_Library::GetActorLineFeaturesJSON(FVector PointOne,
 
 	// Coordinates array with X, Y, Z (longitude, latitude, altitude)
 	TArray<TSharedPtr<FJsonValue>> CoordinatesArray;
-	TArray<TSharedPtr<FJsonValue>> PointOneArray;
-	PointOneArray.Add(MakeShareable(new FJsonValueNumber(PointOne.X)));
-	PointOneArray.Add(MakeShareable(new FJsonValueNumber(PointOne.Y)));
-	PointOneArray.Add(MakeShareable(new FJsonValueNumber(PointOne.Z)));
-
-	TArray<TSharedPtr<FJsonValue>> PointTwoArray;
-	PointTwoArray.Add(MakeShareable(new FJsonValueNumber(PointTwo.X)));
-	PointTwoArray.Add(MakeShareable(new FJsonValueNumber(PointTwo.Y)));
-	PointTwoArray.Add(MakeShareable(new FJsonValueNumber(PointTwo.Z)));
-
-	CoordinatesArray.Add(MakeShareable(new FJsonValueArray(PointOneArray)));
-	CoordinatesArray.Add(MakeShareable(new FJsonValueArray(PointTwoArray)));
+	CoordinatesArray.Reserve(Points.Num());
+
+	for (const FVector& Point : Points) {
+		TArray<TSharedPtr<FJsonValue>> PointArray;
+		PointArray.Add(MakeShareable(new FJsonValueNumber(Point.X)));
+		PointArray.Add(MakeShareable(new FJsonValueNumber(Point.Y)));
+		PointArray.Add(MakeShareable(new FJsonValueNumber(Point.Z)));
+		CoordinatesArray.Add(MakeShareable(new FJsonValueArray(PointArray)));
+	}
 
 	TSharedRef<FJsonObject> JGeometry = MakeShareable(new FJsonObject());
 
@@ -170,6 +210,7 @@ bool UFRM_Library::IsIntInRange(int32 Number, int32 LowerBound, int32 UpperBound
 
 TMap<TSubclassOf<UFGItemDescriptor>, int32> UFRM_Library::GetGroupedInventoryItems(const UFGInventoryComponent* Inventory)
 {
+	FRM_AUDIT_TOUCH("UFGInventoryComponent");
 	TArray<FInventoryStack> InventoryStacks;
 
 	Inventory->GetInventoryStacks(InventoryStacks);
@@ -179,6 +220,7 @@ TMap<TSubclassOf<UFGItemDescriptor>, int32> UFRM_Library::GetGroupedInventoryIte
 
 void UFRM_Library::GetGroupedInventoryItems(const UFGInventoryComponent* Inventory, TMap<TSubclassOf<UFGItemDescriptor>, int32>& InventoryItems)
 {
+	FRM_AUDIT_TOUCH("UFGInventoryComponent");
 	TArray<FInventoryStack> InventoryStacks;
 
 	Inventory->GetInventoryStacks(InventoryStacks);
@@ -197,25 +239,71 @@ TMap<TSubclassOf<UFGItemDescriptor>, int32> UFRM_Library::GetGroupedInventoryIte
 
 void UFRM_Library::GetGroupedInventoryItems(const TArray<FInventoryStack>& InventoryStacks, TMap<TSubclassOf<UFGItemDescriptor>, int32>& InventoryItems)
 {
-	for (FInventoryStack Inventory : InventoryStacks) {
-		auto ItemClass = Inventory.Item.GetItemClass();
-		const auto Amount = Inventory.NumItems;
+	TArray<FFRMItemStack> Items;
+	GetGroupedInventoryItems(InventoryStacks, Items);
+
+	// one map operation per item instead of two per stack
+	const FFRMItemRegistry& Registry = FFRMItemRegistry::Get();
+	InventoryItems.Reserve(InventoryItems.Num() + Items.Num());
+	for (const FFRMItemStack& Item : Items) {
+		InventoryItems.FindOrAdd(Registry.GetItem(Item.ID)) += Item.Amount;
+	}
+}
 
-		if (InventoryItems.Contains(ItemClass)) {
-			InventoryItems.Add(ItemClass) = Amount + InventoryItems.FindRef(ItemClass);
+void UFRM_Library::GetGroupedInventoryItems(const UFGInventoryComponent* Inventory, TArray<FFRMItemStack>& InventoryItems)
+{
+	FRM_AUDIT_TOUCH("UFGInventoryComponent");
+	TArray<FInventoryStack> InventoryStacks;
+
+	Inventory->GetInventoryStacks(InventoryStacks);
+
+	GetGroupedInventoryItems(InventoryStacks, InventoryItems);
+}
+
+void UFRM_Library::GetGroupedInventoryItems(const TArray<FInventoryStack>& InventoryStacks, TArray<FFRMItemStack>& InventoryItems)
+{
+	// position + 1 of each item in InventoryItems, indexed by item ID and reused by every call on this thread
+	thread_local TArray<int32> Slots;
+
+	FFRMItemRegistry& Registry = FFRMItemRegistry::Get();
+
+	const auto FindSlot = [&Registry](const uint16 ID) -> int32& {
+		if (ID >= Slots.Num()) {
+			Slots.SetNumZeroed(FMath::Max<int32>(ID + 1, Registry.Num()));
+		}
+		return Slots[ID];
+	};
+
+	for (int32 Index = 0; Index < InventoryItems.Num(); Index++) {
+		FindSlot(InventoryItems[Index].ID) = Index + 1;
+	}
+
+	for (const FInventoryStack& Stack : InventoryStacks) {
+		const uint16 ID = Registry.GetID(Stack.Item.GetItemClass());
+		if (ID == FFRMItemRegistry::InvalidID) continue;
+
+		int32& Slot = FindSlot(ID);
+		if (Slot == 0) {
+			InventoryItems.Add({ID, Stack.NumItems});
+			Slot = InventoryItems.Num();
 		}
 		else {
-			InventoryItems.Add(ItemClass) = Amount;
+			InventoryItems[Slot - 1].Amount += Stack.NumItems;
 		}
 	}
+
+	// only the slots this call used are dirty
+	for (const FFRMItemStack& Item : InventoryItems) {
+		Slots[Item.ID] = 0;
+	}
 }
 
 TSharedPtr<FJsonObject> UFRM_Library::GetItemValueObject(const TSubclassOf<UFGItemDescriptor>& Item, const int Amount)
 {
 	TSharedPtr<FJsonObject> JItem = MakeShared<FJsonObject>();
 
-	JItem->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Item).ToString()));
-	JItem->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Item)));
+	JItem->Values.Add("Name", FFRMNameCache::Find(Item)->JDisplayName);
+	JItem->Values.Add("ClassName", FFRMNameCache::Find(Item)->JClassName);
 	JItem->Values.Add("Amount", MakeShared<FJsonValueNumber>(Amount));
 	JItem->Values.Add("MaxAmount", MakeShared<FJsonValueNumber>(UFGItemDescriptor::GetStackSize(Item)));
 
@@ -232,6 +320,19 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Library::GetInventoryJSON(const TArray<FItem
 
 	return JInventoryArray;
 }
+TArray<TSharedPtr<FJsonValue>> UFRM_Library::GetInventoryJSON(const TArray<FFRMItemStack>& Items)
+{
+	const FFRMItemRegistry& Registry = FFRMItemRegistry::Get();
+	TArray<TSharedPtr<FJsonValue>> JInventoryArray;
+	JInventoryArray.Reserve(Items.Num());
+
+	for (const FFRMItemStack& Item : Items) {
+		JInventoryArray.Add(MakeShared<FJsonValueObject>(GetItemValueObject(Registry.GetItem(Item.ID), Item.Amount)));
+	}
+
+	return JInventoryArray;
+}
+
 TArray<TSharedPtr<FJsonValue>> UFRM_Library::GetInventoryJSON(const TMap<TSubclassOf<UFGItemDescriptor>, int32>& Items)
 {
 	TArray<TSharedPtr<FJsonValue>> JInventoryArray;
@@ -243,8 +344,15 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Library::GetInventoryJSON(const TMap<TSubcla
 	return JInventoryArray;
 }
 
+UClass* UFRM_Library::LoadClassByPath(const TCHAR* Path)
+{
+	FRM_AUDIT_TOUCH("LoadObject");
+	return LoadObject<UClass>(nullptr, Path);
+}
+
 TSharedPtr<FJsonObject> UFRM_Library::CreateBaseJsonObject(const UObject* Actor)
 {
+	FRM_AUDIT_TOUCH("UObject");
 	TSharedPtr<FJsonObject> JObject = MakeShared<FJsonObject>();
 	JObject->Values.Add("ID", MakeShared<FJsonValueString>(Actor->GetName()));
 
@@ -253,6 +361,7 @@ TSharedPtr<FJsonObject> UFRM_Library::CreateBaseJsonObject(const UObject* Actor)
 
 TSharedPtr<FJsonObject> UFRM_Library::GetResourceNodeJSON(AActor* Actor, const bool bIncludeFeatures)
 {
+	FRM_AUDIT_TOUCH("AActor");
 	AFGResourceNode* ResourceNode = Cast<AFGResourceNode>(Actor);
 	if (!ResourceNode) {
 		return nullptr;
@@ -293,7 +402,7 @@ TSharedPtr<FJsonObject> UFRM_Library::GetResourceNodeJSON(AActor* Actor, const b
 	FString ResourceName = ResourceNode->GetResourceName().ToString();
 		
 	JResourceNode->Values.Add("Name", MakeShared<FJsonValueString>(ResourceName));
-	JResourceNode->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(ResourceNode->GetResourceClass())));
+	JResourceNode->Values.Add("ClassName", FFRMNameCache::Find(ResourceNode->GetResourceClass())->JClassName);
 	JResourceNode->Values.Add("Purity", MakeShared<FJsonValueString>(Purity));
 	JResourceNode->Values.Add("EnumPurity", MakeShared<FJsonValueString>(UEnum::GetValueAsString(ResourcePurity)));
 	JResourceNode->Values.Add("ResourceForm", MakeShared<FJsonValueString>(ResourceForm));
@@ -325,24 +434,31 @@ TSharedPtr<FJsonValue> ConvertStringToFJsonValue(const FString& JsonString)
 }
 
 TSharedPtr<FJsonObject> UFRM_Library::getPowerConsumptionJSON(UFGPowerInfoComponent* PowerInfo) {
-	TSharedPtr<FJsonObject> JCircuit = MakeShared<FJsonObject>();
-	int32 CircuitGroupID = -1;
-	int32 CircuitID = -1;
-	float PowerConsumed = 0;
-	float MaxPowerConsumed = 0;
+	return GetPowerInfoJSON(GetPowerInfoRow(PowerInfo));
+};
+
+FFRMPowerInfoRow UFRM_Library::GetPowerInfoRow(UFGPowerInfoComponent* PowerInfo) {
+	FRM_AUDIT_TOUCH("UFGPowerInfoComponent");
+	FFRMPowerInfoRow Row;
 
 	if (IsValid(PowerInfo)) {
 		UFGPowerCircuit* PowerCircuit = PowerInfo->GetPowerCircuit();
 		if (IsValid(PowerCircuit)) {
-			CircuitGroupID = PowerCircuit->GetCircuitGroupID();
-			CircuitID = PowerCircuit->GetCircuitID();
-			PowerConsumed = PowerInfo->GetActualConsumption();
-			MaxPowerConsumed = PowerInfo->GetMaximumTargetConsumption();
+			Row.CircuitGroupID = PowerCircuit->GetCircuitGroupID();
+			Row.CircuitID = PowerCircuit->GetCircuitID();
+			Row.PowerConsumed = PowerInfo->GetActualConsumption();
+			Row.MaxPowerConsumed = PowerInfo->GetMaximumTargetConsumption();
 		}
 	}
-	JCircuit->Values.Add("CircuitGroupID", MakeShared<FJsonValueNumber>(CircuitGroupID));
-	JCircuit->Values.Add("CircuitID", MakeShared<FJsonValueNumber>(CircuitID));
-	JCircuit->Values.Add("PowerConsumed", MakeShared<FJsonValueNumber>(PowerConsumed));
-	JCircuit->Values.Add("MaxPowerConsumed", MakeShared<FJsonValueNumber>(MaxPowerConsumed));
+
+	return Row;
+};
+
+TSharedPtr<FJsonObject> UFRM_Library::GetPowerInfoJSON(const FFRMPowerInfoRow& PowerInfo) {
+	TSharedPtr<FJsonObject> JCircuit = MakeShared<FJsonObject>();
+	JCircuit->Values.Add("CircuitGroupID", MakeShared<FJsonValueNumber>(PowerInfo.CircuitGroupID));
+	JCircuit->Values.Add("CircuitID", MakeShared<FJsonValueNumber>(PowerInfo.CircuitID));
+	JCircuit->Values.Add("PowerConsumed", MakeShared<FJsonValueNumber>(PowerInfo.PowerConsumed));
+	JCircuit->Values.Add("MaxPowerConsumed", MakeShared<FJsonValueNumber>(PowerInfo.MaxPowerConsumed));
 	return JCircuit;
 };
\ No newline at end of file
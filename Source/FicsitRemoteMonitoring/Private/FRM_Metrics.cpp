@@ -0,0 +1,332 @@
+#include "FRM_Metrics.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	constexpr int32 NumPhases = static_cast<int32>(EFRMRequestPhase::Count);
+
+	// upper bounds in seconds, the last bucket is +Inf
+	constexpr double BucketBounds[] = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5};
+	constexpr int32 NumBuckets = UE_ARRAY_COUNT(BucketBounds) + 1;
+
+	// frame times of 240, 120, 90, 60, 45, 30, 20 and 10 fps, then hitches
+	constexpr double FrameBucketBounds[] = {0.0042, 0.0083, 0.0111, 0.0167, 0.0222, 0.0333, 0.05, 0.1, 0.25, 1.0};
+	constexpr int32 NumFrameBuckets = UE_ARRAY_COUNT(FrameBucketBounds) + 1;
+
+	const TCHAR* PhaseNames[] = {TEXT("game_thread_wait"), TEXT("collect"), TEXT("serialize"), TEXT("send")};
+
+	const TCHAR* PriorityNames[] = {TEXT("interactive"), TEXT("normal"), TEXT("bulk")};
+
+	// only the owning thread writes a shard, so a relaxed load/store pair is enough and never locks the bus
+	template <typename T>
+	FORCEINLINE void Bump(std::atomic<T>& Counter, const T Amount)
+	{
+		Counter.store(Counter.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	FORCEINLINE T Read(const std::atomic<T>& Counter)
+	{
+		return Counter.load(std::memory_order_relaxed);
+	}
+}
+
+struct FFRMMetrics::FShard
+{
+	template <int32 N>
+	struct THistogram
+	{
+		std::atomic<uint64> Buckets[N];
+		std::atomic<uint64> Count;
+		std::atomic<uint64> SumNanos;
+	};
+
+	using FHistogram = THistogram<NumBuckets>;
+
+	std::atomic<uint64> Requests[MaxEndpoints];
+	std::atomic<uint64> ResponseBytes[MaxEndpoints];
+	std::atomic<uint64> Throttled[MaxEndpoints];
+	FHistogram Phases[MaxEndpoints][NumPhases];
+
+	std::atomic<uint64> UnmatchedRequests;
+	std::atomic<uint64> UnmatchedThrottled;
+	std::atomic<uint64> CacheHits;
+	std::atomic<uint64> CacheMisses;
+	std::atomic<uint64> StaticFileHits;
+	std::atomic<uint64> StaticFileBytes;
+	std::atomic<uint64> WebSocketMessages;
+	std::atomic<uint64> WebSocketBytes;
+	std::atomic<int64> BackpressureBytes;
+
+	THistogram<NumFrameBuckets> Frames;
+};
+
+FFRMMetrics& FFRMMetrics::Get()
+{
+	static FFRMMetrics Instance;
+	return Instance;
+}
+
+FFRMMetrics::FShard& FFRMMetrics::GetShard()
+{
+	// shards outlive their threads so counters stay monotonic
+	thread_local FShard* Shard = nullptr;
+
+	if (!Shard) {
+		Shard = new FShard();
+
+		FScopeLock Lock(&Mutex);
+		Shards.Add(Shard);
+	}
+
+	return *Shard;
+}
+
+int32 FFRMMetrics::RegisterEndpoint(const FString& APIName)
+{
+	FScopeLock Lock(&Mutex);
+
+	const int32 Existing = EndpointNames.IndexOfByKey(APIName);
+	if (Existing != INDEX_NONE) return Existing;
+
+	if (EndpointNames.Num() >= MaxEndpoints) return INDEX_NONE;
+
+	return EndpointNames.Add(APIName);
+}
+
+void FFRMMetrics::RecordRequest(const int32 EndpointIndex, const uint64 ResponseBytes)
+{
+	if (EndpointIndex < 0 || EndpointIndex >= MaxEndpoints) return;
+
+	FShard& Shard = GetShard();
+	Bump<uint64>(Shard.Requests[EndpointIndex], 1);
+	Bump<uint64>(Shard.ResponseBytes[EndpointIndex], ResponseBytes);
+}
+
+void FFRMMetrics::RecordPhase(const int32 EndpointIndex, const EFRMRequestPhase Phase, const double Seconds, FRequestTiming* Timing)
+{
+	if (Timing) Timing->Seconds[static_cast<int32>(Phase)] += Seconds;
+
+	if (EndpointIndex < 0 || EndpointIndex >= MaxEndpoints) return;
+
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && Seconds > BucketBounds[Bucket]) Bucket++;
+
+	FShard::FHistogram& Histogram = GetShard().Phases[EndpointIndex][static_cast<int32>(Phase)];
+	Bump<uint64>(Histogram.Buckets[Bucket], 1);
+	Bump<uint64>(Histogram.Count, 1);
+	Bump<uint64>(Histogram.SumNanos, static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1e9));
+}
+
+void FFRMMetrics::RecordUnmatchedRequest()
+{
+	Bump<uint64>(GetShard().UnmatchedRequests, 1);
+}
+
+void FFRMMetrics::RecordThrottled(const int32 EndpointIndex)
+{
+	FShard& Shard = GetShard();
+	Bump<uint64>(EndpointIndex >= 0 && EndpointIndex < MaxEndpoints ? Shard.Throttled[EndpointIndex] : Shard.UnmatchedThrottled, 1);
+}
+
+void FFRMMetrics::RecordCacheLookup(const bool bHit)
+{
+	FShard& Shard = GetShard();
+	Bump<uint64>(bHit ? Shard.CacheHits : Shard.CacheMisses, 1);
+}
+
+void FFRMMetrics::RecordStaticFile(const uint64 Bytes)
+{
+	FShard& Shard = GetShard();
+	Bump<uint64>(Shard.StaticFileHits, 1);
+	Bump<uint64>(Shard.StaticFileBytes, Bytes);
+}
+
+void FFRMMetrics::RecordWebSocketMessage(const uint64 Bytes)
+{
+	FShard& Shard = GetShard();
+	Bump<uint64>(Shard.WebSocketMessages, 1);
+	Bump<uint64>(Shard.WebSocketBytes, Bytes);
+}
+
+void FFRMMetrics::RecordBackpressure(const int64 DeltaBytes)
+{
+	if (DeltaBytes == 0) return;
+	Bump<int64>(GetShard().BackpressureBytes, DeltaBytes);
+}
+
+void FFRMMetrics::RecordFrame(const double Seconds)
+{
+	int32 Bucket = 0;
+	while (Bucket < NumFrameBuckets - 1 && Seconds > FrameBucketBounds[Bucket]) Bucket++;
+
+	auto& Histogram = GetShard().Frames;
+	Bump<uint64>(Histogram.Buckets[Bucket], 1);
+	Bump<uint64>(Histogram.Count, 1);
+	Bump<uint64>(Histogram.SumNanos, static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1e9));
+}
+
+FString FFRMMetrics::Scrape(const FFRMServerGauges& Gauges)
+{
+	TArray<FString> Names;
+	TArray<FShard*> CurrentShards;
+	{
+		FScopeLock Lock(&Mutex);
+		Names = EndpointNames;
+		CurrentShards = Shards;
+	}
+
+	const int32 NumEndpoints = Names.Num();
+
+	// merge all shards
+	TArray<uint64> Requests, ResponseBytes, Throttled;
+	Requests.SetNumZeroed(NumEndpoints);
+	ResponseBytes.SetNumZeroed(NumEndpoints);
+	Throttled.SetNumZeroed(NumEndpoints);
+
+	TArray<uint64> Buckets, Counts, Sums;
+	Buckets.SetNumZeroed(NumEndpoints * NumPhases * NumBuckets);
+	Counts.SetNumZeroed(NumEndpoints * NumPhases);
+	Sums.SetNumZeroed(NumEndpoints * NumPhases);
+
+	uint64 Unmatched = 0, UnmatchedThrottled = 0, CacheHits = 0, CacheMisses = 0, StaticHits = 0, StaticBytes = 0, WSMessages = 0, WSBytes = 0;
+	int64 Backpressure = 0;
+
+	uint64 FrameBuckets[NumFrameBuckets] = {};
+	uint64 FrameCount = 0, FrameSum = 0;
+
+	for (const FShard* Shard : CurrentShards) {
+		for (int32 Endpoint = 0; Endpoint < NumEndpoints; Endpoint++) {
+			Requests[Endpoint] += Read(Shard->Requests[Endpoint]);
+			ResponseBytes[Endpoint] += Read(Shard->ResponseBytes[Endpoint]);
+			Throttled[Endpoint] += Read(Shard->Throttled[Endpoint]);
+
+			for (int32 Phase = 0; Phase < NumPhases; Phase++) {
+				const FShard::FHistogram& Histogram = Shard->Phases[Endpoint][Phase];
+				const int32 Series = Endpoint * NumPhases + Phase;
+
+				Counts[Series] += Read(Histogram.Count);
+				Sums[Series] += Read(Histogram.SumNanos);
+				for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++) {
+					Buckets[Series * NumBuckets + Bucket] += Read(Histogram.Buckets[Bucket]);
+				}
+			}
+		}
+
+		Unmatched += Read(Shard->UnmatchedRequests);
+		UnmatchedThrottled += Read(Shard->UnmatchedThrottled);
+		CacheHits += Read(Shard->CacheHits);
+		CacheMisses += Read(Shard->CacheMisses);
+		StaticHits += Read(Shard->StaticFileHits);
+		StaticBytes += Read(Shard->StaticFileBytes);
+		WSMessages += Read(Shard->WebSocketMessages);
+		WSBytes += Read(Shard->WebSocketBytes);
+		Backpressure += Read(Shard->BackpressureBytes);
+
+		FrameCount += Read(Shard->Frames.Count);
+		FrameSum += Read(Shard->Frames.SumNanos);
+		for (int32 Bucket = 0; Bucket < NumFrameBuckets; Bucket++) {
+			FrameBuckets[Bucket] += Read(Shard->Frames.Buckets[Bucket]);
+		}
+	}
+
+	FString Out;
+	Out.Reserve(64 * 1024);
+
+	Out += TEXT("# TYPE frm_http_requests counter\n# HELP frm_http_requests API requests served per endpoint.\n");
+	for (int32 Endpoint = 0; Endpoint < NumEndpoints; Endpoint++) {
+		Out.Appendf(TEXT("frm_http_requests_total{endpoint=\"%s\"} %llu\n"), *Names[Endpoint], Requests[Endpoint]);
+	}
+	Out.Appendf(TEXT("frm_http_requests_total{endpoint=\"\"} %llu\n"), Unmatched);
+
+	Out += TEXT("# TYPE frm_http_response_bytes counter\n# HELP frm_http_response_bytes API response body bytes per endpoint.\n");
+	for (int32 Endpoint = 0; Endpoint < NumEndpoints; Endpoint++) {
+		Out.Appendf(TEXT("frm_http_response_bytes_total{endpoint=\"%s\"} %llu\n"), *Names[Endpoint], ResponseBytes[Endpoint]);
+	}
+
+	Out += TEXT("# TYPE frm_http_throttled_requests counter\n# HELP frm_http_throttled_requests API requests refused with 429 by the rate limiter per endpoint.\n");
+	for (int32 Endpoint = 0; Endpoint < NumEndpoints; Endpoint++) {
+		Out.Appendf(TEXT("frm_http_throttled_requests_total{endpoint=\"%s\"} %llu\n"), *Names[Endpoint], Throttled[Endpoint]);
+	}
+	Out.Appendf(TEXT("frm_http_throttled_requests_total{endpoint=\"\"} %llu\n"), UnmatchedThrottled);
+
+	Out += TEXT("# TYPE frm_request_phase_seconds histogram\n# HELP frm_request_phase_seconds Time spent per request phase.\n");
+	for (int32 Endpoint = 0; Endpoint < NumEndpoints; Endpoint++) {
+		for (int32 Phase = 0; Phase < NumPhases; Phase++) {
+			const int32 Series = Endpoint * NumPhases + Phase;
+			if (Counts[Series] == 0) continue;
+
+			uint64 Cumulative = 0;
+			for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++) {
+				Cumulative += Buckets[Series * NumBuckets + Bucket];
+				const FString Bound = Bucket < NumBuckets - 1 ? FString::SanitizeFloat(BucketBounds[Bucket]) : FString(TEXT("+Inf"));
+				Out.Appendf(TEXT("frm_request_phase_seconds_bucket{endpoint=\"%s\",phase=\"%s\",le=\"%s\"} %llu\n"), *Names[Endpoint], PhaseNames[Phase], *Bound, Cumulative);
+			}
+			Out.Appendf(TEXT("frm_request_phase_seconds_sum{endpoint=\"%s\",phase=\"%s\"} %.9f\n"), *Names[Endpoint], PhaseNames[Phase], Sums[Series] / 1e9);
+			Out.Appendf(TEXT("frm_request_phase_seconds_count{endpoint=\"%s\",phase=\"%s\"} %llu\n"), *Names[Endpoint], PhaseNames[Phase], Counts[Series]);
+		}
+	}
+
+	Out += TEXT("# TYPE frm_response_cache_lookups counter\n# HELP frm_response_cache_lookups Response cache lookups by result.\n");
+	Out.Appendf(TEXT("frm_response_cache_lookups_total{result=\"hit\"} %llu\n"), CacheHits);
+	Out.Appendf(TEXT("frm_response_cache_lookups_total{result=\"miss\"} %llu\n"), CacheMisses);
+
+	Out += TEXT("# TYPE frm_response_cache_hit_ratio gauge\n");
+	Out.Appendf(TEXT("frm_response_cache_hit_ratio %.4f\n"), CacheHits + CacheMisses > 0 ? static_cast<double>(CacheHits) / (CacheHits + CacheMisses) : 0.0);
+
+	Out += TEXT("# TYPE frm_static_file_requests counter\n# HELP frm_static_file_requests Files served from the web root.\n");
+	Out.Appendf(TEXT("frm_static_file_requests_total %llu\n"), StaticHits);
+	Out += TEXT("# TYPE frm_static_file_bytes counter\n");
+	Out.Appendf(TEXT("frm_static_file_bytes_total %llu\n"), StaticBytes);
+
+	Out += TEXT("# TYPE frm_websocket_clients gauge\n");
+	Out.Appendf(TEXT("frm_websocket_clients %d\n"), Gauges.WebSocketClients);
+	Out += TEXT("# TYPE frm_websocket_subscriptions gauge\n");
+	Out.Appendf(TEXT("frm_websocket_subscriptions %d\n"), Gauges.Subscriptions);
+	Out += TEXT("# TYPE frm_websocket_messages counter\n");
+	Out.Appendf(TEXT("frm_websocket_messages_total %llu\n"), WSMessages);
+	Out += TEXT("# TYPE frm_websocket_message_bytes counter\n");
+	Out.Appendf(TEXT("frm_websocket_message_bytes_total %llu\n"), WSBytes);
+	Out += TEXT("# TYPE frm_websocket_backpressure_bytes gauge\n# HELP frm_websocket_backpressure_bytes Bytes buffered for slow WebSocket clients.\n");
+	Out.Appendf(TEXT("frm_websocket_backpressure_bytes %lld\n"), FMath::Max<int64>(Backpressure, 0));
+
+	Out += TEXT("# TYPE frm_game_frame_seconds histogram\n# HELP frm_game_frame_seconds Game thread frame time.\n");
+	{
+		uint64 Cumulative = 0;
+		for (int32 Bucket = 0; Bucket < NumFrameBuckets; Bucket++) {
+			Cumulative += FrameBuckets[Bucket];
+			const FString Bound = Bucket < NumFrameBuckets - 1 ? FString::SanitizeFloat(FrameBucketBounds[Bucket]) : FString(TEXT("+Inf"));
+			Out.Appendf(TEXT("frm_game_frame_seconds_bucket{le=\"%s\"} %llu\n"), *Bound, Cumulative);
+		}
+		Out.Appendf(TEXT("frm_game_frame_seconds_sum %.9f\n"), FrameSum / 1e9);
+		Out.Appendf(TEXT("frm_game_frame_seconds_count %llu\n"), FrameCount);
+	}
+
+	Out += TEXT("# TYPE frm_governor_level gauge\n# HELP frm_governor_level Throttling level of the game thread governor, 0 while FRM is within its budget.\n");
+	Out.Appendf(TEXT("frm_governor_level %d\n"), Gauges.GovernorLevel);
+	Out += TEXT("# TYPE frm_governor_game_thread_seconds gauge\n# HELP frm_governor_game_thread_seconds Smoothed game thread time FRM uses per frame.\n");
+	Out.Appendf(TEXT("frm_governor_game_thread_seconds %.9f\n"), Gauges.GovernorCost);
+	Out += TEXT("# TYPE frm_governor_budget_seconds gauge\n");
+	Out.Appendf(TEXT("frm_governor_budget_seconds %.9f\n"), Gauges.GovernorBudget);
+
+	Out += TEXT("# TYPE frm_scheduler_queued_jobs gauge\n# HELP frm_scheduler_queued_jobs Endpoint calls waiting for the game thread by priority class.\n");
+	for (int32 Priority = 0; Priority < FMath::Min<int32>(Gauges.SchedulerQueued.Num(), UE_ARRAY_COUNT(PriorityNames)); Priority++) {
+		Out.Appendf(TEXT("frm_scheduler_queued_jobs{priority=\"%s\"} %d\n"), PriorityNames[Priority], Gauges.SchedulerQueued[Priority]);
+	}
+
+	Out += TEXT("# TYPE frm_endpoint_cost_estimate_seconds gauge\n# HELP frm_endpoint_cost_estimate_seconds Moving average of the collect time the scheduler ranks endpoints by.\n");
+	for (int32 Endpoint = 0; Endpoint < FMath::Min(NumEndpoints, Gauges.CostEstimates.Num()); Endpoint++) {
+		if (Gauges.CostEstimates[Endpoint] <= 0.0) continue;
+		Out.Appendf(TEXT("frm_endpoint_cost_estimate_seconds{endpoint=\"%s\"} %.9f\n"), *Names[Endpoint], Gauges.CostEstimates[Endpoint]);
+	}
+
+	Out += TEXT("# TYPE frm_rate_limited_clients gauge\n# HELP frm_rate_limited_clients Remote addresses the rate limiter currently keeps a bucket for.\n");
+	Out.Appendf(TEXT("frm_rate_limited_clients %d\n"), Gauges.RateLimitedClients);
+
+	Out += TEXT("# TYPE frm_server_loops gauge\n");
+	Out.Appendf(TEXT("frm_server_loops %d\n"), Gauges.ServerLoops);
+
+	Out += TEXT("# EOF\n");
+	return Out;
+}
@@ -0,0 +1,102 @@
+#include "FRM_NameCache.h"
+
+#include "Internationalization/Internationalization.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/ScopeRWLock.h"
+#include "Resources/FGItemDescriptor.h"
+#include "FRM_JsonWriter.h"
+
+namespace
+{
+	FString GetFormName(const EResourceForm Form)
+	{
+		switch (Form) {
+			case EResourceForm::RF_SOLID: return TEXT("Solid");
+			case EResourceForm::RF_LIQUID: return TEXT("Liquid");
+			case EResourceForm::RF_GAS: return TEXT("Gas");
+			case EResourceForm::RF_HEAT: return TEXT("Heat");
+			case EResourceForm::RF_INVALID: return TEXT("Invalid");
+			default: return TEXT("Unknown");
+		}
+	}
+}
+
+FFRMNameCache& FFRMNameCache::Get()
+{
+	static FFRMNameCache Instance;
+	return Instance;
+}
+
+FFRMNameCache::FFRMNameCache()
+{
+	// item names are localized
+	FInternationalization::Get().OnCultureChanged().AddRaw(this, &FFRMNameCache::Empty);
+}
+
+TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> FFRMNameCache::Find(const UClass* Class)
+{
+	FFRMNameCache& Cache = Get();
+	{
+		FReadScopeLock ReadLock(Cache.Lock);
+		if (const TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe>* Found = Cache.Names.Find(Class)) {
+			return *Found;
+		}
+	}
+
+	// resolved outside the lock, two threads racing for the same class produce equal entries
+	TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> Names = Resolve(Class);
+
+	FWriteScopeLock WriteLock(Cache.Lock);
+	if (const TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe>* Found = Cache.Names.Find(Class)) {
+		return *Found;
+	}
+
+	Cache.Names.Add(Class, Names);
+	Cache.Encoded.Add(Names->JDisplayName.Get(), &Names->DisplayNameJson);
+	Cache.Encoded.Add(Names->JClassName.Get(), &Names->ClassNameJson);
+	Cache.Encoded.Add(Names->JForm.Get(), &Names->FormJson);
+	return Names;
+}
+
+void FFRMNameCache::Empty()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Names.Empty();
+	Encoded.Empty();
+}
+
+bool FFRMNameCache::AppendEncoded(std::string& Out, const FJsonValue* Value)
+{
+	FFRMNameCache& Cache = Get();
+	FReadScopeLock ReadLock(Cache.Lock);
+
+	const std::string* const* Json = Cache.Encoded.Find(Value);
+	if (!Json) return false;
+
+	Out.append(**Json);
+	return true;
+}
+
+TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> FFRMNameCache::Resolve(const UClass* Class)
+{
+	const TSharedRef<FFRMClassNames, ESPMode::ThreadSafe> Names = MakeShared<FFRMClassNames, ESPMode::ThreadSafe>();
+
+	Names->ClassName = UKismetSystemLibrary::GetClassDisplayName(Class);
+	Names->DisplayName = Names->ClassName;
+
+	if (Class && Class->IsChildOf(UFGItemDescriptor::StaticClass())) {
+		const TSubclassOf<UFGItemDescriptor> Item = const_cast<UClass*>(Class);
+		Names->DisplayName = UFGItemDescriptor::GetItemName(Item).ToString();
+		Names->Form = GetFormName(UFGItemDescriptor::GetForm(Item));
+	}
+
+	Names->JDisplayName = MakeShared<FJsonValueString>(Names->DisplayName);
+	Names->JClassName = MakeShared<FJsonValueString>(Names->ClassName);
+	Names->JForm = MakeShared<FJsonValueString>(Names->Form);
+
+	FFRMJsonWriter::WriteString(Names->DisplayNameJson, Names->DisplayName);
+	FFRMJsonWriter::WriteString(Names->ClassNameJson, Names->ClassName);
+	FFRMJsonWriter::WriteString(Names->FormJson, Names->Form);
+
+	return Names;
+}
@@ -2,13 +2,19 @@
 
 #include "FRM_Player.h"
 #include <FicsitRemoteMonitoring.h>
+#include "FRM_NameCache.h"
+#include "FRM_ThreadAudit.h"
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Player::getPlayer(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getPlayer");
 
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JPlayerArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGCharacterPlayer::StaticClass(), FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), AFGCharacterPlayer::StaticClass(), FoundActors);
+	}
 	for (AActor* Player : FoundActors) {
 		TSharedPtr<FJsonObject> JPlayer = UFRM_Library::CreateBaseJsonObject(Player);
 
@@ -42,12 +48,16 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Player::getPlayer(UObject* WorldContext) {
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Player::getDoggo(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getDoggo");
 
-	UClass* DoggoClass = LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Character/Creature/Wildlife/SpaceRabbit/Char_SpaceRabbit.Char_SpaceRabbit_C"));
+	UClass* DoggoClass = UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Character/Creature/Wildlife/SpaceRabbit/Char_SpaceRabbit.Char_SpaceRabbit_C"));
 	TArray<AActor*> FoundActors;
 	TArray<TSharedPtr<FJsonValue>> JDoggoArray;
 
-	UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), DoggoClass, FoundActors);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetAllActorsOfClass");
+		UGameplayStatics::GetAllActorsOfClass(WorldContext->GetWorld(), DoggoClass, FoundActors);
+	}
 	for (AActor* Doggo : FoundActors) {
 		TSharedPtr<FJsonObject> JDoggo = UFRM_Library::CreateBaseJsonObject(Doggo);
 
@@ -62,7 +72,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Player::getDoggo(UObject* WorldContext) {
 		TMap<TSubclassOf<UFGItemDescriptor>, int32> DoggoInventory = UFRM_Library::GetGroupedInventoryItems(InventoryStacks);
 
 		JDoggo->Values.Add("Name", MakeShared<FJsonValueString>(DisplayName));
-		JDoggo->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Doggo->GetClass())));
+		JDoggo->Values.Add("ClassName", FFRMNameCache::Find(Doggo->GetClass())->JClassName);
 		JDoggo->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Doggo)));
 		JDoggo->Values.Add("Inventory", MakeShared<FJsonValueArray>(UFRM_Library::GetInventoryJSON(DoggoInventory)));
 		JDoggo->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::getActorFeaturesJSON(Doggo, DisplayName, TEXT("Lizard Doggo"))));
@@ -0,0 +1,163 @@
+#include "FRM_Polylines.h"
+
+#include "Components/SplineComponent.h"
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_ThreadAudit.h"
+
+namespace
+{
+	// 1 m between samples, enough for the tightest belt curve; long rails are capped
+	constexpr double SampleSpacing = 100.0;
+	constexpr int32 MaxSamples = 1024;
+
+	// Allowed deviation per level in world units, from a few centimeters up to 10 m for a zoomed out map
+	constexpr double LodTolerance[FFRMPolylineCache::NumLods] = {5.0, 50.0, 200.0, 1000.0};
+}
+
+void FFRMPolylineCache::Start(UWorld* World)
+{
+	Stop();
+	if (!World) return;
+
+	BoundWorld = World;
+	DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FFRMPolylineCache::OnActorDestroyed));
+}
+
+void FFRMPolylineCache::Stop()
+{
+	if (UWorld* World = BoundWorld.Get()) {
+		World->RemoveOnActorDestroyedHandler(DestroyedHandle);
+	}
+
+	BoundWorld.Reset();
+	DestroyedHandle.Reset();
+
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Empty();
+}
+
+bool FFRMPolylineCache::Get(const AActor* Actor, const int32 Lod, TArray<FVector>& OutPoints)
+{
+	if (!Actor) return false;
+
+	Prepare(Actor);
+	return Find(FObjectKey(Actor), Lod, OutPoints);
+}
+
+void FFRMPolylineCache::Prepare(const AActor* Actor)
+{
+	if (!Actor) return;
+
+	const FObjectKey Key(Actor);
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (Entries.Contains(Key)) return;
+	}
+
+	FRM_TRACE_SCOPE("FRM::PolylineCache::Build");
+	FRM_AUDIT_TOUCH("USplineComponent");
+
+	// conveyor lifts have no spline, remember that so they are not searched again on every snapshot
+	FEntry Entry;
+	TArray<FVector> Samples;
+	if (Sample(Actor, Samples)) {
+		for (int32 Level = 0; Level < NumLods; Level++) {
+			Simplify(Samples, LodTolerance[Level], Entry.Lods[Level]);
+		}
+	}
+
+	// two requests may build the same segment at once, both results are identical
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Add(Key, MoveTemp(Entry));
+}
+
+bool FFRMPolylineCache::Find(const FObjectKey& Key, const int32 Lod, TArray<FVector>& OutPoints) const
+{
+	if (Lod < 0 || Lod >= NumLods) return false;
+
+	FReadScopeLock ReadLock(Lock);
+	const FEntry* Entry = Entries.Find(Key);
+	if (!Entry || Entry->Lods[Lod].IsEmpty()) return false;
+
+	OutPoints = Entry->Lods[Lod];
+	return true;
+}
+
+int32 FFRMPolylineCache::ParseLod(const TMap<FString, FString>& QueryParams, FString& OutError)
+{
+	const FString* LodParam = QueryParams.Find("lod");
+	if (!LodParam) return INDEX_NONE;
+
+	const int32 Lod = LodParam->IsNumeric() ? FCString::Atoi(**LodParam) : INDEX_NONE;
+	if (Lod < 0 || Lod >= NumLods) {
+		OutError = FString::Printf(TEXT("lod expects a level from 0 to %d."), NumLods - 1);
+		return INDEX_NONE;
+	}
+
+	return Lod;
+}
+
+void FFRMPolylineCache::Simplify(const TArray<FVector>& Points, const double Tolerance, TArray<FVector>& OutPoints)
+{
+	OutPoints.Reset();
+	if (Points.Num() <= 2) {
+		OutPoints = Points;
+		return;
+	}
+
+	TBitArray<> Keep(false, Points.Num());
+	Keep[0] = true;
+	Keep[Points.Num() - 1] = true;
+
+	// iterative, a 1000 point rail would otherwise recurse that deep on a straight run
+	TArray<TPair<int32, int32>> Stack;
+	Stack.Emplace(0, Points.Num() - 1);
+
+	while (!Stack.IsEmpty()) {
+		const TPair<int32, int32> Range = Stack.Pop(false);
+
+		double MaxDistance = 0.0;
+		int32 Farthest = INDEX_NONE;
+		for (int32 Index = Range.Key + 1; Index < Range.Value; Index++) {
+			const double Distance = FMath::PointDistToSegment(Points[Index], Points[Range.Key], Points[Range.Value]);
+			if (Distance > MaxDistance) {
+				MaxDistance = Distance;
+				Farthest = Index;
+			}
+		}
+
+		if (Farthest == INDEX_NONE || MaxDistance <= Tolerance) continue;
+
+		Keep[Farthest] = true;
+		Stack.Emplace(Range.Key, Farthest);
+		Stack.Emplace(Farthest, Range.Value);
+	}
+
+	for (TConstSetBitIterator<> It(Keep); It; ++It) {
+		OutPoints.Add(Points[It.GetIndex()]);
+	}
+}
+
+bool FFRMPolylineCache::Sample(const AActor* Actor, TArray<FVector>& OutPoints)
+{
+	const USplineComponent* Spline = Actor->FindComponentByClass<USplineComponent>();
+	if (!Spline) return false;
+
+	const float Length = Spline->GetSplineLength();
+	const int32 Steps = FMath::Clamp(FMath::CeilToInt32(Length / SampleSpacing), 1, MaxSamples);
+
+	OutPoints.Reset(Steps + 1);
+	for (int32 Step = 0; Step <= Steps; Step++) {
+		OutPoints.Add(Spline->GetLocationAtDistanceAlongSpline(Length * Step / Steps, ESplineCoordinateSpace::World));
+	}
+	return true;
+}
+
+void FFRMPolylineCache::OnActorDestroyed(AActor* Actor)
+{
+	if (!Actor) return;
+
+	FWriteScopeLock WriteLock(Lock);
+	Entries.Remove(FObjectKey(Actor));
+}
@@ -4,13 +4,17 @@
 
 #include "FGBuildablePriorityPowerSwitch.h"
 #include "FicsitRemoteMonitoring.h"
+#include "FRM_NameCache.h"
 #include "FRM_Request.h"
 #include "FRM_RequestData.h"
+#include "FRM_ThreadAudit.h"
 
 #undef GetForm
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Power::getPower(UObject* WorldContext)
 {
+	FRM_TRACE_SCOPE("FRM::getPower");
+	FRM_AUDIT_TOUCH("AFGCircuitSubsystem::Get");
 	AFGCircuitSubsystem* CircuitSubsystem = AFGCircuitSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<TSharedPtr<FJsonValue>> JCircuitArray;
@@ -50,12 +54,104 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getPower(UObject* WorldContext)
 	return JCircuitArray;
 };
 
+void UFRM_Power::GetCircuitSample(UObject* WorldContext, TArray<TPair<FString, float>>& OutSample)
+{
+	FRM_AUDIT_TOUCH("AFGCircuitSubsystem::Get");
+	AFGCircuitSubsystem* CircuitSubsystem = AFGCircuitSubsystem::Get(WorldContext->GetWorld());
+	if (!CircuitSubsystem) return;
+
+	for (UFGCircuitGroup* CircuitGroup : CircuitSubsystem->mCircuitGroups) {
+		const UFGPowerCircuitGroup* PowerGroup = Cast<UFGPowerCircuitGroup>(CircuitGroup);
+		if (!PowerGroup || PowerGroup->mCircuits.IsEmpty()) continue;
+
+		const FString Prefix = FString::Printf(TEXT("power.%d."), PowerGroup->mCircuits[0]->GetCircuitGroupID());
+		OutSample.Emplace(Prefix + TEXT("production"), PowerGroup->mBaseProduction);
+		OutSample.Emplace(Prefix + TEXT("consumption"), PowerGroup->mConsumption);
+		OutSample.Emplace(Prefix + TEXT("capacity"), PowerGroup->mMaximumProductionCapacity);
+		OutSample.Emplace(Prefix + TEXT("battery"), UFRM_Library::SafeDivide_Float(PowerGroup->mTotalPowerStore, PowerGroup->mTotalPowerStoreCapacity) * 100);
+	}
+}
+
+TArray<TSharedPtr<FJsonValue>> UFRM_Power::getPowerGraph(UObject* WorldContext, FFRMPowerGraph& Graph)
+{
+	FRM_TRACE_SCOPE("FRM::getPowerGraph");
+
+	Graph.Update(WorldContext->GetWorld());
+
+	FRM_AUDIT_TOUCH("AFGCircuitSubsystem::Get");
+	AFGCircuitSubsystem* CircuitSubsystem = AFGCircuitSubsystem::Get(WorldContext->GetWorld());
+
+	// the topology is cached, the numbers are always read live
+	TArray<TSharedPtr<FJsonValue>> JNodes;
+	for (const FFRMPowerGraphNode& Node : Graph.GetNodes()) {
+		TSharedPtr<FJsonObject> JNode = MakeShared<FJsonObject>();
+		JNode->Values.Add("CircuitID", MakeShared<FJsonValueNumber>(Node.CircuitID));
+
+		if (UFGPowerCircuit* PowerCircuit = CircuitSubsystem ? CircuitSubsystem->FindPowerCircuit(Node.CircuitID) : nullptr) {
+			FPowerCircuitStats Stats;
+			PowerCircuit->GetStats(Stats);
+
+			JNode->Values.Add("CircuitGroupID", MakeShared<FJsonValueNumber>(PowerCircuit->GetCircuitGroupID()));
+			JNode->Values.Add("PowerProduction", MakeShared<FJsonValueNumber>(Stats.PowerProduced));
+			JNode->Values.Add("PowerConsumed", MakeShared<FJsonValueNumber>(Stats.PowerConsumed));
+			JNode->Values.Add("PowerCapacity", MakeShared<FJsonValueNumber>(Stats.PowerProductionCapacity));
+			JNode->Values.Add("PowerMaxConsumed", MakeShared<FJsonValueNumber>(Stats.MaximumPowerConsumption));
+			JNode->Values.Add("BatteryInput", MakeShared<FJsonValueNumber>(PowerCircuit->mBatterySumPowerInput));
+			JNode->Values.Add("BatteryOutput", MakeShared<FJsonValueNumber>(PowerCircuit->GetBatterySumPowerOutput()));
+			JNode->Values.Add("FuseTriggered", MakeShared<FJsonValueBoolean>(PowerCircuit->IsFuseTriggered()));
+		}
+
+		JNode->Values.Add("Wires", MakeShared<FJsonValueNumber>(Node.Wires));
+		JNode->Values.Add("WireLength", MakeShared<FJsonValueNumber>(Node.WireLength));
+
+		JNodes.Add(MakeShared<FJsonValueObject>(JNode));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> JEdges;
+	for (const FFRMPowerGraphEdge& Edge : Graph.GetEdges()) {
+		AFGBuildableCircuitSwitch* PowerSwitch = Edge.Switch.Get();
+		if (!IsValid(PowerSwitch)) continue;
+
+		int32 Priority = -1;
+		FString Type = TEXT("Power Switch");
+		if (const auto* PriorityPowerSwitch = Cast<AFGBuildablePriorityPowerSwitch>(PowerSwitch)) {
+			Type = TEXT("Priority Power Switch");
+			Priority = PriorityPowerSwitch->GetPriority();
+		}
+
+		TSharedPtr<FJsonObject> JEdge = MakeShared<FJsonObject>();
+		JEdge->Values.Add("ID", MakeShared<FJsonValueString>(PowerSwitch->GetName()));
+		JEdge->Values.Add("Name", MakeShared<FJsonValueString>(PowerSwitch->GetBuildingTag_Implementation()));
+		JEdge->Values.Add("Type", MakeShared<FJsonValueString>(Type));
+		JEdge->Values.Add("From", MakeShared<FJsonValueNumber>(Edge.From));
+		JEdge->Values.Add("To", MakeShared<FJsonValueNumber>(Edge.To));
+		JEdge->Values.Add("IsOn", MakeShared<FJsonValueBoolean>(PowerSwitch->IsSwitchOn()));
+		JEdge->Values.Add("Priority", MakeShared<FJsonValueNumber>(Priority));
+
+		JEdges.Add(MakeShared<FJsonValueObject>(JEdge));
+	}
+
+	TSharedPtr<FJsonObject> JGraph = MakeShared<FJsonObject>();
+	JGraph->Values.Add("Version", MakeShared<FJsonValueNumber>(Graph.GetVersion()));
+	JGraph->Values.Add("Nodes", MakeShared<FJsonValueArray>(JNodes));
+	JGraph->Values.Add("Edges", MakeShared<FJsonValueArray>(JEdges));
+
+	TArray<TSharedPtr<FJsonValue>> JGraphArray;
+	JGraphArray.Add(MakeShared<FJsonValueObject>(JGraph));
+	return JGraphArray;
+}
+
 TArray<TSharedPtr<FJsonValue>> UFRM_Power::getSwitches(UObject* WorldContext)
 {
+	FRM_TRACE_SCOPE("FRM::getSwitches");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableCircuitSwitch*> PowerSwitches;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableCircuitSwitch>(PowerSwitches);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableCircuitSwitch>(PowerSwitches);
+	}
 
 	TArray<TSharedPtr<FJsonValue>> JSwitchesArray;
 
@@ -76,7 +172,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getSwitches(UObject* WorldContext)
 
 		FString Name = PowerSwitch->GetBuildingTag_Implementation();
 		JSwitches->Values.Add("Name", MakeShared<FJsonValueString>(Name));
-		JSwitches->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(PowerSwitch->GetClass())));
+		JSwitches->Values.Add("ClassName", FFRMNameCache::Find(PowerSwitch->GetClass())->JClassName);
 		JSwitches->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(PowerSwitch)));
 		JSwitches->Values.Add("SwitchTag", MakeShared<FJsonValueString>(PowerSwitch->GetBuildingTag_Implementation()));
 		JSwitches->Values.Add("Connected0", MakeShared<FJsonValueNumber>(ConnectionZero->IsConnected()));
@@ -94,92 +190,151 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getSwitches(UObject* WorldContext)
 	return JSwitchesArray;
 }
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Power::setSwitches(UObject* WorldContext, FRequestData RequestData)
+TArray<TSharedPtr<FJsonValue>> UFRM_Power::setSwitches(UObject* WorldContext, FRequestData RequestData, FFRMPowerGraph& Graph)
 {
+	FRM_TRACE_SCOPE("FRM::setSwitches");
 	TArray<TSharedPtr<FJsonValue>> JResponses;
 	if (RequestData.Body.Num() == 0) return JResponses;
 
-	const AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildableCircuitSwitch*> PowerSwitches;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableCircuitSwitch>(PowerSwitches);
+	// ?atomic=true applies the commands only if every one of them is valid
+	const FString* AtomicParam = RequestData.QueryParams.Find("atomic");
+	const bool bAtomic = AtomicParam && (*AtomicParam == "true" || *AtomicParam == "1");
+
+	Graph.Update(WorldContext->GetWorld());
+
+	struct FSwitchCommand
+	{
+		AFGBuildableCircuitSwitch* Switch = nullptr;
+		FString SwitchID;
+		TOptional<FString> Name;
+		TOptional<bool> bStatus;
+		int32 Priority = -1;
+	};
+
+	// resolve and validate every command first, the response keeps the order of the body
+	TArray<FSwitchCommand> Commands;
+	TArray<TSharedPtr<FJsonObject>> Results;
+	bool bAllValid = true;
+
+	const auto AddError = [&Commands, &Results, &bAllValid](const FString& Message, const FString& SwitchID) {
+		const TSharedPtr<FJsonObject> JResponse = UFRM_RequestLibrary::GenerateError(Message);
+		JResponse->Values.Add("ID", MakeShared<FJsonValueString>(SwitchID));
+		Commands.AddDefaulted();
+		Results.Add(JResponse);
+		bAllValid = false;
+	};
 
 	for (const auto& BodyObject : RequestData.Body)
 	{
-		auto JsonObject = BodyObject->AsObject();
+		const TSharedPtr<FJsonObject>* JsonObjectPtr;
+		if (!BodyObject.IsValid() || !BodyObject->TryGetObject(JsonObjectPtr))
+		{
+			AddError("Expected a JSON object.", FString());
+			continue;
+		}
+		const TSharedPtr<FJsonObject>& JsonObject = *JsonObjectPtr;
 
 		// get switch id from json object
 		FString SwitchID;
-		if (UFRM_RequestLibrary::TryGetStringField(JsonObject, "ID", SwitchID, JResponses)) continue;
+		TArray<TSharedPtr<FJsonValue>> FieldErrors;
+		if (const TSharedPtr<FJsonObject> JError = UFRM_RequestLibrary::TryGetStringField(JsonObject, "ID", SwitchID, FieldErrors))
+		{
+			Commands.AddDefaulted();
+			Results.Add(JError);
+			bAllValid = false;
+			continue;
+		}
 
 		// check if priority, status or name is present in this json object
 		if (!JsonObject->HasField("priority") && !JsonObject->HasField("status") && !JsonObject->HasField("name"))
 		{
-			const TSharedPtr<FJsonObject> JResponse = UFRM_RequestLibrary::GenerateError("Missing field priority, name or status.");
-			JResponse->Values.Add("ID", MakeShared<FJsonValueString>(SwitchID));
-			JResponses.Add(MakeShared<FJsonValueObject>(JResponse));
+			AddError("Missing field priority, name or status.", SwitchID);
 			continue;
 		}
 
-		// get updatable fields
-		int32 Priority = -1;
+		AFGBuildableCircuitSwitch* PowerSwitch = Graph.FindSwitch(SwitchID);
+		if (!PowerSwitch)
+		{
+			AddError("Power Switch not found.", SwitchID);
+			continue;
+		}
+
+		FSwitchCommand Command;
+		Command.Switch = PowerSwitch;
+		Command.SwitchID = SwitchID;
+
 		FString Name;
+		if (JsonObject->TryGetStringField("name", Name)) Command.Name = Name;
+
 		bool bStatus;
-		JsonObject->TryGetBoolField("status", bStatus);
-		JsonObject->TryGetNumberField("priority", Priority);
-		JsonObject->TryGetStringField("name", Name);
+		if (JsonObject->TryGetBoolField("status", bStatus)) Command.bStatus = bStatus;
 
-		bool bSuccess = false;
-		for (AFGBuildableCircuitSwitch* PowerSwitch : PowerSwitches)
+		JsonObject->TryGetNumberField("priority", Command.Priority);
+
+		// a priority alone has nothing left to apply on a regular switch
+		if (Command.Priority >= 0 && !PowerSwitch->IsA<AFGBuildablePriorityPowerSwitch>())
 		{
-			if (PowerSwitch->GetName() == SwitchID)
+			if (!Command.Name.IsSet() && !Command.bStatus.IsSet())
 			{
-				TSharedPtr<FJsonObject> JResponse = MakeShared<FJsonObject>();
-				JResponse->Values.Add("ID", MakeShared<FJsonValueString>(SwitchID));
-
-				// change name
-				if (JsonObject->HasField("name"))
-				{
-					PowerSwitch->SetBuildingTag_Implementation(Name);
-					PowerSwitch->SetHasBuildingTag_Implementation(Name.Len() > 0);
-					JResponse->Values.Add("Status", MakeShared<FJsonValueString>(PowerSwitch->GetBuildingTag_Implementation()));
-					bSuccess = true;
-				}
-				
-				// toggle switch
-				if (JsonObject->HasField("status"))
-				{
-					PowerSwitch->SetSwitchOn(bStatus);
-					JResponse->Values.Add("Status", MakeShared<FJsonValueBoolean>(PowerSwitch->IsSwitchOn()));
-					bSuccess = true;
-				}
+				AddError("This Switch is not a Priority Power Switch.", SwitchID);
+				continue;
+			}
+			Command.Priority = -1;
+		}
 
-				// update priority
-				if (JsonObject->HasField("priority") && Priority >= 0)
-				{
-					if (auto* PriorityPowerSwitch = Cast<AFGBuildablePriorityPowerSwitch>(PowerSwitch))
-					{
-						PriorityPowerSwitch->SetPriority(Priority);
-						JResponse->Values.Add("Priority", MakeShared<FJsonValueNumber>(PriorityPowerSwitch->GetPriority()));
-						bSuccess = true;
-					}
-					else if (!bSuccess)
-					{
-						JResponse = UFRM_RequestLibrary::GenerateError("This Switch is not a Priority Power Switch.");
-					}
-				}
+		Commands.Add(Command);
+		Results.Add(nullptr);
+	}
 
-				if (bSuccess) JResponses.Add(MakeShared<FJsonValueObject>(JResponse));
+	// apply everything in one pass, nothing is applied in atomic mode once a single command failed
+	for (int32 i = 0; i < Commands.Num(); i++)
+	{
+		const FSwitchCommand& Command = Commands[i];
+		if (!Command.Switch) continue;
 
-				break;
-			}
+		if (bAtomic && !bAllValid)
+		{
+			Results[i] = UFRM_RequestLibrary::GenerateError("Not applied, another command failed.");
+			Results[i]->Values.Add("ID", MakeShared<FJsonValueString>(Command.SwitchID));
+			continue;
 		}
 
-		if (!bSuccess)
+		const TSharedPtr<FJsonObject> JResponse = MakeShared<FJsonObject>();
+		JResponse->Values.Add("ID", MakeShared<FJsonValueString>(Command.SwitchID));
+
+		// change name
+		if (Command.Name.IsSet())
+		{
+			Command.Switch->SetBuildingTag_Implementation(Command.Name.GetValue());
+			Command.Switch->SetHasBuildingTag_Implementation(Command.Name->Len() > 0);
+			JResponse->Values.Add("Name", MakeShared<FJsonValueString>(Command.Switch->GetBuildingTag_Implementation()));
+
+			// older clients read the new name from Status, a toggle in the same command still replaces it as before
+			JResponse->Values.Add("Status", JResponse->Values["Name"]);
+		}
+
+		// toggle switch
+		if (Command.bStatus.IsSet())
 		{
-			const TSharedPtr<FJsonObject> JResponse = UFRM_RequestLibrary::GenerateError("Power Switch not found.");
-			JResponse->Values.Add("ID", MakeShared<FJsonValueString>(SwitchID));
-			JResponses.Add(MakeShared<FJsonValueObject>(JResponse));
+			Command.Switch->SetSwitchOn(Command.bStatus.GetValue());
+			JResponse->Values.Add("Status", MakeShared<FJsonValueBoolean>(Command.Switch->IsSwitchOn()));
 		}
+
+		// update priority
+		if (Command.Priority >= 0)
+		{
+			AFGBuildablePriorityPowerSwitch* PriorityPowerSwitch = CastChecked<AFGBuildablePriorityPowerSwitch>(Command.Switch);
+			PriorityPowerSwitch->SetPriority(Command.Priority);
+			JResponse->Values.Add("Priority", MakeShared<FJsonValueNumber>(PriorityPowerSwitch->GetPriority()));
+		}
+
+		Results[i] = JResponse;
+	}
+
+	JResponses.Reserve(Results.Num());
+	for (const TSharedPtr<FJsonObject>& Result : Results)
+	{
+		JResponses.Add(MakeShared<FJsonValueObject>(Result));
 	}
 
 	return JResponses;
@@ -187,10 +342,15 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::setSwitches(UObject* WorldContext, FR
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Power::getGenerators(UObject* WorldContext, UClass* TypedBuildable)
 {
+	FRM_TRACE_SCOPE("FRM::getGenerators");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildable*> Buildables;
-	BuildableSubsystem->GetTypedBuildable(TypedBuildable, Buildables);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable(TypedBuildable, Buildables);
+	}
 
 	TArray<TSharedPtr<FJsonValue>> JGeneratorArray;
 
@@ -221,8 +381,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getGenerators(UObject* WorldContext,
 		if (IsValid(GeneratorFuel)) {
 			TSubclassOf<UFGItemDescriptor> Supplemental = GeneratorFuel->GetSupplementalResourceClass();
 
-			JSupplemental->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Supplemental).ToString()));
-			JSupplemental->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Supplemental.Get())));
+			JSupplemental->Values.Add("Name", FFRMNameCache::Find(Supplemental)->JDisplayName);
+			JSupplemental->Values.Add("ClassName", FFRMNameCache::Find(Supplemental.Get())->JClassName);
 			JSupplemental->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(GeneratorFuel->GetSupplementalConsumptionRateCurrent() * 60));
 			JSupplemental->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(GeneratorFuel->GetSupplementalConsumptionRateCurrent() * 60));
 			JSupplemental->Values.Add("PercentFull", MakeShared<FJsonValueNumber>(GeneratorFuel->GetSupplementalAmount() * 100));
@@ -238,8 +398,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getGenerators(UObject* WorldContext,
 
 					auto EnergyValue = UFGInventoryLibrary::GetAmountConvertedByForm(UFGItemDescriptor::GetEnergyValue(FuelClass), UFGItemDescriptor::GetForm(FuelClass));
 
-					JFuel->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(FuelClass).ToString()));
-					JFuel->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(FuelClass.Get())));
+					JFuel->Values.Add("Name", FFRMNameCache::Find(FuelClass)->JDisplayName);
+					JFuel->Values.Add("ClassName", FFRMNameCache::Find(FuelClass.Get())->JClassName);
 					JFuel->Values.Add("Amount", MakeShared<FJsonValueNumber>(EnergyValue));
 
 					JFuelArray.Add(MakeShared<FJsonValueObject>(JFuel));
@@ -329,26 +489,34 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Power::getGenerators(UObject* WorldContext,
 	return JGeneratorArray;
 };
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Power::getPowerUsage(UObject* WorldContext)
+TArray<TSharedPtr<FJsonValue>> UFRM_Power::getPowerUsage(UObject* WorldContext, FFRMTimeSlicer& TimeSlicer)
 {
-
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildableFactory*> BuildableFactories;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableFactory>(BuildableFactories);
+	FRM_TRACE_SCOPE("FRM::getPowerUsage");
 
 	TArray<TSharedPtr<FJsonValue>> JUsageArray;
 
-	for (AFGBuildableFactory* BuildableFactory : BuildableFactories)
-	{
+	// every powered buildable of the world, converted a few hundred per frame
+	TimeSlicer.Collect([WorldContext](TArray<UObject*>& OutObjects) {
+		FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
+		AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
+		TArray<AFGBuildableFactory*> BuildableFactories;
+		{
+			FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+			BuildableSubsystem->GetTypedBuildable<AFGBuildableFactory>(BuildableFactories);
+		}
+		OutObjects.Append(BuildableFactories);
+	}, [](UObject* Object) -> TSharedPtr<FJsonValue> {
+		AFGBuildableFactory* BuildableFactory = Cast<AFGBuildableFactory>(Object);
+		if (!BuildableFactory) { return nullptr; }
+
 		TSharedPtr<FJsonObject> JUsage = MakeShared<FJsonObject>();
 
 		JUsage->Values.Add("Name", MakeShared<FJsonValueString>(BuildableFactory->mDisplayName.ToString()));
 		JUsage->Values.Add("ClassName", MakeShared<FJsonValueString>(BuildableFactory->GetClass()->GetName()));
 		JUsage->Values.Add("PowerInfo", MakeShared<FJsonValueObject>(UFRM_Library::getPowerConsumptionJSON(BuildableFactory->GetPowerInfo())));
 
-		JUsageArray.Add(MakeShared<FJsonValueObject>(JUsage));		
-	}
+		return MakeShared<FJsonValueObject>(JUsage);
+	}, JUsageArray);
 
 	return JUsageArray;
-	
 }
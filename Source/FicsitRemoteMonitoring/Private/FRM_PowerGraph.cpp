@@ -0,0 +1,113 @@
+#include "FRM_PowerGraph.h"
+
+#include "FGBuildableSubsystem.h"
+#include "FGCircuitConnectionComponent.h"
+#include "FGCircuitSubsystem.h"
+#include "Buildables/FGBuildableWire.h"
+#include "Patching/NativeHookManager.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+std::atomic<uint64> FFRMPowerGraph::LastChangeFrame = 0;
+
+void FFRMPowerGraph::InstallHooks()
+{
+	static bool bInstalled = false;
+	if (bInstalled) return;
+	bInstalled = true;
+
+	#if !WITH_EDITOR
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGCircuitSubsystem, AddComponent, [](AFGCircuitSubsystem* Self, UFGCircuitConnectionComponent* Component) {
+		NotifyTopologyChanged();
+	});
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGCircuitSubsystem, RemoveComponent, [](AFGCircuitSubsystem* Self, UFGCircuitConnectionComponent* Component) {
+		NotifyTopologyChanged();
+	});
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGCircuitSubsystem, ConnectComponents, [](AFGCircuitSubsystem* Self, UFGCircuitConnectionComponent* First, UFGCircuitConnectionComponent* Second) {
+		NotifyTopologyChanged();
+	});
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGCircuitSubsystem, DisconnectComponents, [](AFGCircuitSubsystem* Self, UFGCircuitConnectionComponent* First, UFGCircuitConnectionComponent* Second) {
+		NotifyTopologyChanged();
+	});
+
+	#endif
+}
+
+void FFRMPowerGraph::NotifyTopologyChanged()
+{
+	LastChangeFrame = GFrameCounter;
+}
+
+void FFRMPowerGraph::Update(UWorld* World)
+{
+	// the circuits are rebuilt during the tick following a change, anything built before that is stale
+	if (Version != 0 && BuiltFrame > LastChangeFrame + 1) return;
+
+	FRM_TRACE_SCOPE("FRM::PowerGraph::Rebuild");
+
+	Nodes.Reset();
+	Edges.Reset();
+	EdgeIndex.Reset();
+	BuiltFrame = GFrameCounter;
+	Version++;
+
+	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(World);
+	if (!BuildableSubsystem) return;
+
+	TMap<int32, int32> NodeIndex;
+	const auto GetNode = [this, &NodeIndex](const int32 CircuitID) -> FFRMPowerGraphNode& {
+		if (const int32* Found = NodeIndex.Find(CircuitID)) return Nodes[*Found];
+
+		FFRMPowerGraphNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.CircuitID = CircuitID;
+		NodeIndex.Add(CircuitID, Nodes.Num() - 1);
+		return Node;
+	};
+
+	TArray<AFGBuildableWire*> Wires;
+	BuildableSubsystem->GetTypedBuildable<AFGBuildableWire>(Wires);
+
+	for (const AFGBuildableWire* Wire : Wires) {
+		const UFGCircuitConnectionComponent* Connection = IsValid(Wire) ? Wire->GetConnection(0) : nullptr;
+		if (!Connection || Connection->GetCircuitID() == INDEX_NONE) continue;
+
+		FFRMPowerGraphNode& Node = GetNode(Connection->GetCircuitID());
+		Node.Wires++;
+		Node.WireLength += Wire->GetLength();
+	}
+
+	TArray<AFGBuildableCircuitSwitch*> Switches;
+	BuildableSubsystem->GetTypedBuildable<AFGBuildableCircuitSwitch>(Switches);
+
+	for (AFGBuildableCircuitSwitch* Switch : Switches) {
+		const UFGCircuitConnectionComponent* ConnectionZero = Switch->GetConnection0();
+		const UFGCircuitConnectionComponent* ConnectionOne = Switch->GetConnection1();
+		if (!ConnectionZero || !ConnectionOne) continue;
+
+		EdgeIndex.Add(Switch->GetFName(), Edges.Num());
+
+		FFRMPowerGraphEdge& Edge = Edges.AddDefaulted_GetRef();
+		Edge.Switch = Switch;
+		Edge.From = ConnectionZero->GetCircuitID();
+		Edge.To = ConnectionOne->GetCircuitID();
+
+		// an unconnected side has no circuit and no node
+		if (Edge.From != INDEX_NONE) GetNode(Edge.From);
+		if (Edge.To != INDEX_NONE) GetNode(Edge.To);
+	}
+
+	Nodes.Sort([](const FFRMPowerGraphNode& A, const FFRMPowerGraphNode& B) { return A.CircuitID < B.CircuitID; });
+}
+
+AFGBuildableCircuitSwitch* FFRMPowerGraph::FindSwitch(const FString& ID) const
+{
+	// FNAME_Find never adds client supplied strings to the name table
+	const FName Name(*ID, FNAME_Find);
+	if (Name.IsNone()) return nullptr;
+
+	const int32* Index = EdgeIndex.Find(Name);
+	return Index ? Edges[*Index].Switch.Get() : nullptr;
+}
@@ -2,185 +2,46 @@
 #include <FicsitRemoteMonitoring.h>
 
 #include "FGPowerShardDescriptor.h"
+#include "FRM_NameCache.h"
+#include "FRM_ThreadAudit.h"
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Production::getProdStats(UObject* WorldContext) {
-
-	TMap<TSubclassOf<UFGItemDescriptor>, float> CurrentConsumed;
-	TMap<TSubclassOf<UFGItemDescriptor>, float> CurrentProduced;
-	TMap<TSubclassOf<UFGItemDescriptor>, float> TotalConsumed;
-	TMap<TSubclassOf<UFGItemDescriptor>, float> TotalProduced;
-
-	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
-	TArray<AFGBuildableManufacturer*> Buildables;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableManufacturer>(Buildables);
-
-	// Factory Building Production Stats
-	for (AFGBuildableManufacturer* Manufacturer : Buildables) {
-
-		if (IsValid(Manufacturer->GetCurrentRecipe())) {
-			auto CurrentRecipe = Manufacturer->GetCurrentRecipe();
-			auto ProdCycle = UKismetMathLibrary::SafeDivide(60, Manufacturer->GetProductionCycleTimeForRecipe(Manufacturer->GetCurrentRecipe()));
-			auto CurrentPotential = Manufacturer->GetCurrentPotential();
-			auto Productivity = Manufacturer->GetProductivity();
-			auto ProductionBoost = Manufacturer->mProductionShardBoostMultiplier;
-			
-			for (FItemAmount Product : CurrentRecipe.GetDefaultObject()->GetProducts()) {
-
-				auto ItemClass = Product.ItemClass;
-				auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Product.Amount, UFGItemDescriptor::GetForm(Product.ItemClass));
-		
-				auto CurrentProd = RecipeAmount * ProdCycle * Productivity * CurrentPotential * ProductionBoost;
-				auto MaxProd = RecipeAmount * ProdCycle * CurrentPotential * ProductionBoost;
-								
-				if (CurrentProduced.Contains(ItemClass)) {
-					CurrentProduced.Add(ItemClass) = CurrentProd + CurrentProduced.FindRef(ItemClass);
-					TotalProduced.Add(ItemClass) = MaxProd + TotalProduced.FindRef(ItemClass);
-				}
-				else {
-					CurrentProduced.Add(ItemClass) = CurrentProd;
-					TotalProduced.Add(ItemClass) = MaxProd;
-				};
-
-			};
-
-			for (FItemAmount Ingredients : CurrentRecipe.GetDefaultObject()->GetIngredients()) {
-
-				auto ItemClass = Ingredients.ItemClass;
-				auto RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Ingredients.Amount, UFGItemDescriptor::GetForm(Ingredients.ItemClass));
-				auto CurrentCons = RecipeAmount * ProdCycle * Productivity * CurrentPotential;
-				auto MaxConsumed = RecipeAmount * ProdCycle * CurrentPotential;
-
-				if (CurrentConsumed.Contains(ItemClass)) {
-					CurrentConsumed.Add(ItemClass) = CurrentCons + CurrentConsumed.FindRef(ItemClass);
-					TotalConsumed.Add(ItemClass) = MaxConsumed + TotalConsumed.FindRef(ItemClass);
-				}
-				else {
-					CurrentConsumed.Add(ItemClass) = CurrentCons;
-					TotalConsumed.Add(ItemClass) = MaxConsumed;
-				};
-			};
-
-		};
-	};
+TArray<TSharedPtr<FJsonValue>> UFRM_Production::getProdStats(UObject* WorldContext, FFRMProductionTracker& Tracker) {
+	FRM_TRACE_SCOPE("FRM::getProdStats");
 
-	TArray<AFGBuildableResourceExtractor*> ExtractorBuildables;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceExtractor>(ExtractorBuildables);
-	// Resource Building Production Stats
-	for (AFGBuildableResourceExtractor* Extractor : ExtractorBuildables) {
-
-		TScriptInterface<IFGExtractableResourceInterface> ResourceClass = Extractor->GetExtractableResource();
-		if (ResourceClass != nullptr) {
-			TSubclassOf<UFGResourceDescriptor> ItemClass = ResourceClass->GetResourceClass();
-			float ProdCycle = Extractor->GetExtractionPerMinute();;
-			float Productivity = Extractor->GetProductivity();
-
-			auto CurrentProd = ProdCycle * Productivity;
-
-			if (CurrentProduced.Contains(ItemClass)) {
-				CurrentProduced.Add(ItemClass) = CurrentProd + CurrentProduced.FindRef(ItemClass);
-				TotalProduced.Add(ItemClass) = ProdCycle + TotalProduced.FindRef(ItemClass);
-			}
-			else {
-				CurrentProduced.Add(ItemClass) = CurrentProd;
-				TotalProduced.Add(ItemClass) = ProdCycle;
-			};
-		}
-	};
+	TArray<FFRMItemRates> ItemRates;
+	Tracker.GetRates(ItemRates);
 
-	TArray<AFGBuildableGeneratorFuel*> GeneratorBuildables;
-	BuildableSubsystem->GetTypedBuildable< AFGBuildableGeneratorFuel>(GeneratorBuildables);
-	// Power Generator Building Production Stats
-	for (AFGBuildableGeneratorFuel* Generator : GeneratorBuildables) {
-
-		TSubclassOf<UFGItemDescriptor> FuelItemClass = Generator->GetCurrentFuelClass();
-		float EnergyValue = UFGInventoryLibrary::GetAmountConvertedByForm(UFGItemDescriptor::GetEnergyValue(FuelItemClass), UFGItemDescriptor::GetForm(FuelItemClass));
-		float ProductionCapacity = Generator->GetCurrentPotential();
-		float Productivity = Generator->GetProductivity();
-		
-		float MaxFuelConsumption = 60 * (UFRM_Library::SafeDivide_Float(ProductionCapacity, EnergyValue));
-		float FuelConsumption = MaxFuelConsumption * Productivity;
-
-		if (CurrentProduced.Contains(FuelItemClass)) {
-			CurrentConsumed.Add(FuelItemClass) = FuelConsumption + CurrentConsumed.FindRef(FuelItemClass);
-			TotalConsumed.Add(FuelItemClass) = MaxFuelConsumption + TotalConsumed.FindRef(FuelItemClass);
-		}
-		else {
-			CurrentConsumed.Add(FuelItemClass) = FuelConsumption;
-			TotalConsumed.Add(FuelItemClass) = MaxFuelConsumption;
-		};
-
-		if (Generator->GetRequiresSupplementalResource()) {
-
-			TSubclassOf<UFGItemDescriptor> SupplementalItemClass = Generator->GetSupplementalResourceClass();
-			float Consumption = Generator->GetSupplementalConsumptionRateCurrent() * 60;
-			float MaxConsumption = Generator->GetSupplementalConsumptionRateMaximum() * 60;
-
-			if (CurrentProduced.Contains(SupplementalItemClass)) {
-				CurrentConsumed.Add(SupplementalItemClass) = Consumption + CurrentConsumed.FindRef(SupplementalItemClass);
-				TotalConsumed.Add(SupplementalItemClass) = MaxConsumption + TotalConsumed.FindRef(SupplementalItemClass);
-			}
-			else {
-				CurrentConsumed.Add(SupplementalItemClass) = Consumption;
-				TotalConsumed.Add(SupplementalItemClass) = MaxConsumption;
-			};
-		};
-	};
-
-	TArray<TSubclassOf<UFGItemDescriptor>> ClassNames;
-	UFGBlueprintFunctionLibrary::GetAllDescriptorsSorted(WorldContext->GetWorld(), ClassNames);
 	TArray<TSharedPtr<FJsonValue>> JProductionStatsArray;
 
-	for (TSubclassOf<UFGItemDescriptor> ClassName : ClassNames) {
-
-		if (TotalConsumed.Contains(ClassName) || TotalProduced.Contains(ClassName)) {
-			TSharedPtr<FJsonObject> JProductionStats = MakeShared<FJsonObject>();
-
-			float Consumption = CurrentConsumed.FindRef(ClassName);
-			float MaxConsumption = TotalConsumed.FindRef(ClassName);
-			float Produced = CurrentProduced.FindRef(ClassName);
-			float MaxProduced = TotalProduced.FindRef(ClassName);
-
-			EResourceForm Form = UFGItemDescriptor::GetForm(ClassName);
-
-			FString FormString = "Unknown";
-			if (Form == EResourceForm::RF_SOLID) {
-				FormString = "Solid";
-			}
-			else if (Form == EResourceForm::RF_LIQUID) {
-				FormString = "Liquid";
-			}
-			else if (Form == EResourceForm::RF_GAS) {
-				FormString = "Gas";
-			}
-			else if (Form == EResourceForm::RF_HEAT) {
-				FormString = "Heat";
-			}
-			else if (Form == EResourceForm::RF_INVALID) {
-				FormString = "Invalid";
-			}
-			else if (Form == EResourceForm::RF_LAST_ENUM) {
-				FormString = "Unknown";
-			};
-
-			FString ProdPerMin = "P: ";
-			ProdPerMin.Append(FString::SanitizeFloat(UFGBlueprintFunctionLibrary::RoundFloatWithPrecision(Produced, 2)));
-			ProdPerMin.Append("/ min - C: ");
-			ProdPerMin.Append(FString::SanitizeFloat(UFGBlueprintFunctionLibrary::RoundFloatWithPrecision(Consumption, 2)));
-			ProdPerMin.Append("/ min");
-
-			JProductionStats->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(ClassName).ToString()));
-			JProductionStats->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(ClassName.Get())));
-			JProductionStats->Values.Add("ProdPerMin", MakeShared<FJsonValueString>(ProdPerMin));
-			JProductionStats->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>((100 * (UFRM_Library::SafeDivide_Float(Produced, MaxProduced)))));
-			JProductionStats->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>((100 * (UFRM_Library::SafeDivide_Float(Consumption, MaxConsumption)))));
-			JProductionStats->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(Produced));
-			JProductionStats->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(MaxProduced));
-			JProductionStats->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(Consumption));
-			JProductionStats->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(MaxConsumption));
-			JProductionStats->Values.Add("Type", MakeShared<FJsonValueString>(FormString));
-
-			JProductionStatsArray.Add(MakeShared<FJsonValueObject>(JProductionStats));
-		};
+	for (const FFRMItemRates& Rates : ItemRates) {
+		TSharedPtr<FJsonObject> JProductionStats = MakeShared<FJsonObject>();
+
+		const TSubclassOf<UFGItemDescriptor> ClassName = Rates.Item;
+		float Consumption = Rates.CurrentConsumed;
+		float MaxConsumption = Rates.MaxConsumed;
+		float Produced = Rates.CurrentProduced;
+		float MaxProduced = Rates.MaxProduced;
+
+		const TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> Names = FFRMNameCache::Find(ClassName);
+
+		FString ProdPerMin = "P: ";
+		ProdPerMin.Append(FString::SanitizeFloat(UFGBlueprintFunctionLibrary::RoundFloatWithPrecision(Produced, 2)));
+		ProdPerMin.Append("/ min - C: ");
+		ProdPerMin.Append(FString::SanitizeFloat(UFGBlueprintFunctionLibrary::RoundFloatWithPrecision(Consumption, 2)));
+		ProdPerMin.Append("/ min");
+
+		JProductionStats->Values.Add("Name", Names->JDisplayName);
+		JProductionStats->Values.Add("ClassName", Names->JClassName);
+		JProductionStats->Values.Add("ProdPerMin", MakeShared<FJsonValueString>(ProdPerMin));
+		JProductionStats->Values.Add("ProdPercent", MakeShared<FJsonValueNumber>((100 * (UFRM_Library::SafeDivide_Float(Produced, MaxProduced)))));
+		JProductionStats->Values.Add("ConsPercent", MakeShared<FJsonValueNumber>((100 * (UFRM_Library::SafeDivide_Float(Consumption, MaxConsumption)))));
+		JProductionStats->Values.Add("CurrentProd", MakeShared<FJsonValueNumber>(Produced));
+		JProductionStats->Values.Add("MaxProd", MakeShared<FJsonValueNumber>(MaxProduced));
+		JProductionStats->Values.Add("CurrentConsumed", MakeShared<FJsonValueNumber>(Consumption));
+		JProductionStats->Values.Add("MaxConsumed", MakeShared<FJsonValueNumber>(MaxConsumption));
+		JProductionStats->Values.Add("Type", Names->JForm);
+
+		JProductionStatsArray.Add(MakeShared<FJsonValueObject>(JProductionStats));
 	};
 
 	return JProductionStatsArray;
@@ -188,6 +49,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getProdStats(UObject* WorldConte
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Production::getSinkList(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getSinkList");
+	FRM_AUDIT_TOUCH("UDataTable");
 
 	TArray<FResourceSinkPointsData*> SinkRows;
 	UDataTable* SinkTable = UFGResourceSinkSettings::GetPointsDataTable();
@@ -206,8 +69,8 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getSinkList(UObject* WorldContex
 			continue;
 		}
 
-		JSinkRow->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(SinkRow->ItemClass).ToString()));
-		JSinkRow->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(SinkRow->ItemClass->GetClass())));
+		JSinkRow->Values.Add("Name", FFRMNameCache::Find(SinkRow->ItemClass)->JDisplayName);
+		JSinkRow->Values.Add("ClassName", FFRMNameCache::Find(SinkRow->ItemClass->GetClass())->JClassName);
 		JSinkRow->Values.Add("Points", MakeShared<FJsonValueNumber>(SinkPoints));
 		JSinkRow->Values.Add("PointsOverride", MakeShared<FJsonValueNumber>(SinkOverridden));
 
@@ -218,11 +81,13 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getSinkList(UObject* WorldContex
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Production::getResourceSink(UObject* WorldContext, EResourceSinkTrack ResourceSinkTrack) {
+	FRM_TRACE_SCOPE("FRM::getResourceSink");
 
 	TArray<TSharedPtr<FJsonValue>> JResourceSinkArray;
 	TSharedPtr<FJsonObject> JResourceSink = MakeShared<FJsonObject>();
 	FString SinkName;
 
+	FRM_AUDIT_TOUCH("AFGResourceSinkSubsystem::Get");
 	AFGResourceSinkSubsystem* ResourceSinkSubsystem = AFGResourceSinkSubsystem::Get(WorldContext);
 
 	switch (ResourceSinkTrack) {
@@ -239,11 +104,11 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getResourceSink(UObject* WorldCo
 		PointHistory.Add(MakeShared<FJsonValueNumber>(PointGraph));
 	}
 
-	JCoupon->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(CouponClass).ToString()));
-	JCoupon->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(CouponClass)));
+	JCoupon->Values.Add("Name", FFRMNameCache::Find(CouponClass)->JDisplayName);
+	JCoupon->Values.Add("ClassName", FFRMNameCache::Find(CouponClass)->JClassName);
 
 	JResourceSink->Values.Add("Name", MakeShared<FJsonValueString>(SinkName));
-	JResourceSink->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(ResourceSinkSubsystem->GetClass())));
+	JResourceSink->Values.Add("ClassName", FFRMNameCache::Find(ResourceSinkSubsystem->GetClass())->JClassName);
 	JResourceSink->Values.Add("CouponType", MakeShared<FJsonValueObject>(JCoupon));
 	JResourceSink->Values.Add("NumCoupon", MakeShared<FJsonValueNumber>(ResourceSinkSubsystem->GetNumCoupons()));
 	JResourceSink->Values.Add("Percent", MakeShared<FJsonValueNumber>(ResourceSinkSubsystem->GetProgressionTowardsNextCoupon(ResourceSinkTrack)));
@@ -298,8 +163,8 @@ TSharedPtr<FJsonObject> UFRM_Production::getRecipe(UObject* WorldContext, TSubcl
 		auto ManualRate = (UKismetMathLibrary::SafeDivide(60, ManualDuration)) * RecipeAmount;
 		auto FactoryRate = (UKismetMathLibrary::SafeDivide(60, FactoryDuration)) * RecipeAmount;
 
-		JIngredient->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Ingredient.ItemClass).ToString()));
-		JIngredient->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Ingredient.ItemClass)));
+		JIngredient->Values.Add("Name", FFRMNameCache::Find(Ingredient.ItemClass)->JDisplayName);
+		JIngredient->Values.Add("ClassName", FFRMNameCache::Find(Ingredient.ItemClass)->JClassName);
 		JIngredient->Values.Add("Amount", MakeShared<FJsonValueNumber>(RecipeAmount));
 		JIngredient->Values.Add("ManualRate", MakeShared<FJsonValueNumber>(ManualRate));
 		JIngredient->Values.Add("FactoryRate", MakeShared<FJsonValueNumber>(FactoryRate));
@@ -316,8 +181,8 @@ TSharedPtr<FJsonObject> UFRM_Production::getRecipe(UObject* WorldContext, TSubcl
 		double ManualRate = (UKismetMathLibrary::SafeDivide(60, ManualDuration)) * RecipeAmount;
 		double FactoryRate = (UKismetMathLibrary::SafeDivide(60, FactoryDuration)) * RecipeAmount;
 
-		JProduct->Values.Add("Name", MakeShared<FJsonValueString>(UFGItemDescriptor::GetItemName(Product.ItemClass).ToString()));
-		JProduct->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Product.ItemClass)));
+		JProduct->Values.Add("Name", FFRMNameCache::Find(Product.ItemClass)->JDisplayName);
+		JProduct->Values.Add("ClassName", FFRMNameCache::Find(Product.ItemClass)->JClassName);
 		JProduct->Values.Add("Amount", MakeShared<FJsonValueNumber>(RecipeAmount));
 		JProduct->Values.Add("ManualRate", MakeShared<FJsonValueNumber>(ManualRate));
 		JProduct->Values.Add("FactoryRate", MakeShared<FJsonValueNumber>(FactoryRate));
@@ -337,8 +202,6 @@ TSharedPtr<FJsonObject> UFRM_Production::getRecipe(UObject* WorldContext, TSubcl
 
 	ModSubsystem->RecipeNames_BIE(Recipe, DisplayName, ClassName, CategoryName);
 
-	UE_LOG(LogFRMAPI, Warning, TEXT("Recipe: %s - Class: %s - Category Name: %s"), *FString(DisplayName), *FString(ClassName), *FString(CategoryName));
-
 	JRecipe->Values.Add("Name", MakeShared<FJsonValueString>(DisplayName));
 	JRecipe->Values.Add("ClassName", MakeShared<FJsonValueString>(ClassName));
 	JRecipe->Values.Add("Category", MakeShared<FJsonValueString>((CategoryName)));
@@ -353,7 +216,9 @@ TSharedPtr<FJsonObject> UFRM_Production::getRecipe(UObject* WorldContext, TSubcl
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Production::getRecipes(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getRecipes");
 
+	FRM_AUDIT_TOUCH("AFGSchematicManager::Get");
 	AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(WorldContext->GetWorld());
 
 	TArray<TSharedPtr<FJsonValue>> JRecipeArray;
@@ -391,7 +256,9 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getRecipes(UObject* WorldContext
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Production::getSchematics(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getSchematics");
 
+	FRM_AUDIT_TOUCH("AFGSchematicManager::Get");
 	AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(WorldContext->GetWorld());
 
 	TArray<TSharedPtr<FJsonValue>> JSchematicsArray;
@@ -451,7 +318,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Production::getSchematics(UObject* WorldCont
 		}
 
 		JSchematic->Values.Add("Name", MakeShared<FJsonValueString>(UFGSchematic::GetSchematicDisplayName(Schematic).ToString()));
-		JSchematic->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Schematic)));
+		JSchematic->Values.Add("ClassName", FFRMNameCache::Find(Schematic)->JClassName);
 		JSchematic->Values.Add("TechTier", MakeShared<FJsonValueNumber>(UFGSchematic::GetTechTier(Schematic)));
 		JSchematic->Values.Add("Type", MakeShared<FJsonValueString>(SchematicType));
 		JSchematic->Values.Add("Recipes", MakeShared<FJsonValueArray>(JRecipeArray));
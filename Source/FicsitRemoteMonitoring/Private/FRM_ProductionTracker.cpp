@@ -0,0 +1,369 @@
+#include "FRM_ProductionTracker.h"
+
+#include "FGBuildableSubsystem.h"
+#include "FGInventoryLibrary.h"
+#include "Algo/BinarySearch.h"
+#include "Buildables/FGBuildableManufacturer.h"
+#include "Buildables/FGBuildableResourceExtractor.h"
+#include "Buildables/FGBuildableGeneratorFuel.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Patching/NativeHookManager.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Library.h"
+#include "FRM_ThreadAudit.h"
+
+namespace
+{
+	// productivity is a rolling average that moves every tick, rates are only recomputed once it moved a whole percent
+	int32 GetProductivityBucket(const float Productivity)
+	{
+		return FMath::RoundToInt32(Productivity * 100.0f);
+	}
+
+	// buildings whose productivity and fuel are checked per refresh, a large factory is covered every few seconds
+	constexpr int32 MaxChecksPerRefresh = 1000;
+}
+
+FCriticalSection FFRMProductionTracker::ChangesLock;
+TSet<TObjectKey<AFGBuildable>> FFRMProductionTracker::Changes;
+
+void FFRMProductionTracker::InstallHooks()
+{
+	static bool bInstalled = false;
+	if (bInstalled) return;
+	bInstalled = true;
+
+	#if !WITH_EDITOR
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGBuildableManufacturer, SetRecipe, [](AFGBuildableManufacturer* Self, TSubclassOf<UFGRecipe> Recipe) {
+		NotifyChanged(Self);
+	});
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGBuildableFactory, SetPendingPotential, [](AFGBuildableFactory* Self, float Potential) {
+		NotifyChanged(Self);
+	});
+
+	SUBSCRIBE_UOBJECT_METHOD_AFTER(AFGBuildableFactory, SetPendingProductionBoost, [](AFGBuildableFactory* Self, float ProductionBoost) {
+		NotifyChanged(Self);
+	});
+
+	#endif
+}
+
+void FFRMProductionTracker::NotifyChanged(const AFGBuildable* Buildable)
+{
+	FScopeLock ScopeLock(&ChangesLock);
+	Changes.Add(Buildable);
+}
+
+void FFRMProductionTracker::Start(UWorld* World)
+{
+	Stop();
+	if (!World) return;
+
+	BoundWorld = World;
+	SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FFRMProductionTracker::Track));
+	DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FFRMProductionTracker::OnActorDestroyed));
+
+	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(World);
+	if (!BuildableSubsystem) return;
+
+	FRM_TRACE_SCOPE("FRM::ProductionTracker::Start");
+
+	TArray<AFGBuildableManufacturer*> Manufacturers;
+	BuildableSubsystem->GetTypedBuildable<AFGBuildableManufacturer>(Manufacturers);
+	for (AFGBuildableManufacturer* Manufacturer : Manufacturers) Track(Manufacturer);
+
+	TArray<AFGBuildableResourceExtractor*> Extractors;
+	BuildableSubsystem->GetTypedBuildable<AFGBuildableResourceExtractor>(Extractors);
+	for (AFGBuildableResourceExtractor* Extractor : Extractors) Track(Extractor);
+
+	TArray<AFGBuildableGeneratorFuel*> Generators;
+	BuildableSubsystem->GetTypedBuildable<AFGBuildableGeneratorFuel>(Generators);
+	for (AFGBuildableGeneratorFuel* Generator : Generators) Track(Generator);
+}
+
+void FFRMProductionTracker::Stop()
+{
+	if (UWorld* World = BoundWorld.Get()) {
+		World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(DestroyedHandle);
+	}
+
+	BoundWorld.Reset();
+	SpawnedHandle.Reset();
+	DestroyedHandle.Reset();
+
+	Reset();
+}
+
+void FFRMProductionTracker::GetRates(TArray<FFRMItemRates>& OutRates, const double MaxAge)
+{
+	FRM_AUDIT_CACHE("FFRMProductionTracker");
+	FScopeLock ScopeLock(&Lock);
+
+	const double Now = FPlatformTime::Seconds();
+	if (!bRefreshed || Now - LastRefresh >= MaxAge)
+	{
+		Refresh();
+		LastRefresh = Now;
+		bRefreshed = true;
+	}
+
+	OutRates.Reset(SortedItems.Num());
+
+	for (const int32 Item : SortedItems)
+	{
+		if (References[Item] == 0) continue;
+
+		FFRMItemRates& Rates = OutRates.AddDefaulted_GetRef();
+		Rates.Item = Items[Item];
+
+		// the totals are kept by adding and subtracting, hide what is left of values that went back to zero
+		const auto Clean = [](const double Value) { return FMath::Abs(Value) < 1e-4 ? 0.0f : static_cast<float>(Value); };
+		Rates.CurrentProduced = Clean(CurrentProduced[Item]);
+		Rates.MaxProduced = Clean(MaxProduced[Item]);
+		Rates.CurrentConsumed = Clean(CurrentConsumed[Item]);
+		Rates.MaxConsumed = Clean(MaxConsumed[Item]);
+	}
+}
+
+void FFRMProductionTracker::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	Buildings.Empty();
+	Tracked.Empty();
+	Settling.Empty();
+	Cursor = 0;
+	bRefreshed = false;
+
+	ItemIndex.Empty();
+	Items.Empty();
+	ItemNames.Empty();
+	SortedItems.Empty();
+	References.Empty();
+	CurrentProduced.Empty();
+	MaxProduced.Empty();
+	CurrentConsumed.Empty();
+	MaxConsumed.Empty();
+}
+
+void FFRMProductionTracker::Track(AActor* Actor)
+{
+	if (!Actor || !(Actor->IsA<AFGBuildableManufacturer>() || Actor->IsA<AFGBuildableResourceExtractor>() || Actor->IsA<AFGBuildableGeneratorFuel>())) return;
+
+	AFGBuildable* Buildable = CastChecked<AFGBuildable>(Actor);
+
+	FScopeLock ScopeLock(&Lock);
+	if (Buildings.Contains(Buildable)) return;
+
+	// a building that was just spawned gets its recipe afterwards, it is computed on the next refresh
+	Buildings.Add(Buildable);
+	Tracked.Add(Buildable);
+	Settling.Add(Buildable);
+}
+
+void FFRMProductionTracker::OnActorDestroyed(AActor* Actor)
+{
+	const AFGBuildable* Buildable = Cast<AFGBuildable>(Actor);
+	if (!Buildable) return;
+
+	FScopeLock ScopeLock(&Lock);
+
+	// the entry in Tracked goes stale and is dropped when the round robin reaches it
+	FBuilding Building;
+	if (Buildings.RemoveAndCopyValue(Buildable, Building)) {
+		Apply(Building.Rates, -1.0);
+		Settling.Remove(Buildable);
+	}
+}
+
+template<typename FComputeRates>
+void FFRMProductionTracker::Update(const AFGBuildable* Buildable, const uint32 Signature, FComputeRates&& Compute)
+{
+	FBuilding* Building = Buildings.Find(Buildable);
+	if (!Building || (Building->bComputed && Building->Signature == Signature)) return;
+
+	Apply(Building->Rates, -1.0);
+	Building->Rates.Reset();
+	Building->Signature = Signature;
+	Building->bComputed = true;
+
+	Compute(Building->Rates);
+	Apply(Building->Rates, 1.0);
+}
+
+void FFRMProductionTracker::Refresh()
+{
+	FRM_TRACE_SCOPE("FRM::ProductionTracker::Refresh");
+
+	{
+		FScopeLock ScopeLock(&ChangesLock);
+		for (const TObjectKey<AFGBuildable>& Key : Changes) {
+			if (Buildings.Contains(Key)) Settling.Add(Key);
+		}
+		Changes.Reset();
+	}
+
+	// changed buildings are checked on every refresh until their new potential took effect
+	for (auto It = Settling.CreateIterator(); It; ++It) {
+		AFGBuildable* Buildable = It->ResolveObjectPtr();
+		if (!IsValid(Buildable) || Check(Buildable)) {
+			It.RemoveCurrent();
+		}
+	}
+
+	const int32 Checks = FMath::Min(Tracked.Num(), MaxChecksPerRefresh);
+	for (int32 Checked = 0; Checked < Checks && Tracked.Num() > 0; Checked++) {
+		if (Cursor >= Tracked.Num()) Cursor = 0;
+
+		AFGBuildable* Buildable = Tracked[Cursor].Get();
+		if (!IsValid(Buildable) || !Buildings.Contains(Buildable)) {
+			Tracked.RemoveAtSwap(Cursor, 1, false);
+			continue;
+		}
+
+		Check(Buildable);
+		Cursor++;
+	}
+}
+
+bool FFRMProductionTracker::Check(AFGBuildable* Buildable)
+{
+	FRM_AUDIT_TOUCH("AFGBuildable");
+
+	if (AFGBuildableManufacturer* Manufacturer = Cast<AFGBuildableManufacturer>(Buildable)) {
+		const TSubclassOf<UFGRecipe> Recipe = Manufacturer->GetCurrentRecipe();
+		const float Potential = Manufacturer->GetCurrentPotential();
+		const float Productivity = Manufacturer->GetProductivity();
+		const float ProductionBoost = Manufacturer->mProductionShardBoostMultiplier;
+
+		uint32 Signature = GetTypeHash(Recipe.Get());
+		Signature = HashCombine(Signature, GetTypeHash(Potential));
+		Signature = HashCombine(Signature, GetTypeHash(ProductionBoost));
+		Signature = HashCombine(Signature, GetTypeHash(GetProductivityBucket(Productivity)));
+
+		Update(Manufacturer, Signature, [&](TArray<FRate>& OutRates) {
+			if (!IsValid(Recipe)) return;
+
+			const float ProdCycle = UKismetMathLibrary::SafeDivide(60, Manufacturer->GetProductionCycleTimeForRecipe(Recipe));
+
+			for (const FItemAmount& Product : Recipe.GetDefaultObject()->GetProducts()) {
+				const float RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Product.Amount, UFGItemDescriptor::GetForm(Product.ItemClass));
+
+				FRate& Rate = OutRates.AddDefaulted_GetRef();
+				Rate.Item = GetItemIndex(Product.ItemClass);
+				Rate.CurrentProduced = RecipeAmount * ProdCycle * Productivity * Potential * ProductionBoost;
+				Rate.MaxProduced = RecipeAmount * ProdCycle * Potential * ProductionBoost;
+			}
+
+			for (const FItemAmount& Ingredient : Recipe.GetDefaultObject()->GetIngredients()) {
+				const float RecipeAmount = UFGInventoryLibrary::GetAmountConvertedByForm(Ingredient.Amount, UFGItemDescriptor::GetForm(Ingredient.ItemClass));
+
+				FRate& Rate = OutRates.AddDefaulted_GetRef();
+				Rate.Item = GetItemIndex(Ingredient.ItemClass);
+				Rate.CurrentConsumed = RecipeAmount * ProdCycle * Productivity * Potential;
+				Rate.MaxConsumed = RecipeAmount * ProdCycle * Potential;
+			}
+		});
+	}
+	else if (AFGBuildableResourceExtractor* Extractor = Cast<AFGBuildableResourceExtractor>(Buildable)) {
+		const TScriptInterface<IFGExtractableResourceInterface> Resource = Extractor->GetExtractableResource();
+		const TSubclassOf<UFGResourceDescriptor> ItemClass = Resource ? Resource->GetResourceClass() : nullptr;
+		const float ExtractionPerMinute = Extractor->GetExtractionPerMinute();
+		const float Productivity = Extractor->GetProductivity();
+
+		uint32 Signature = GetTypeHash(ItemClass.Get());
+		Signature = HashCombine(Signature, GetTypeHash(ExtractionPerMinute));
+		Signature = HashCombine(Signature, GetTypeHash(GetProductivityBucket(Productivity)));
+
+		Update(Extractor, Signature, [&](TArray<FRate>& OutRates) {
+			if (!ItemClass) return;
+
+			FRate& Rate = OutRates.AddDefaulted_GetRef();
+			Rate.Item = GetItemIndex(ItemClass);
+			Rate.CurrentProduced = ExtractionPerMinute * Productivity;
+			Rate.MaxProduced = ExtractionPerMinute;
+		});
+	}
+	else if (AFGBuildableGeneratorFuel* Generator = Cast<AFGBuildableGeneratorFuel>(Buildable)) {
+		const TSubclassOf<UFGItemDescriptor> FuelItemClass = Generator->GetCurrentFuelClass();
+		const float Potential = Generator->GetCurrentPotential();
+		const float Productivity = Generator->GetProductivity();
+		const bool bSupplemental = Generator->GetRequiresSupplementalResource();
+		const float SupplementalConsumption = bSupplemental ? Generator->GetSupplementalConsumptionRateCurrent() * 60 : 0.0f;
+		const float SupplementalMaxConsumption = bSupplemental ? Generator->GetSupplementalConsumptionRateMaximum() * 60 : 0.0f;
+
+		uint32 Signature = GetTypeHash(FuelItemClass.Get());
+		Signature = HashCombine(Signature, GetTypeHash(Potential));
+		Signature = HashCombine(Signature, GetTypeHash(GetProductivityBucket(Productivity)));
+		Signature = HashCombine(Signature, GetTypeHash(SupplementalConsumption));
+		Signature = HashCombine(Signature, GetTypeHash(SupplementalMaxConsumption));
+
+		Update(Generator, Signature, [&](TArray<FRate>& OutRates) {
+			if (FuelItemClass) {
+				const float EnergyValue = UFGInventoryLibrary::GetAmountConvertedByForm(UFGItemDescriptor::GetEnergyValue(FuelItemClass), UFGItemDescriptor::GetForm(FuelItemClass));
+				const float MaxFuelConsumption = 60 * UFRM_Library::SafeDivide_Float(Potential, EnergyValue);
+
+				FRate& Rate = OutRates.AddDefaulted_GetRef();
+				Rate.Item = GetItemIndex(FuelItemClass);
+				Rate.CurrentConsumed = MaxFuelConsumption * Productivity;
+				Rate.MaxConsumed = MaxFuelConsumption;
+			}
+
+			if (bSupplemental) {
+				FRate& Rate = OutRates.AddDefaulted_GetRef();
+				Rate.Item = GetItemIndex(Generator->GetSupplementalResourceClass());
+				Rate.CurrentConsumed = SupplementalConsumption;
+				Rate.MaxConsumed = SupplementalMaxConsumption;
+			}
+		});
+	}
+
+	// the production boost applies together with the potential, the round robin picks up anything later
+	const AFGBuildableFactory* Factory = Cast<AFGBuildableFactory>(Buildable);
+	return !Factory || FMath::IsNearlyEqual(Factory->GetCurrentPotential(), Factory->GetPendingPotential());
+}
+
+void FFRMProductionTracker::Apply(const TArray<FRate>& Rates, const double Sign)
+{
+	for (const FRate& Rate : Rates) {
+		if (Rate.Item == INDEX_NONE) continue;
+
+		References[Rate.Item] += Sign > 0.0 ? 1 : -1;
+		CurrentProduced[Rate.Item] += Sign * Rate.CurrentProduced;
+		MaxProduced[Rate.Item] += Sign * Rate.MaxProduced;
+		CurrentConsumed[Rate.Item] += Sign * Rate.CurrentConsumed;
+		MaxConsumed[Rate.Item] += Sign * Rate.MaxConsumed;
+
+		// nothing references the item anymore, start over from exact zeros
+		if (References[Rate.Item] == 0) {
+			CurrentProduced[Rate.Item] = MaxProduced[Rate.Item] = CurrentConsumed[Rate.Item] = MaxConsumed[Rate.Item] = 0.0;
+		}
+	}
+}
+
+int32 FFRMProductionTracker::GetItemIndex(const TSubclassOf<UFGItemDescriptor> Item)
+{
+	if (!Item) return INDEX_NONE;
+
+	if (const int32* Found = ItemIndex.Find(Item.Get())) return *Found;
+
+	const int32 Index = Items.Add(Item);
+	ItemIndex.Add(Item.Get(), Index);
+	ItemNames.Add(UFGItemDescriptor::GetItemName(Item));
+	References.Add(0);
+	CurrentProduced.Add(0.0);
+	MaxProduced.Add(0.0);
+	CurrentConsumed.Add(0.0);
+	MaxConsumed.Add(0.0);
+
+	// same order as GetAllDescriptorsSorted
+	const int32 Position = Algo::LowerBound(SortedItems, Index, [this](const int32 A, const int32 B) {
+		return ItemNames[A].CompareTo(ItemNames[B]) < 0;
+	});
+	SortedItems.Insert(Index, Position);
+
+	return Index;
+}
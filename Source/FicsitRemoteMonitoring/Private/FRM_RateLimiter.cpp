@@ -0,0 +1,117 @@
+#include "FRM_RateLimiter.h"
+
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+
+FFRMRateLimiter& FFRMRateLimiter::Get()
+{
+	static FFRMRateLimiter Instance;
+	return Instance;
+}
+
+void FFRMRateLimiter::Start(const FFRMRateLimitSettings& InSettings)
+{
+	Stop();
+
+	FWriteScopeLock WriteLock(SettingsLock);
+	Settings = InSettings;
+
+	// a request costing more than the whole bucket could never be served
+	Settings.Burst = FMath::Max(Settings.Burst, 1.0);
+	for (auto& Cost : Settings.Costs) {
+		Cost.Value = FMath::Clamp(Cost.Value, 0.0, Settings.Burst);
+	}
+}
+
+void FFRMRateLimiter::Stop()
+{
+	{
+		FWriteScopeLock WriteLock(SettingsLock);
+		Settings = FFRMRateLimitSettings();
+	}
+
+	for (FShard& Shard : Shards) {
+		FScopeLock Lock(&Shard.Mutex);
+		Shard.Buckets.Empty();
+	}
+	TrackedClients = 0;
+}
+
+bool FFRMRateLimiter::TryAcquire(const std::string_view Address, const FString& APIName, int32& OutRetryAfter)
+{
+	double Rate, Burst, Cost = 1.0;
+	{
+		FReadScopeLock ReadLock(SettingsLock);
+		if (Settings.Rate <= 0.0) return true;
+
+		Rate = Settings.Rate;
+		Burst = Settings.Burst;
+		if (const double* EndpointCost = Settings.Costs.Find(APIName)) {
+			Cost = *EndpointCost;
+		}
+	}
+
+	const FAddress Key = MakeAddress(Address);
+	FShard& Shard = Shards[GetTypeHash(Key) % NumShards];
+	const double Now = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&Shard.Mutex);
+
+	FBucket* Bucket = Shard.Buckets.Find(Key);
+	if (!Bucket) {
+		if (Shard.Buckets.Num() >= SweepThreshold) {
+			Sweep(Shard, Now, Rate, Burst);
+		}
+
+		// new clients start with a full bucket
+		Bucket = &Shard.Buckets.Add(Key, {Burst, Now});
+		++TrackedClients;
+	}
+
+	Bucket->Tokens = FMath::Min(Burst, Bucket->Tokens + (Now - Bucket->UpdatedAt) * Rate);
+	Bucket->UpdatedAt = Now;
+
+	if (Bucket->Tokens >= Cost) {
+		Bucket->Tokens -= Cost;
+		return true;
+	}
+
+	OutRetryAfter = FMath::Max(FMath::CeilToInt32((Cost - Bucket->Tokens) / Rate), 1);
+	return false;
+}
+
+int32 FFRMRateLimiter::GetTrackedClients() const
+{
+	return TrackedClients.load(std::memory_order_relaxed);
+}
+
+FFRMRateLimiter::FAddress FFRMRateLimiter::MakeAddress(std::string_view Address)
+{
+	static constexpr uint8 MappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+	if (Address.size() == 16 && FMemory::Memcmp(Address.data(), MappedPrefix, 12) == 0) {
+		Address.remove_prefix(12);
+	}
+
+	FAddress Key;
+	if (Address.size() == 16) {
+		FMemory::Memcpy(&Key.High, Address.data(), 8);
+		FMemory::Memcpy(&Key.Low, Address.data() + 8, 8);
+	}
+	else {
+		FMemory::Memcpy(&Key.Low, Address.data(), FMath::Min<size_t>(Address.size(), 8));
+	}
+
+	return Key;
+}
+
+void FFRMRateLimiter::Sweep(FShard& Shard, const double Now, const double Rate, const double Burst)
+{
+	// a bucket that has filled up again behaves exactly like a new one
+	for (auto It = Shard.Buckets.CreateIterator(); It; ++It) {
+		if (It->Value.Tokens + (Now - It->Value.UpdatedAt) * Rate >= Burst) {
+			It.RemoveCurrent();
+			--TrackedClients;
+		}
+	}
+}
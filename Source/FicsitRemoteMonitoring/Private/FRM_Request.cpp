@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "FRM_Request.h"
+#include "FicsitRemoteMonitoringModule.h"
 
 void UFRM_RequestLibrary::SendErrorJson(uWS::HttpResponse<false>* res, const FString& Status, const FString& Json)
 {
@@ -23,6 +24,14 @@ void UFRM_RequestLibrary::SendErrorMessage(uWS::HttpResponse<false>* res, const
 	SendErrorJson(res, Status, JsonObjectToString(JsonObject, false));
 }
 
+void UFRM_RequestLibrary::SendRetryLater(uWS::HttpResponse<false>* res, const FString& Status, const int32 RetryAfterSeconds, const FString& Message)
+{
+	// uWS keeps the first status written, SendErrorMessage only adds the body
+	res->writeStatus(std::string_view(TCHAR_TO_UTF8(*Status)).data());
+	res->writeHeader("Retry-After", std::to_string(FMath::Max(RetryAfterSeconds, 1)));
+	SendErrorMessage(res, Status, Message);
+}
+
 void UFRM_RequestLibrary::AddResponseHeaders(uWS::HttpResponse<false>* res, const bool bIncludeContentType)
 {
 	res
@@ -69,6 +78,7 @@ TSharedPtr<FJsonObject> UFRM_RequestLibrary::TryGetBoolField(const TSharedPtr<FJ
 }
 
 FString UFRM_RequestLibrary::JsonArrayToString(const TArray<TSharedPtr<FJsonValue>>& JsonArray, const bool JSONDebugMode) {
+	FRM_TRACE_SCOPE("FRM::JsonWriter");
 	FString OutputString;
 
 	// Choose Pretty or Condensed print policy based on JSONDebugMode
@@ -88,6 +98,7 @@ FString UFRM_RequestLibrary::JsonArrayToString(const TArray<TSharedPtr<FJsonValu
 }
 
 FString UFRM_RequestLibrary::JsonObjectToString(const TSharedPtr<FJsonObject>& JsonObject, const bool JSONDebugMode) {
+	FRM_TRACE_SCOPE("FRM::JsonWriter");
 	FString OutputString;
 
 	// Choose Pretty or Condensed print policy based on JSONDebugMode
@@ -0,0 +1,74 @@
+#include "FRM_ResponseCache.h"
+
+#include "Misc/ScopeLock.h"
+
+EFRMCacheLookup FFRMResponseCache::Acquire(const FString& Key, const double MaxAge, FCachedResponse& OutResponse, TUniqueFunction<void(const FCachedResponse&)>&& OnJoined)
+{
+	FScopeLock Lock(&Mutex);
+
+	if (const FEntry* Entry = Entries.Find(Key); Entry && FPlatformTime::Seconds() - Entry->Timestamp <= MaxAge) {
+		OutResponse = Entry->Response;
+		return EFRMCacheLookup::Hit;
+	}
+
+	// another request is already running this endpoint, its result is handed over once it completes
+	if (auto* Joined = InFlight.Find(Key)) {
+		Joined->Add(MoveTemp(OnJoined));
+		return EFRMCacheLookup::Joined;
+	}
+
+	InFlight.Add(Key);
+	return EFRMCacheLookup::Miss;
+}
+
+void FFRMResponseCache::Complete(const FString& Key, const double MaxAge, const FCachedResponse& Response)
+{
+	TArray<TUniqueFunction<void(const FCachedResponse&)>> Joined;
+
+	{
+		FScopeLock Lock(&Mutex);
+
+		// errors are handed to the joined requests but never cached
+		if (Response.bSuccess) {
+			const double Now = FPlatformTime::Seconds();
+
+			// query strings make the key space open ended, drop expired entries once the map grows
+			if (Entries.Num() >= 256) {
+				for (auto It = Entries.CreateIterator(); It; ++It) {
+					if (Now - It.Value().Timestamp > MaxAge) It.RemoveCurrent();
+				}
+			}
+
+			Entries.Add(Key, {Response, Now});
+		}
+		if (auto* Found = InFlight.Find(Key)) {
+			Joined = MoveTemp(*Found);
+			InFlight.Remove(Key);
+		}
+	}
+
+	// outside the lock, the callbacks may look the cache up again
+	for (TUniqueFunction<void(const FCachedResponse&)>& OnJoined : Joined) {
+		OnJoined(Response);
+	}
+}
+
+bool FFRMResponseCache::Find(const FString& Key, const double MaxAge, FCachedResponse& OutResponse)
+{
+	FScopeLock Lock(&Mutex);
+
+	const FEntry* Entry = Entries.Find(Key);
+	if (!Entry || FPlatformTime::Seconds() - Entry->Timestamp > MaxAge) return false;
+
+	OutResponse = Entry->Response;
+	return true;
+}
+
+void FFRMResponseCache::Empty()
+{
+	FScopeLock Lock(&Mutex);
+	Entries.Empty();
+
+	// keys in flight belong to loops that are shutting down, their results may never come back
+	InFlight.Empty();
+}
@@ -0,0 +1,120 @@
+#include "FRM_Scheduler.h"
+
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+namespace
+{
+	// weight of the newest measurement, about the last 10 requests of an endpoint count
+	constexpr double EstimateSmoothing = 0.2;
+}
+
+FFRMScheduler& FFRMScheduler::Get()
+{
+	static FFRMScheduler Instance;
+	return Instance;
+}
+
+void FFRMScheduler::Start(const FFRMSchedulerSettings& InSettings)
+{
+	Stop();
+
+	InteractiveCost = FMath::Max(InSettings.InteractiveCost, 0.0);
+	BulkCost = FMath::Max(InSettings.BulkCost, InSettings.InteractiveCost);
+	AgingInterval = FMath::Max(InSettings.AgingInterval, 0.001);
+}
+
+void FFRMScheduler::Stop()
+{
+	for (std::atomic<double>& Estimate : Estimates) {
+		Estimate.store(0.0, std::memory_order_relaxed);
+	}
+
+	// the jobs reference the world and subsystem being torn down, they are destroyed unrun outside the lock
+	TArray<FJob> Dropped[static_cast<int32>(EFRMPriority::Count)];
+	{
+		FScopeLock Lock(&Mutex);
+		for (int32 Class = 0; Class < static_cast<int32>(EFRMPriority::Count); Class++) {
+			Dropped[Class] = MoveTemp(Queues[Class]);
+		}
+	}
+}
+
+void FFRMScheduler::Dispatch(const EFRMPriority Priority, TUniqueFunction<void()>&& Work)
+{
+	{
+		FScopeLock Lock(&Mutex);
+		Queues[static_cast<int32>(Priority)].Add({MoveTemp(Work), FPlatformTime::Seconds()});
+	}
+
+	// one task per job, so every job runs even if the tasks pick them in another order
+	AsyncTask(ENamedThreads::GameThread, [this]() {
+		RunNext();
+	});
+}
+
+void FFRMScheduler::RunNext()
+{
+	FJob Job;
+	{
+		FScopeLock Lock(&Mutex);
+
+		// only the oldest job of every class can be the most urgent one, the queues are in order of arrival
+		const double Now = FPlatformTime::Seconds();
+		const double Interval = AgingInterval.load(std::memory_order_relaxed);
+
+		int32 Best = INDEX_NONE;
+		double BestRank = 0.0;
+		for (int32 Class = 0; Class < static_cast<int32>(EFRMPriority::Count); Class++) {
+			if (Queues[Class].IsEmpty()) continue;
+
+			const double Waited = Now - Queues[Class][0].QueuedAt;
+			const double Rank = Class - FMath::FloorToDouble(Waited / Interval);
+			if (Best == INDEX_NONE || Rank < BestRank) {
+				Best = Class;
+				BestRank = Rank;
+			}
+		}
+
+		if (Best == INDEX_NONE) return;
+
+		Job = MoveTemp(Queues[Best][0]);
+		Queues[Best].RemoveAt(0);
+	}
+
+	FRM_TRACE_SCOPE("FRM::Scheduler::Run");
+	Job.Work();
+}
+
+EFRMPriority FFRMScheduler::GetPriority(const int32 EndpointIndex) const
+{
+	const double Estimate = GetEstimate(EndpointIndex);
+	if (Estimate <= 0.0) return EFRMPriority::Normal;
+
+	if (Estimate < InteractiveCost.load(std::memory_order_relaxed)) return EFRMPriority::Interactive;
+	if (Estimate > BulkCost.load(std::memory_order_relaxed)) return EFRMPriority::Bulk;
+	return EFRMPriority::Normal;
+}
+
+void FFRMScheduler::RecordCost(const int32 EndpointIndex, const double Seconds)
+{
+	if (EndpointIndex < 0 || EndpointIndex >= FFRMMetrics::MaxEndpoints) return;
+
+	// racing updates from several loops may lose a sample, which an average does not mind
+	std::atomic<double>& Estimate = Estimates[EndpointIndex];
+	const double Previous = Estimate.load(std::memory_order_relaxed);
+	Estimate.store(Previous > 0.0 ? FMath::Lerp(Previous, Seconds, EstimateSmoothing) : FMath::Max(Seconds, 1e-9), std::memory_order_relaxed);
+}
+
+double FFRMScheduler::GetEstimate(const int32 EndpointIndex) const
+{
+	if (EndpointIndex < 0 || EndpointIndex >= FFRMMetrics::MaxEndpoints) return 0.0;
+	return Estimates[EndpointIndex].load(std::memory_order_relaxed);
+}
+
+int32 FFRMScheduler::GetQueued(const EFRMPriority Priority) const
+{
+	FScopeLock Lock(&Mutex);
+	return Queues[static_cast<int32>(Priority)].Num();
+}
@@ -0,0 +1,182 @@
+#include "FRM_SpatialIndex.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+namespace
+{
+	bool ParseNumbers(const FString& Value, const int32 Count, TArray<double>& OutNumbers)
+	{
+		TArray<FString> Parts;
+		Value.ParseIntoArray(Parts, TEXT(","));
+		if (Parts.Num() != Count) return false;
+
+		OutNumbers.Reset(Count);
+		for (const FString& Part : Parts) {
+			const FString Trimmed = Part.TrimStartAndEnd();
+			if (!Trimmed.IsNumeric()) return false;
+			OutNumbers.Add(FCString::Atod(*Trimmed));
+		}
+		return true;
+	}
+}
+
+bool FFRMSpatialQuery::Parse(const TMap<FString, FString>& QueryParams, FFRMSpatialQuery& OutQuery, FString& OutError)
+{
+	const FString* BoxParam = QueryParams.Find("bbox");
+	const FString* NearParam = QueryParams.Find("near");
+	if (!BoxParam && !NearParam) return false;
+
+	TArray<double> Numbers;
+
+	if (BoxParam) {
+		if (!ParseNumbers(*BoxParam, 4, Numbers) || Numbers[0] > Numbers[2] || Numbers[1] > Numbers[3]) {
+			OutError = "bbox expects minx,miny,maxx,maxy";
+			return false;
+		}
+
+		OutQuery.Box = FBox2D(FVector2D(Numbers[0], Numbers[1]), FVector2D(Numbers[2], Numbers[3]));
+		OutQuery.Radius = -1.0;
+	}
+
+	if (NearParam) {
+		const FString* RadiusParam = QueryParams.Find("radius");
+		if (!ParseNumbers(*NearParam, 2, Numbers) || !RadiusParam || !RadiusParam->IsNumeric() || FCString::Atod(**RadiusParam) < 0.0) {
+			OutError = "near expects x,y together with a positive radius";
+			return false;
+		}
+
+		const FVector2D Center(Numbers[0], Numbers[1]);
+		const double Radius = FCString::Atod(**RadiusParam);
+		const FBox2D CircleBox(Center - FVector2D(Radius), Center + FVector2D(Radius));
+
+		// both given, the circle within the box
+		OutQuery.Box = BoxParam ? OutQuery.Box.Overlap(CircleBox) : CircleBox;
+		OutQuery.Center = Center;
+		OutQuery.Radius = Radius;
+	}
+
+	return true;
+}
+
+bool FFRMSpatialQuery::Intersects(const FBox2D& Bounds) const
+{
+	if (!Box.bIsValid || !Box.Intersect(Bounds)) return false;
+
+	return Radius < 0.0 || Bounds.ComputeSquaredDistanceToPoint(Center) <= Radius * Radius;
+}
+
+void FFRMSpatialIndex::Update(const FName ID, const FBox2D& Bounds)
+{
+	FEntry NewEntry;
+	NewEntry.Bounds = Bounds;
+	NewEntry.Cells = GetCells(Bounds);
+	NewEntry.bOversized = static_cast<int64>(NewEntry.Cells.Width() + 1) * (NewEntry.Cells.Height() + 1) > MaxCellsPerEntry;
+
+	FWriteScopeLock WriteLock(Lock);
+
+	FEntry* Entry = Entries.Find(ID);
+	if (Entry && Entry->Cells == NewEntry.Cells && Entry->bOversized == NewEntry.bOversized) {
+		// still in the same cells, which is the common case for anything that moves
+		Entry->Bounds = Bounds;
+		return;
+	}
+
+	if (Entry) Unlink(ID, *Entry);
+	Link(ID, NewEntry);
+	Entries.Add(ID, NewEntry);
+}
+
+void FFRMSpatialIndex::Remove(const FName ID)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(ID, Entry)) Unlink(ID, Entry);
+}
+
+void FFRMSpatialIndex::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	Entries.Empty();
+	Cells.Empty();
+	Oversized.Empty();
+}
+
+void FFRMSpatialIndex::Query(const FFRMSpatialQuery& Query, TSet<FName>& OutIDs) const
+{
+	FRM_TRACE_SCOPE("FRM::SpatialIndex::Query");
+
+	if (!Query.Box.bIsValid) return;
+
+	FReadScopeLock ReadLock(Lock);
+
+	const auto TestEntry = [&Query, &OutIDs, this](const FName ID) {
+		if (Query.Intersects(Entries.FindChecked(ID).Bounds)) OutIDs.Add(ID);
+	};
+
+	const FIntRect QueryCells = GetCells(Query.Box);
+	const int64 QueryCellCount = static_cast<int64>(QueryCells.Width() + 1) * (QueryCells.Height() + 1);
+
+	// a query larger than the populated area is cheaper to answer from the occupied cells
+	if (QueryCellCount > Cells.Num()) {
+		for (const auto& Cell : Cells) {
+			if (Cell.Key.X < QueryCells.Min.X || Cell.Key.X > QueryCells.Max.X || Cell.Key.Y < QueryCells.Min.Y || Cell.Key.Y > QueryCells.Max.Y) continue;
+			for (const FName ID : Cell.Value) TestEntry(ID);
+		}
+	}
+	else {
+		for (int32 X = QueryCells.Min.X; X <= QueryCells.Max.X; X++) {
+			for (int32 Y = QueryCells.Min.Y; Y <= QueryCells.Max.Y; Y++) {
+				if (const TArray<FName>* Cell = Cells.Find(FIntPoint(X, Y))) {
+					for (const FName ID : *Cell) TestEntry(ID);
+				}
+			}
+		}
+	}
+
+	for (const FName ID : Oversized) TestEntry(ID);
+}
+
+FIntRect FFRMSpatialIndex::GetCells(const FBox2D& Bounds)
+{
+	// Max is inclusive, an entry on a cell border is linked to both cells
+	return FIntRect(
+		FMath::FloorToInt32(Bounds.Min.X / CellSize), FMath::FloorToInt32(Bounds.Min.Y / CellSize),
+		FMath::FloorToInt32(Bounds.Max.X / CellSize), FMath::FloorToInt32(Bounds.Max.Y / CellSize)
+	);
+}
+
+void FFRMSpatialIndex::Unlink(const FName ID, const FEntry& Entry)
+{
+	if (Entry.bOversized) {
+		Oversized.Remove(ID);
+		return;
+	}
+
+	for (int32 X = Entry.Cells.Min.X; X <= Entry.Cells.Max.X; X++) {
+		for (int32 Y = Entry.Cells.Min.Y; Y <= Entry.Cells.Max.Y; Y++) {
+			const FIntPoint Key(X, Y);
+			TArray<FName>* Cell = Cells.Find(Key);
+			if (!Cell) continue;
+
+			Cell->RemoveSingleSwap(ID, false);
+			if (Cell->IsEmpty()) Cells.Remove(Key);
+		}
+	}
+}
+
+void FFRMSpatialIndex::Link(const FName ID, const FEntry& Entry)
+{
+	if (Entry.bOversized) {
+		Oversized.Add(ID);
+		return;
+	}
+
+	for (int32 X = Entry.Cells.Min.X; X <= Entry.Cells.Max.X; X++) {
+		for (int32 Y = Entry.Cells.Min.Y; Y <= Entry.Cells.Max.Y; Y++) {
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(ID);
+		}
+	}
+}
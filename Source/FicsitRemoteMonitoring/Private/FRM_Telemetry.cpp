@@ -0,0 +1,115 @@
+#include "FRM_Telemetry.h"
+
+#include "FGDroneVehicle.h"
+#include "FGDroneMovementComponent.h"
+#include "FGRailroadVehicle.h"
+#include "FGRailroadVehicleMovementComponent.h"
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+namespace
+{
+	constexpr int32 HeaderSize = 20;
+	constexpr int32 SampleSize = 36;
+
+	template <typename T>
+	void WriteFixed(uint8*& Out, const T Value)
+	{
+		FMemory::Memcpy(Out, &Value, sizeof(T));
+		Out += sizeof(T);
+	}
+}
+
+void FFRMTelemetry::Capture(UWorld* World, const FFRMEntityIndex& EntityIndex)
+{
+	FRM_TRACE_SCOPE("FRM::Telemetry::Capture");
+
+	if (!World) return;
+
+	EntityIndex.GetMobile(Movers);
+
+	Back.Reset(Movers.Num());
+	for (const FFRMEntity& Mover : Movers) {
+		// a train is sampled through its locomotives and wagons, creatures are not of interest here
+		if (Mover.Kind == EFRMEntityKind::Train || Mover.Kind == EFRMEntityKind::Creature) continue;
+
+		FFRMMoverSample& Entry = Back.AddDefaulted_GetRef();
+		Entry.CompactID = Mover.CompactID;
+		Entry.Kind = Mover.Kind;
+		if (!Sample(Mover.Actor.Get(), Entry)) Back.Pop(false);
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Swap(Front, Back);
+	FrontTime = World->GetTimeSeconds();
+	FrontSequence++;
+}
+
+TSharedPtr<const std::string, ESPMode::ThreadSafe> FFRMTelemetry::Encode() const
+{
+	FRM_TRACE_SCOPE("FRM::Telemetry::Encode");
+
+	FReadScopeLock ReadLock(Lock);
+	if (FrontSequence == 0) return nullptr;
+
+	std::string Out;
+	Out.resize(HeaderSize + Front.Num() * SampleSize);
+
+	uint8* Cursor = reinterpret_cast<uint8*>(Out.data());
+	FMemory::Memcpy(Cursor, "FRMV", 4);
+	Cursor += 4;
+	WriteFixed<uint32>(Cursor, FrontSequence);
+	WriteFixed<double>(Cursor, FrontTime);
+	WriteFixed<uint32>(Cursor, Front.Num());
+
+	for (const FFRMMoverSample& Entry : Front) {
+		WriteFixed<uint32>(Cursor, Entry.CompactID);
+		WriteFixed<uint8>(Cursor, static_cast<uint8>(Entry.Kind));
+		WriteFixed<uint8>(Cursor, 0);
+		WriteFixed<uint16>(Cursor, 0);
+		WriteFixed<float>(Cursor, Entry.Location.X);
+		WriteFixed<float>(Cursor, Entry.Location.Y);
+		WriteFixed<float>(Cursor, Entry.Location.Z);
+		WriteFixed<float>(Cursor, Entry.Yaw);
+		WriteFixed<float>(Cursor, Entry.Velocity.X);
+		WriteFixed<float>(Cursor, Entry.Velocity.Y);
+		WriteFixed<float>(Cursor, Entry.Velocity.Z);
+	}
+
+	return MakeShared<const std::string, ESPMode::ThreadSafe>(MoveTemp(Out));
+}
+
+bool FFRMTelemetry::Sample(AActor* Actor, FFRMMoverSample& OutSample)
+{
+	if (!IsValid(Actor)) return false;
+
+	OutSample.Location = FVector3f(Actor->GetActorLocation());
+	OutSample.Yaw = Actor->GetActorRotation().Yaw;
+
+	// rail vehicles and drones are moved by their own components, the actor velocity stays zero
+	FVector Velocity = Actor->GetVelocity();
+	if (AFGRailroadVehicle* RailroadVehicle = Cast<AFGRailroadVehicle>(Actor)) {
+		if (UFGRailroadVehicleMovementComponent* Movement = RailroadVehicle->GetRailroadVehicleMovementComponent()) {
+			Velocity = Actor->GetActorForwardVector() * Movement->GetForwardSpeed();
+		}
+	}
+	else if (AFGDroneVehicle* Drone = Cast<AFGDroneVehicle>(Actor)) {
+		if (UFGDroneMovementComponent* Movement = Drone->GetDroneMovementComponent()) {
+			Velocity = Movement->GetVelocity();
+		}
+	}
+	OutSample.Velocity = FVector3f(Velocity);
+
+	return true;
+}
+
+void FFRMTelemetry::Reset()
+{
+	Back.Empty();
+	Movers.Empty();
+
+	FWriteScopeLock WriteLock(Lock);
+	Front.Empty();
+	FrontTime = 0.0;
+	FrontSequence = 0;
+}
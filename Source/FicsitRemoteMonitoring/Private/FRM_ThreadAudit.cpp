@@ -0,0 +1,279 @@
+#include "FRM_ThreadAudit.h"
+
+#include "FRM_Request.h"
+#include "HAL/IConsoleManager.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// innermost endpoint running on this thread, only set while an audit runs
+	thread_local FFRMThreadAudit::FScope* ActiveScope = nullptr;
+
+	enum class EVerdict : uint8
+	{
+		// touches the engine from a request thread, must be flagged bRequireGameThread
+		Unsafe,
+		// flagged bRequireGameThread without touching the engine, could run on the request threads
+		Movable,
+		// touches the engine, but was only called from the game thread so the flag could not be checked
+		Unverified,
+		// none of its calls went through an annotated engine access or cache read, the audit cannot judge it
+		Uninstrumented,
+		Ok
+	};
+
+	const TCHAR* VerdictNames[] = {TEXT("unsafe"), TEXT("movable"), TEXT("unverified"), TEXT("uninstrumented"), TEXT("ok")};
+}
+
+FFRMThreadAudit& FFRMThreadAudit::Get()
+{
+	static FFRMThreadAudit Instance;
+	return Instance;
+}
+
+void FFRMThreadAudit::Start()
+{
+	FScopeLock Lock(&Mutex);
+	Records.Reset();
+	StartedAt = FPlatformTime::Seconds();
+	StoppedAt = 0.0;
+	bRunning = true;
+}
+
+void FFRMThreadAudit::Stop()
+{
+	FScopeLock Lock(&Mutex);
+	if (!bRunning) return;
+
+	bRunning = false;
+	StoppedAt = FPlatformTime::Seconds();
+}
+
+void FFRMThreadAudit::Touch(const TCHAR* Api)
+{
+	if (FScope* Scope = ActiveScope) {
+		Scope->Touches.FindOrAdd(Api)++;
+	}
+}
+
+void FFRMThreadAudit::TouchCache(const TCHAR* Cache)
+{
+	if (FScope* Scope = ActiveScope) {
+		Scope->CacheReads.FindOrAdd(Cache)++;
+	}
+}
+
+FFRMThreadAudit::FContext FFRMThreadAudit::CurrentContext()
+{
+	FContext Context;
+	if (const FScope* Scope = ActiveScope) {
+		Context.APIName = Scope->APIName;
+		Context.bRequireGameThread = Scope->bRequireGameThread;
+	}
+	return Context;
+}
+
+FFRMThreadAudit::FScope::FScope(const FString& InAPIName, const bool bInRequireGameThread)
+{
+	if (InAPIName.IsEmpty() || !FFRMThreadAudit::Get().IsRunning()) return;
+
+	bActive = true;
+	APIName = InAPIName;
+	bRequireGameThread = bInRequireGameThread;
+	bGameThread = IsInGameThread();
+	StartedAt = FPlatformTime::Seconds();
+
+	Outer = ActiveScope;
+	ActiveScope = this;
+}
+
+FFRMThreadAudit::FScope::FScope(const FContext& Context)
+	: FScope(Context.APIName, Context.bRequireGameThread)
+{
+	bContinuation = bActive;
+}
+
+FFRMThreadAudit::FScope::~FScope()
+{
+	if (!bActive) return;
+
+	ActiveScope = Outer;
+
+	// the time of nested endpoints is counted for both, the outer one waits on the inner one
+	FFRMThreadAudit::Get().Merge(*this, FPlatformTime::Seconds() - StartedAt);
+}
+
+void FFRMThreadAudit::Merge(const FScope& Scope, const double Seconds)
+{
+	FScopeLock Lock(&Mutex);
+
+	// calls still in flight when the run stopped are dropped
+	if (!bRunning) return;
+
+	FRecord& Record = Records.FindOrAdd(Scope.APIName);
+	Record.bRequireGameThread = Scope.bRequireGameThread;
+
+	// a continued call, e.g. a time-sliced pass stepping on the game thread, adds its time but is not another call
+	if (Scope.bGameThread) {
+		Record.GameThreadCalls += !Scope.bContinuation;
+		Record.GameThreadSeconds += Seconds;
+	}
+	else {
+		Record.OtherThreadCalls += !Scope.bContinuation;
+		Record.OtherThreadSeconds += Seconds;
+	}
+
+	for (const TPair<const TCHAR*, int32>& Touch : Scope.Touches) {
+		FTouchCount& Count = Record.Touches.FindOrAdd(Touch.Key);
+		(Scope.bGameThread ? Count.GameThread : Count.OtherThreads) += Touch.Value;
+	}
+
+	for (const TPair<const TCHAR*, int32>& Read : Scope.CacheReads) {
+		Record.CacheReads.FindOrAdd(Read.Key) += Read.Value;
+	}
+}
+
+TSharedPtr<FJsonObject> FFRMThreadAudit::Report() const
+{
+	FScopeLock Lock(&Mutex);
+
+	const double Duration = FMath::Max((bRunning ? FPlatformTime::Seconds() : StoppedAt) - StartedAt, UE_SMALL_NUMBER);
+
+	struct FRow
+	{
+		TSharedPtr<FJsonObject> JEndpoint;
+		EVerdict Verdict;
+		double SavedSeconds;
+	};
+
+	TArray<FRow> Rows;
+	for (const TPair<FString, FRecord>& Entry : Records) {
+		const FRecord& Record = Entry.Value;
+
+		uint64 GameThreadTouches = 0;
+		uint64 OtherThreadTouches = 0;
+		TArray<TSharedPtr<FJsonValue>> JTouches;
+
+		for (const TPair<FString, FTouchCount>& Touch : Record.Touches) {
+			GameThreadTouches += Touch.Value.GameThread;
+			OtherThreadTouches += Touch.Value.OtherThreads;
+
+			TSharedPtr<FJsonObject> JTouch = MakeShared<FJsonObject>();
+			JTouch->Values.Add("api", MakeShared<FJsonValueString>(Touch.Key));
+			JTouch->Values.Add("gameThread", MakeShared<FJsonValueNumber>(Touch.Value.GameThread));
+			JTouch->Values.Add("otherThreads", MakeShared<FJsonValueNumber>(Touch.Value.OtherThreads));
+			JTouches.Add(MakeShared<FJsonValueObject>(JTouch));
+		}
+
+		TArray<TSharedPtr<FJsonValue>> JCacheReads;
+		for (const TPair<FString, uint64>& Read : Record.CacheReads) {
+			TSharedPtr<FJsonObject> JRead = MakeShared<FJsonObject>();
+			JRead->Values.Add("cache", MakeShared<FJsonValueString>(Read.Key));
+			JRead->Values.Add("reads", MakeShared<FJsonValueNumber>(Read.Value));
+			JCacheReads.Add(MakeShared<FJsonValueObject>(JRead));
+		}
+
+		EVerdict Verdict = EVerdict::Ok;
+		if (OtherThreadTouches > 0) {
+			Verdict = EVerdict::Unsafe;
+		}
+		else if (Record.Touches.IsEmpty() && Record.CacheReads.IsEmpty()) {
+			Verdict = EVerdict::Uninstrumented;
+		}
+		else if (Record.bRequireGameThread && GameThreadTouches == 0) {
+			Verdict = EVerdict::Movable;
+		}
+		else if (!Record.bRequireGameThread && GameThreadTouches > 0 && Record.OtherThreadCalls == 0) {
+			Verdict = EVerdict::Unverified;
+		}
+
+		// only a flag change moves work off the game thread; the other verdicts keep it where it is
+		const double SavedSeconds = Verdict == EVerdict::Movable ? Record.GameThreadSeconds : 0.0;
+
+		TSharedPtr<FJsonObject> JEndpoint = MakeShared<FJsonObject>();
+		JEndpoint->Values.Add("name", MakeShared<FJsonValueString>(Entry.Key));
+		JEndpoint->Values.Add("requireGameThread", MakeShared<FJsonValueBoolean>(Record.bRequireGameThread));
+		JEndpoint->Values.Add("verdict", MakeShared<FJsonValueString>(VerdictNames[static_cast<int32>(Verdict)]));
+		JEndpoint->Values.Add("gameThreadCalls", MakeShared<FJsonValueNumber>(Record.GameThreadCalls));
+		JEndpoint->Values.Add("otherThreadCalls", MakeShared<FJsonValueNumber>(Record.OtherThreadCalls));
+		JEndpoint->Values.Add("gameThreadMs", MakeShared<FJsonValueNumber>(Record.GameThreadSeconds * 1000));
+		JEndpoint->Values.Add("otherThreadMs", MakeShared<FJsonValueNumber>(Record.OtherThreadSeconds * 1000));
+		JEndpoint->Values.Add("savedGameThreadMs", MakeShared<FJsonValueNumber>(SavedSeconds * 1000));
+		JEndpoint->Values.Add("savedGameThreadMsPerSecond", MakeShared<FJsonValueNumber>(SavedSeconds * 1000 / Duration));
+		JEndpoint->Values.Add("touches", MakeShared<FJsonValueArray>(JTouches));
+		JEndpoint->Values.Add("cacheReads", MakeShared<FJsonValueArray>(JCacheReads));
+
+		Rows.Add({JEndpoint, Verdict, SavedSeconds});
+	}
+
+	// what needs fixing first, then the biggest savings
+	Rows.Sort([](const FRow& A, const FRow& B) {
+		if (A.Verdict != B.Verdict) return A.Verdict < B.Verdict;
+		return A.SavedSeconds > B.SavedSeconds;
+	});
+
+	TArray<TSharedPtr<FJsonValue>> JEndpoints;
+	TArray<TSharedPtr<FJsonValue>> JUninstrumented;
+	for (const FRow& Row : Rows) {
+		JEndpoints.Add(MakeShared<FJsonValueObject>(Row.JEndpoint));
+
+		if (Row.Verdict == EVerdict::Uninstrumented) {
+			JUninstrumented.Add(Row.JEndpoint->Values.FindChecked(TEXT("name")));
+		}
+	}
+
+	// only annotated accesses are seen, an access the annotations miss still reads as movable
+	TSharedPtr<FJsonObject> JReport = MakeShared<FJsonObject>();
+	JReport->Values.Add("advisory", MakeShared<FJsonValueBoolean>(true));
+	JReport->Values.Add("running", MakeShared<FJsonValueBoolean>(bRunning));
+	JReport->Values.Add("seconds", MakeShared<FJsonValueNumber>(Duration));
+	JReport->Values.Add("uninstrumented", MakeShared<FJsonValueArray>(JUninstrumented));
+	JReport->Values.Add("endpoints", MakeShared<FJsonValueArray>(JEndpoints));
+
+	return JReport;
+}
+
+FString FFRMThreadAudit::StopToDebugFolder()
+{
+	Stop();
+
+	const TSharedPtr<FJsonObject> JReport = Report();
+	const FString Path = FPaths::ProjectDir() + "Mods/FicsitRemoteMonitoring/Debug/ThreadAudit.json";
+
+	if (!FFileHelper::SaveStringToFile(UFRM_RequestLibrary::JsonObjectToString(JReport, true), *Path))
+	{
+		return TEXT("Thread audit stopped, but the report could not be written to ") + Path;
+	}
+
+	int32 Unsafe = 0;
+	int32 Movable = 0;
+	for (const TSharedPtr<FJsonValue>& JEndpoint : JReport->GetArrayField(TEXT("endpoints"))) {
+		const FString Verdict = JEndpoint->AsObject()->GetStringField(TEXT("verdict"));
+		Unsafe += Verdict == VerdictNames[static_cast<int32>(EVerdict::Unsafe)];
+		Movable += Verdict == VerdictNames[static_cast<int32>(EVerdict::Movable)];
+	}
+
+	UE_LOGFMT(LogFRMDebug, Log, "Thread audit finished: {Unsafe} unsafe and {Movable} possibly movable endpoints", Unsafe, Movable);
+
+	return FString::Printf(TEXT("Thread audit saved to the Debug folder as ThreadAudit.json: %d unsafe, %d possibly movable endpoints. The report is advisory, check the code before changing a flag."), Unsafe, Movable);
+}
+
+static FAutoConsoleCommand FRMThreadAuditCommand(
+	TEXT("FRM.ThreadAudit"),
+	TEXT("Checks the game thread flags of the FRM endpoints against the engine calls they make. Usage: FRM.ThreadAudit <start/stop>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) {
+		if (Args.Num() && Args[0].Equals(TEXT("start"), ESearchCase::IgnoreCase)) {
+			FFRMThreadAudit::Get().Start();
+			UE_LOG(LogFRMDebug, Display, TEXT("Thread audit started."));
+		}
+		else if (Args.Num() && Args[0].Equals(TEXT("stop"), ESearchCase::IgnoreCase)) {
+			UE_LOG(LogFRMDebug, Display, TEXT("%s"), *FFRMThreadAudit::Get().StopToDebugFolder());
+		}
+		else {
+			UE_LOG(LogFRMDebug, Display, TEXT("Usage: FRM.ThreadAudit <start/stop>"));
+		}
+	})
+);
@@ -0,0 +1,372 @@
+#include "FRM_Tiles.h"
+
+#include "EngineUtils.h"
+#include "FRM_EntityIndex.h"
+#include "Buildables/FGBuildable.h"
+#include "Buildables/FGBuildableConveyorBase.h"
+#include "Buildables/FGBuildablePipeline.h"
+#include "Buildables/FGBuildableRailroadTrack.h"
+#include "Buildables/FGBuildableWire.h"
+#include "FGFactoryConnectionComponent.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/ScopeRWLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Polylines.h"
+
+namespace
+{
+	// Square around the playable map, 7.5 km each way
+	constexpr double WorldMinX = -324698.832;
+	constexpr double WorldMinY = -375000.0;
+	constexpr double WorldSize = 750000.0;
+
+	// Geometry is clipped slightly outside the tile so line joins at tile borders render without gaps
+	constexpr double ClipBuffer = 64.0 / FFRMTileCache::Extent;
+
+	constexpr uint8 TileVersion = 1;
+
+	void WriteVarint(std::string& Out, uint64 Value)
+	{
+		while (Value >= 0x80) {
+			Out.push_back(static_cast<char>((Value & 0x7F) | 0x80));
+			Value >>= 7;
+		}
+		Out.push_back(static_cast<char>(Value));
+	}
+
+	void WriteZigZag(std::string& Out, const int32 Value)
+	{
+		WriteVarint(Out, (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31));
+	}
+
+	template <typename T>
+	void WriteFixed(std::string& Out, const T Value)
+	{
+		for (int32 Byte = 0; Byte < static_cast<int32>(sizeof(T)); Byte++) {
+			Out.push_back(static_cast<char>((static_cast<uint64>(Value) >> (Byte * 8)) & 0xFF));
+		}
+	}
+
+	/* Liang-Barsky, trims the segment to the box and reports whether either end was moved */
+	bool ClipSegment(FVector2D& A, FVector2D& B, const FBox2D& Box, bool& bOutEntered, bool& bOutExited)
+	{
+		const FVector2D Delta = B - A;
+		const double P[4] = {-Delta.X, Delta.X, -Delta.Y, Delta.Y};
+		const double Q[4] = {A.X - Box.Min.X, Box.Max.X - A.X, A.Y - Box.Min.Y, Box.Max.Y - A.Y};
+
+		double T0 = 0.0, T1 = 1.0;
+		for (int32 Edge = 0; Edge < 4; Edge++) {
+			if (P[Edge] == 0.0) {
+				if (Q[Edge] < 0.0) return false;
+				continue;
+			}
+
+			const double T = Q[Edge] / P[Edge];
+			if (P[Edge] < 0.0) {
+				if (T > T1) return false;
+				T0 = FMath::Max(T0, T);
+			}
+			else {
+				if (T < T0) return false;
+				T1 = FMath::Min(T1, T);
+			}
+		}
+
+		bOutEntered = T0 > 0.0;
+		bOutExited = T1 < 1.0;
+		B = A + Delta * T1;
+		A = A + Delta * T0;
+		return true;
+	}
+
+	uint64 GetTileKey(const int32 Z, const int32 X, const int32 Y)
+	{
+		return static_cast<uint64>(Z) << 48 | static_cast<uint64>(X) << 24 | static_cast<uint64>(Y);
+	}
+}
+
+void FFRMTileCache::Start(UWorld* World, const FFRMEntityIndex& EntityIndex)
+{
+	FRM_TRACE_SCOPE("FRM::TileCache::Start");
+
+	Stop();
+	if (!World) return;
+
+	BoundWorld = World;
+	Entities = &EntityIndex;
+
+	for (TActorIterator<AFGBuildable> It(World); It; ++It) {
+		AddLine(*It);
+	}
+
+	SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FFRMTileCache::OnActorSpawned));
+	DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FFRMTileCache::OnActorDestroyed));
+
+	FReadScopeLock ReadLock(Lock);
+	UE_LOGFMT(LogFRMAPI, Log, "Tile cache started with {0} belts, {1} rails, {2} cables and {3} pipes",
+		Layers[static_cast<int32>(EFRMTileLayer::Belts)].Lines.Num(), Layers[static_cast<int32>(EFRMTileLayer::Rails)].Lines.Num(),
+		Layers[static_cast<int32>(EFRMTileLayer::Cables)].Lines.Num(), Layers[static_cast<int32>(EFRMTileLayer::Pipes)].Lines.Num());
+}
+
+void FFRMTileCache::Stop()
+{
+	if (UWorld* World = BoundWorld.Get()) {
+		World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(DestroyedHandle);
+	}
+
+	BoundWorld.Reset();
+	SpawnedHandle.Reset();
+	DestroyedHandle.Reset();
+	Pending.Empty();
+
+	FWriteScopeLock WriteLock(Lock);
+	for (FLayer& Layer : Layers) {
+		Layer.Lines.Empty();
+		Layer.Spatial.Reset();
+		Layer.Tiles.Empty();
+		Layer.Generation++;
+	}
+	Entities = nullptr;
+}
+
+void FFRMTileCache::Refresh()
+{
+	FRM_TRACE_SCOPE("FRM::TileCache::Refresh");
+
+	TArray<TWeakObjectPtr<AActor>> Built = MoveTemp(Pending);
+	Pending.Reset();
+
+	for (const TWeakObjectPtr<AActor>& Actor : Built) {
+		if (Actor.IsValid()) AddLine(Actor.Get());
+	}
+}
+
+TSharedPtr<const std::string, ESPMode::ThreadSafe> FFRMTileCache::GetTile(const EFRMTileLayer Layer, const int32 Z, const int32 X, const int32 Y)
+{
+	FRM_TRACE_SCOPE("FRM::TileCache::GetTile");
+
+	if (Layer == EFRMTileLayer::Num || Z < 0 || Z > MaxZoom) return nullptr;
+
+	const int32 TilesPerSide = 1 << Z;
+	if (X < 0 || Y < 0 || X >= TilesPerSide || Y >= TilesPerSide) return nullptr;
+
+	FLayer& TileLayer = Layers[static_cast<int32>(Layer)];
+	const uint64 Key = GetTileKey(Z, X, Y);
+	const FBox2D Bounds = GetTileBounds(Z, X, Y);
+
+	uint32 Generation;
+	TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload;
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const FTile* Tile = TileLayer.Tiles.Find(Key)) return Tile->Payload;
+
+		Generation = TileLayer.Generation;
+		Payload = MakeShared<const std::string, ESPMode::ThreadSafe>(BuildTile(TileLayer, Layer, Z, X, Y, Bounds));
+	}
+
+	// a tile built while a line changed may already be stale, it is served once but not kept
+	FWriteScopeLock WriteLock(Lock);
+	if (TileLayer.Generation == Generation) {
+		if (TileLayer.Tiles.Num() >= MaxCachedTiles) TileLayer.Tiles.Empty();
+		TileLayer.Tiles.Add(Key, {Bounds.ExpandBy(Bounds.GetSize().X * ClipBuffer), Payload});
+	}
+
+	return Payload;
+}
+
+bool FFRMTileCache::ParseLayer(const FString& Name, EFRMTileLayer& OutLayer)
+{
+	if (Name == TEXT("belts")) OutLayer = EFRMTileLayer::Belts;
+	else if (Name == TEXT("rails")) OutLayer = EFRMTileLayer::Rails;
+	else if (Name == TEXT("cables")) OutLayer = EFRMTileLayer::Cables;
+	else if (Name == TEXT("pipes")) OutLayer = EFRMTileLayer::Pipes;
+	else return false;
+
+	return true;
+}
+
+bool FFRMTileCache::GetLine(AActor* Actor, EFRMTileLayer& OutLayer, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+
+	if (const AFGBuildableWire* Wire = Cast<AFGBuildableWire>(Actor)) {
+		OutLayer = EFRMTileLayer::Cables;
+		OutPoints.Add(FVector2D(Wire->GetConnectionLocation(0)));
+		OutPoints.Add(FVector2D(Wire->GetConnectionLocation(1)));
+		return true;
+	}
+
+	if (Actor->IsA<AFGBuildableConveyorBase>()) OutLayer = EFRMTileLayer::Belts;
+	else if (Actor->IsA<AFGBuildableRailroadTrack>()) OutLayer = EFRMTileLayer::Rails;
+	else if (Actor->IsA<AFGBuildablePipeline>()) OutLayer = EFRMTileLayer::Pipes;
+	else return false;
+
+	TArray<FVector> Samples;
+	if (FFRMPolylineCache::Sample(Actor, Samples)) {
+		OutPoints.Reserve(Samples.Num());
+		for (const FVector& Sample : Samples) {
+			OutPoints.Add(FVector2D(Sample));
+		}
+		return true;
+	}
+
+	// conveyor lifts have no spline, they run straight between their connections
+	if (AFGBuildableConveyorBase* Conveyor = Cast<AFGBuildableConveyorBase>(Actor)) {
+		const UFGFactoryConnectionComponent* ConnectionZero = Conveyor->GetConnection0();
+		const UFGFactoryConnectionComponent* ConnectionOne = Conveyor->GetConnection1();
+		if (ConnectionZero && ConnectionOne) {
+			OutPoints.Add(FVector2D(ConnectionZero->GetComponentLocation()));
+			OutPoints.Add(FVector2D(ConnectionOne->GetComponentLocation()));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FBox2D FFRMTileCache::GetTileBounds(const int32 Z, const int32 X, const int32 Y)
+{
+	const double Size = WorldSize / (1 << Z);
+	const FVector2D Min(WorldMinX + X * Size, WorldMinY + Y * Size);
+	return FBox2D(Min, Min + FVector2D(Size));
+}
+
+void FFRMTileCache::OnActorSpawned(AActor* Actor)
+{
+	// only the class is checked here, the geometry is taken with the next refresh
+	if (Actor->IsA<AFGBuildableWire>() || Actor->IsA<AFGBuildableConveyorBase>() || Actor->IsA<AFGBuildableRailroadTrack>() || Actor->IsA<AFGBuildablePipeline>()) {
+		Pending.Add(Actor);
+	}
+}
+
+void FFRMTileCache::OnActorDestroyed(AActor* Actor)
+{
+	if (!Actor) return;
+
+	const FName Name = Actor->GetFName();
+
+	FWriteScopeLock WriteLock(Lock);
+	for (FLayer& Layer : Layers) {
+		FLine Line;
+		if (!Layer.Lines.RemoveAndCopyValue(Name, Line)) continue;
+
+		Layer.Spatial.Remove(Name);
+		Invalidate(Layer, Line.Bounds);
+	}
+}
+
+void FFRMTileCache::AddLine(AActor* Actor)
+{
+	if (!IsValid(Actor)) return;
+
+	EFRMTileLayer LayerType;
+	FLine Line;
+	if (!GetLine(Actor, LayerType, Line.Points) || Line.Points.Num() < 2) return;
+
+	Line.Bounds = FBox2D(Line.Points);
+	Line.CompactID = Entities ? Entities->GetCompactID(Actor) : 0;
+
+	const FName Name = Actor->GetFName();
+	FLayer& Layer = Layers[static_cast<int32>(LayerType)];
+
+	FWriteScopeLock WriteLock(Lock);
+
+	// a name can be reused by a line built where another one was dismantled
+	if (const FLine* Previous = Layer.Lines.Find(Name)) Invalidate(Layer, Previous->Bounds);
+
+	Invalidate(Layer, Line.Bounds);
+	Layer.Spatial.Update(Name, Line.Bounds);
+	Layer.Lines.Add(Name, MoveTemp(Line));
+}
+
+void FFRMTileCache::Invalidate(FLayer& Layer, const FBox2D& Bounds)
+{
+	for (auto It = Layer.Tiles.CreateIterator(); It; ++It) {
+		if (It->Value.Bounds.Intersect(Bounds)) It.RemoveCurrent();
+	}
+
+	Layer.Generation++;
+}
+
+std::string FFRMTileCache::BuildTile(const FLayer& Layer, const EFRMTileLayer LayerType, const int32 Z, const int32 X, const int32 Y, const FBox2D& Bounds) const
+{
+	const double Size = Bounds.GetSize().X;
+	const double Scale = Extent / Size;
+
+	FFRMSpatialQuery Query;
+	Query.Box = Bounds.ExpandBy(Size * ClipBuffer);
+
+	TSet<FName> IDs;
+	Layer.Spatial.Query(Query, IDs);
+
+	// parts of lines leaving and re-entering the tile become features of their own
+	struct FFeature
+	{
+		uint32 CompactID;
+		TArray<FIntPoint> Points;
+	};
+	TArray<FFeature> Features;
+
+	const auto AddPoint = [&Bounds, Scale](FFeature& Feature, const FVector2D& Point) {
+		const FIntPoint Quantized(FMath::RoundToInt32((Point.X - Bounds.Min.X) * Scale), FMath::RoundToInt32((Point.Y - Bounds.Min.Y) * Scale));
+		if (Feature.Points.IsEmpty() || Feature.Points.Last() != Quantized) Feature.Points.Add(Quantized);
+	};
+
+	const auto CloseFeature = [&Features]() {
+		if (!Features.IsEmpty() && Features.Last().Points.Num() < 2) Features.Pop(false);
+	};
+
+	for (const FName ID : IDs) {
+		const FLine* Line = Layer.Lines.Find(ID);
+		if (!Line) continue;
+
+		bool bOpen = false;
+		for (int32 Index = 1; Index < Line->Points.Num(); Index++) {
+			FVector2D A = Line->Points[Index - 1];
+			FVector2D B = Line->Points[Index];
+			bool bEntered, bExited;
+			if (!ClipSegment(A, B, Query.Box, bEntered, bExited)) {
+				bOpen = false;
+				continue;
+			}
+
+			if (!bOpen || bEntered) {
+				CloseFeature();
+				Features.Add({Line->CompactID, {}});
+				AddPoint(Features.Last(), A);
+			}
+
+			AddPoint(Features.Last(), B);
+			bOpen = !bExited;
+		}
+		CloseFeature();
+	}
+
+	std::string Out;
+	Out.reserve(32 + Features.Num() * 16);
+	Out.append("FRMT");
+	WriteFixed<uint8>(Out, TileVersion);
+	WriteFixed<uint8>(Out, static_cast<uint8>(LayerType));
+	WriteFixed<uint8>(Out, static_cast<uint8>(Z));
+	WriteFixed<uint8>(Out, 0);
+	WriteFixed<uint32>(Out, X);
+	WriteFixed<uint32>(Out, Y);
+	WriteFixed<uint32>(Out, Layer.Generation);
+	WriteFixed<uint16>(Out, Extent);
+
+	WriteVarint(Out, Features.Num());
+	for (const FFeature& Feature : Features) {
+		WriteVarint(Out, Feature.CompactID);
+		WriteVarint(Out, Feature.Points.Num());
+
+		FIntPoint Cursor(0, 0);
+		for (const FIntPoint& Point : Feature.Points) {
+			WriteZigZag(Out, Point.X - Cursor.X);
+			WriteZigZag(Out, Point.Y - Cursor.Y);
+			Cursor = Point;
+		}
+	}
+
+	return Out;
+}
@@ -0,0 +1,204 @@
+#include "FRM_TimeSlicer.h"
+
+#include "Misc/ScopeLock.h"
+#include "FicsitRemoteMonitoringModule.h"
+#include "FRM_Governor.h"
+
+namespace
+{
+	// frames spanned by the passes of the calling thread, picked up by CallEndpoint for the response headers
+	thread_local int32 PassFrames = 0;
+
+	// set when a pass of the calling thread was cut off, picked up by CallEndpoint to refuse the response
+	thread_local bool PassCutOff = false;
+
+	// innermost FDeferScope of the calling thread
+	thread_local FFRMTimeSlicer::FDeferScope* ActiveDefer = nullptr;
+}
+
+FFRMTimeSlicer::FDeferScope::FDeferScope(FCompleteFunction&& InOnComplete)
+	: OnComplete(MoveTemp(InOnComplete))
+	, Previous(ActiveDefer)
+{
+	ActiveDefer = this;
+}
+
+FFRMTimeSlicer::FDeferScope::~FDeferScope()
+{
+	ActiveDefer = Previous;
+}
+
+void FFRMTimeSlicer::Start(const double InBudget)
+{
+	Stop();
+
+	Budget = FMath::Max(InBudget, 0.0001);
+	{
+		FScopeLock Lock(&Mutex);
+		bRunning = true;
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFRMTimeSlicer::Tick));
+}
+
+void FFRMTimeSlicer::Stop()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	TArray<TSharedPtr<FPass, ESPMode::ThreadSafe>> Abandoned;
+	{
+		FScopeLock Lock(&Mutex);
+		bRunning = false;
+		Abandoned = MoveTemp(Pending);
+	}
+
+	for (const TSharedPtr<FPass, ESPMode::ThreadSafe>& Pass : Abandoned) {
+		Pass->Results.Reset();
+		Pass->bCutOff = true;
+		Finish(*Pass);
+	}
+}
+
+void FFRMTimeSlicer::Finish(FPass& Pass)
+{
+	if (Pass.OnComplete) {
+		Pass.OnComplete(MoveTemp(Pass.Results), Pass.Frames, Pass.bCutOff);
+		Pass.OnComplete.Reset();
+	}
+	else {
+		Pass.Done->Trigger();
+	}
+}
+
+int32 FFRMTimeSlicer::Collect(const FGatherFunction& Gather, const FItemFunction& Item, TArray<TSharedPtr<FJsonValue>>& OutJsonArray)
+{
+	const TSharedRef<FPass, ESPMode::ThreadSafe> Pass = MakeShared<FPass, ESPMode::ThreadSafe>();
+	Pass->Gather = Gather;
+	Pass->Item = Item;
+
+	if (IsInGameThread()) {
+		FRM_TRACE_SCOPE("FRM::TimeSlicer::Inline");
+		Step(*Pass, TNumericLimits<double>::Max());
+	}
+	else {
+		Pass->Audit = FFRMThreadAudit::CurrentContext();
+
+		// the calling loop goes on serving its sockets, the result is handed over once the pass completes
+		FDeferScope* Defer = ActiveDefer && ActiveDefer->OnComplete && !ActiveDefer->bQueued ? ActiveDefer : nullptr;
+
+		{
+			FScopeLock Lock(&Mutex);
+			if (!bRunning) {
+				PassCutOff = true;
+				return 0;
+			}
+
+			if (Defer) {
+				Pass->OnComplete = MoveTemp(Defer->OnComplete);
+				Defer->bQueued = true;
+			}
+			Pending.Add(Pass);
+		}
+
+		if (Defer) {
+			OutJsonArray.Reset();
+			return 0;
+		}
+
+		FRM_TRACE_SCOPE("FRM::TimeSlicer::Wait");
+		Pass->Done->Wait();
+	}
+
+	OutJsonArray = MoveTemp(Pass->Results);
+	PassFrames += Pass->Frames;
+	PassCutOff |= Pass->bCutOff;
+	return Pass->Frames;
+}
+
+int32 FFRMTimeSlicer::TakeFrames()
+{
+	const int32 Frames = PassFrames;
+	PassFrames = 0;
+	return Frames;
+}
+
+bool FFRMTimeSlicer::TakeCutOff()
+{
+	const bool bCutOff = PassCutOff;
+	PassCutOff = false;
+	return bCutOff;
+}
+
+bool FFRMTimeSlicer::Tick(float DeltaTime)
+{
+	const double Deadline = FPlatformTime::Seconds() + Budget;
+
+	TArray<TSharedPtr<FPass, ESPMode::ThreadSafe>> Passes;
+	{
+		FScopeLock Lock(&Mutex);
+		if (Pending.IsEmpty()) return true;
+
+		Passes = Pending;
+	}
+
+	FRM_TRACE_SCOPE("FRM::TimeSlicer::Tick");
+	FFRMGovernor::FScope GovernorScope;
+
+	TArray<TSharedPtr<FPass, ESPMode::ThreadSafe>> Completed;
+	for (const TSharedPtr<FPass, ESPMode::ThreadSafe>& Pass : Passes) {
+		// passes behind the one that used up the budget wait for the next frame
+		if (FPlatformTime::Seconds() >= Deadline) break;
+
+		FFRMThreadAudit::FScope AuditScope(Pass->Audit);
+		if (Step(*Pass, Deadline)) {
+			Completed.Add(Pass);
+		}
+	}
+
+	{
+		FScopeLock Lock(&Mutex);
+		for (const TSharedPtr<FPass, ESPMode::ThreadSafe>& Pass : Completed) {
+			Pending.RemoveSingle(Pass);
+		}
+	}
+
+	for (const TSharedPtr<FPass, ESPMode::ThreadSafe>& Pass : Completed) {
+		Finish(*Pass);
+	}
+
+	return true;
+}
+
+bool FFRMTimeSlicer::Step(FPass& Pass, const double Deadline)
+{
+	Pass.Frames++;
+
+	// the object list cannot be split, a single GetTypedBuildable is cheap next to converting what it returns
+	if (!Pass.bGathered) {
+		TArray<UObject*> Objects;
+		Pass.Gather(Objects);
+
+		Pass.Objects.Reserve(Objects.Num());
+		for (UObject* Object : Objects) {
+			Pass.Objects.Add(Object);
+		}
+
+		Pass.Results.Reserve(Objects.Num());
+		Pass.bGathered = true;
+	}
+
+	while (Pass.Cursor < Pass.Objects.Num()) {
+		if (UObject* Object = Pass.Objects[Pass.Cursor].Get()) {
+			if (TSharedPtr<FJsonValue> Value = Pass.Item(Object)) {
+				Pass.Results.Add(MoveTemp(Value));
+			}
+		}
+
+		Pass.Cursor++;
+
+		if (FPlatformTime::Seconds() >= Deadline) break;
+	}
+
+	return Pass.Cursor >= Pass.Objects.Num();
+}
@@ -3,10 +3,15 @@
 
 #include "FRM_Trains.h"
 
+#include "FRM_NameCache.h"
 #include "FRM_RequestData.h"
+#include "FRM_Request.h"
+#include "FRM_ThreadAudit.h"
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrains(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getTrains");
 
+	FRM_AUDIT_TOUCH("AFGRailroadSubsystem::Get");
 	AFGRailroadSubsystem* RailroadSubsystem = AFGRailroadSubsystem::Get(WorldContext->GetWorld());
 	
 	TArray<AFGTrain*> Trains;
@@ -175,7 +180,9 @@ static FString DockingStatusToString(const ETrainPlatformDockingStatus DockingSt
 }
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainStation(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getTrainStation");
 	TArray<TSharedPtr<FJsonValue>> JTrainStationArray;
+	FRM_AUDIT_TOUCH("AFGRailroadSubsystem::Get");
 	AFGRailroadSubsystem* RailroadSubsystem = AFGRailroadSubsystem::Get(WorldContext);
 	if (!IsValid(RailroadSubsystem)) {
 		return JTrainStationArray;
@@ -245,7 +252,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainStation(UObject* WorldContex
 			TSharedPtr<FJsonObject> JTrainPlatform = UFRM_Library::CreateBaseJsonObject(TrainPlatform);
 
 			JTrainPlatform->Values.Add("Name", MakeShared<FJsonValueString>(TrainPlatform->mDisplayName.ToString()));
-			JTrainPlatform->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(TrainPlatform->GetClass())));
+			JTrainPlatform->Values.Add("ClassName", FFRMNameCache::Find(TrainPlatform->GetClass())->JClassName);
 			JTrainPlatform->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(TrainPlatform)));
 			JTrainPlatform->Values.Add("PowerInfo", MakeShared<FJsonValueObject>(UFRM_Library::getPowerConsumptionJSON(TrainPlatform->GetPowerInfo())));
 			JTrainPlatform->Values.Add("TransferRate", MakeShared<FJsonValueNumber>(CargoTransferRate));
@@ -262,7 +269,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainStation(UObject* WorldContex
 		TSharedPtr<FJsonObject> JTrainStation = UFRM_Library::CreateBaseJsonObject(TrainStation);
 
 		JTrainStation->Values.Add("Name", MakeShared<FJsonValueString>(TrainStation->GetStationName().ToString()));
-		JTrainStation->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(RailStation->GetClass())));
+		JTrainStation->Values.Add("ClassName", FFRMNameCache::Find(RailStation->GetClass())->JClassName);
 		JTrainStation->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(TrainStation)));
 		JTrainStation->Values.Add("TransferRate", MakeShared<FJsonValueNumber>(TransferRate));
 		JTrainStation->Values.Add("InflowRate", MakeShared<FJsonValueNumber>(InFlowRate));
@@ -277,16 +284,29 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainStation(UObject* WorldContex
 	return JTrainStationArray;
 };
 
-TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainRails(UObject* WorldContext, FRequestData RequestData) {
+TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainRails(UObject* WorldContext, FRequestData RequestData, FFRMPolylineCache& Polylines) {
+	FRM_TRACE_SCOPE("FRM::getTrainRails");
+
+	FString LodError;
+	const int32 Lod = FFRMPolylineCache::ParseLod(RequestData.QueryParams, LodError);
+	if (!LodError.IsEmpty()) {
+		return {MakeShared<FJsonValueObject>(UFRM_RequestLibrary::GenerateError(LodError))};
+	}
+
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 
 	TArray<AFGBuildableRailroadTrack*> RailroadTracks;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableRailroadTrack>(RailroadTracks);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableRailroadTrack>(RailroadTracks);
+	}
 	TArray<TSharedPtr<FJsonValue>> JRailroadTrackArray;
 
 	for (AFGBuildableRailroadTrack* RailroadTrack : RailroadTracks) {
 
 		if (!IsValid(RailroadTrack)) { continue; }
+		if (RequestData.IsOutsideArea(RailroadTrack)) { continue; }
 
 		TSharedPtr<FJsonObject> JRailroadTrack = UFRM_Library::CreateBaseJsonObject(RailroadTrack);
 		
@@ -297,13 +317,19 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Trains::getTrainRails(UObject* WorldContext,
 		FVector PointOne = ConnectionOne->GetConnectorLocation();
 		
 		JRailroadTrack->Values.Add("Name", MakeShared<FJsonValueString>(RailroadTrack->mDisplayName.ToString()));
-		JRailroadTrack->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(RailroadTrack->GetClass())));
+		JRailroadTrack->Values.Add("ClassName", FFRMNameCache::Find(RailroadTrack->GetClass())->JClassName);
 		JRailroadTrack->Values.Add("location0", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(ConnectionZero->GetConnectorLocation())));
 		JRailroadTrack->Values.Add("Connected0", MakeShared<FJsonValueBoolean>(ConnectionZero->IsConnected()));
 		JRailroadTrack->Values.Add("location1", MakeShared<FJsonValueObject>(UFRM_Library::ConvertVectorToFJsonObject(ConnectionOne->GetConnectorLocation())));
 		JRailroadTrack->Values.Add("Connected1", MakeShared<FJsonValueBoolean>(ConnectionOne->IsConnected()));
 		JRailroadTrack->Values.Add("Length", MakeShared<FJsonValueNumber>(RailroadTrack->GetLength()));
-		JRailroadTrack->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetActorLineFeaturesJSON(PointZero, PointOne, RailroadTrack->mDisplayName.ToString(), RailroadTrack->mDisplayName.ToString())));
+
+		// with ?lod= the feature follows the track's curve instead of the chord between its ends
+		TArray<FVector> Points;
+		if (Lod == INDEX_NONE || !Polylines.Get(RailroadTrack, Lod, Points)) {
+			Points = {PointZero, PointOne};
+		}
+		JRailroadTrack->Values.Add("features", MakeShared<FJsonValueObject>(UFRM_Library::GetActorLineFeaturesJSON(Points, RailroadTrack->mDisplayName.ToString(), RailroadTrack->mDisplayName.ToString())));
 
 		JRailroadTrackArray.Add(MakeShared<FJsonValueObject>(JRailroadTrack));
 
@@ -1,10 +1,17 @@
 #include "FRM_Vehicles.h"
+#include "FRM_NameCache.h"
+#include "FRM_ThreadAudit.h"
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Vehicles::getTruckStation(UObject* WorldContext) {
+	FRM_TRACE_SCOPE("FRM::getTruckStation");
 
+	FRM_AUDIT_TOUCH("AFGBuildableSubsystem::Get");
 	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(WorldContext->GetWorld());
 	TArray<AFGBuildableDockingStation*> Buildables;
-	BuildableSubsystem->GetTypedBuildable<AFGBuildableDockingStation>(Buildables);
+	{
+		FRM_ENGINE_SCOPE("FRM::GetTypedBuildable");
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableDockingStation>(Buildables);
+	}
 
 	TArray<TSharedPtr<FJsonValue>> JTruckStationArray;
 
@@ -74,7 +81,9 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Vehicles::getTruckStation(UObject* WorldCont
 };
 
 TArray<TSharedPtr<FJsonValue>> UFRM_Vehicles::getVehicles(UObject* WorldContext, UClass* VehicleClass) {
+	FRM_TRACE_SCOPE("FRM::getVehicles");
 	
+	FRM_AUDIT_TOUCH("AFGVehicleSubsystem::Get");
 	AFGVehicleSubsystem* VehicleSubsystem = AFGVehicleSubsystem::Get(WorldContext);
 	TArray<AFGVehicle*> Vehicles = VehicleSubsystem->GetVehicles();
 	TArray<TSharedPtr<FJsonValue>> JVehicleArray;
@@ -149,7 +158,7 @@ TArray<TSharedPtr<FJsonValue>> UFRM_Vehicles::getVehicles(UObject* WorldContext,
 			//FString PathName = VehiclePath->mPathName;
 
 			JVehicle->Values.Add("Name", MakeShared<FJsonValueString>(Vehicle->mDisplayName.ToString()));
-			JVehicle->Values.Add("ClassName", MakeShared<FJsonValueString>(UKismetSystemLibrary::GetClassDisplayName(Vehicle->GetClass())));
+			JVehicle->Values.Add("ClassName", FFRMNameCache::Find(Vehicle->GetClass())->JClassName);
 			JVehicle->Values.Add("location", MakeShared<FJsonValueObject>(UFRM_Library::getActorJSON(Vehicle)));
 			JVehicle->Values.Add("PathName", MakeShared<FJsonValueString>("PathName"));
 			JVehicle->Values.Add("Status", MakeShared<FJsonValueString>(FormString));
@@ -2,12 +2,15 @@
 #include "FGResearchTree.h"
 #include "FGSchematicCategory.h"
 #include <FicsitRemoteMonitoring.h>
+#include "FRM_ThreadAudit.h"
 
 TArray<TSharedPtr<FJsonValue>> UFRM_World::GetResearchTrees(UObject* WorldContext)
 {
+	FRM_TRACE_SCOPE("FRM::GetResearchTrees");
 	TArray<TSharedPtr<FJsonValue>> JResearchTrees;
 
 	// get the research manager
+	FRM_AUDIT_TOUCH("AFGResearchManager::Get");
 	const auto ResearchManager = AFGResearchManager::Get(WorldContext);
 	if (!ResearchManager) return JResearchTrees;
 
@@ -0,0 +1,113 @@
+#include "FRM_WorldSnapshot.h"
+
+#include "FGBuildableSubsystem.h"
+#include "FGFactoryConnectionComponent.h"
+#include "Buildables/FGBuildableConveyorBase.h"
+#include "Buildables/FGBuildableStorage.h"
+#include "Misc/ScopeRWLock.h"
+#include "FRM_Library.h"
+#include "FRM_NameCache.h"
+#include "FRM_Polylines.h"
+#include "FRM_ThreadAudit.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+TSharedRef<const FFRMWorldSnapshot, ESPMode::ThreadSafe> FFRMWorldSnapshot::Build(UWorld* World, FFRMPolylineCache& Polylines, const uint32 Sequence)
+{
+	FRM_TRACE_SCOPE("FRM::WorldSnapshot::Build");
+
+	TSharedRef<FFRMWorldSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FFRMWorldSnapshot, ESPMode::ThreadSafe>();
+	Snapshot->Sequence = Sequence;
+	Snapshot->GameTime = World->GetTimeSeconds();
+
+	AFGBuildableSubsystem* BuildableSubsystem = AFGBuildableSubsystem::Get(World);
+	if (!BuildableSubsystem) return Snapshot;
+
+	{
+		FRM_TRACE_SCOPE("FRM::WorldSnapshot::Belts");
+
+		TArray<AFGBuildableConveyorBase*> ConveyorBelts;
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableConveyorBase>(ConveyorBelts);
+
+		Snapshot->Belts.Reserve(ConveyorBelts.Num());
+		for (AFGBuildableConveyorBase* ConveyorBelt : ConveyorBelts) {
+			if (!IsValid(ConveyorBelt)) continue;
+
+			const UFGFactoryConnectionComponent* ConnectionZero = ConveyorBelt->GetConnection0();
+			const UFGFactoryConnectionComponent* ConnectionOne = ConveyorBelt->GetConnection1();
+			if (!ConnectionZero || !ConnectionOne) continue;
+
+			FFRMBeltRow& Row = Snapshot->Belts.AddDefaulted_GetRef();
+			Row.ID = ConveyorBelt->GetFName();
+			Row.Key = FObjectKey(ConveyorBelt);
+			Row.Name = ConveyorBelt->mDisplayName.ToString();
+			Row.ClassName = FFRMNameCache::Find(ConveyorBelt->GetClass())->ClassName;
+			Row.Location = ConveyorBelt->GetActorLocation();
+			Row.Location0 = ConnectionZero->GetRelativeTransform().GetTranslation();
+			Row.Location1 = ConnectionOne->GetRelativeTransform().GetTranslation();
+			Row.bConnected0 = ConnectionZero->IsConnected();
+			Row.bConnected1 = ConnectionOne->IsConnected();
+			Row.Length = ConveyorBelt->GetLength();
+			Row.Speed = ConveyorBelt->GetSpeed();
+
+			// a no-op for every belt seen before, buildables never move
+			Polylines.Prepare(ConveyorBelt);
+		}
+	}
+
+	{
+		FRM_TRACE_SCOPE("FRM::WorldSnapshot::Storages");
+
+		TArray<AFGBuildableStorage*> StorageContainers;
+		BuildableSubsystem->GetTypedBuildable<AFGBuildableStorage>(StorageContainers);
+
+		Snapshot->Storages.Reserve(StorageContainers.Num());
+		Snapshot->WorldInventory.Amounts.SetNumZeroed(FFRMItemRegistry::Get().Num());
+		for (AFGBuildableStorage* StorageContainer : StorageContainers) {
+			if (!IsValid(StorageContainer)) continue;
+
+			FFRMStorageRow& Row = Snapshot->Storages.AddDefaulted_GetRef();
+			Row.ID = StorageContainer->GetFName();
+			Row.Name = StorageContainer->mDisplayName.ToString();
+			Row.ClassName = FFRMNameCache::Find(StorageContainer->GetClass())->ClassName;
+			Row.Location = StorageContainer->GetActorLocation();
+			Row.Yaw = StorageContainer->GetActorRotation().Yaw;
+			UFRM_Library::GetGroupedInventoryItems(StorageContainer->GetStorageInventory(), Row.Inventory);
+			Snapshot->WorldInventory.Add(Row.Inventory);
+		}
+	}
+
+	return Snapshot;
+}
+
+void FFRMSnapshotStore::Publish(const TSharedRef<const FFRMWorldSnapshot, ESPMode::ThreadSafe>& Snapshot)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Current = Snapshot;
+}
+
+void FFRMSnapshotStore::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Current.Reset();
+}
+
+TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> FFRMSnapshotStore::Get() const
+{
+	FRM_AUDIT_CACHE("FFRMSnapshotStore");
+	LastRead.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+
+	FReadScopeLock ReadLock(Lock);
+	return Current;
+}
+
+bool FFRMSnapshotStore::IsWanted(const double IdleSeconds) const
+{
+	const double Read = LastRead.load(std::memory_order_relaxed);
+	return Read > 0.0 && FPlatformTime::Seconds() - Read <= IdleSeconds;
+}
+
+uint32 FFRMSnapshotStore::GetNextSequence() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Current.IsValid() ? Current->Sequence + 1 : 1;
+}
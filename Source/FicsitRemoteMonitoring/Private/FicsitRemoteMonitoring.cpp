@@ -1,12 +1,96 @@
 #include "FicsitRemoteMonitoring.h"
 #include "Async/Async.h"
 #include "FRM_Request.h"
+#include "FRM_Metrics.h"
+#include "FRM_ThreadAudit.h"
+#include "FRM_Governor.h"
+#include "FRM_AccessLog.h"
+#include "FRM_RateLimiter.h"
+#include "FRM_Scheduler.h"
+#include "FRM_NameCache.h"
+#include "FRM_JsonWriter.h"
 
 us_listen_socket_t* SocketListener;
-bool SocketRunning = false;
+
+// Server loop threads that have been launched and not finished yet, counted from launch so a stop can never miss one
+std::atomic<int32> SocketRunning = 0;
+
+// Event loop serving HTTP/WebSocket clients; the loop without a keep-alive timer owns the listen socket
+struct FServerLoop
+{
+    uWS::App* App;
+    uWS::Loop* Loop;
+    us_timer_t* KeepAlive;
+    us_listen_socket_t* ListenSocket;
+};
+
+TArray<FServerLoop> ServerLoops;
+FCriticalSection ServerLoopsLock;
+std::atomic<uint32> NextServerLoop = 0;
+
+std::atomic<uint64> NextClientID = 1;
+
+// Set by StopWebSocketServer under ServerLoopsLock, a loop that registers afterwards shuts down instead of running
+bool bServerLoopsStopped = false;
+
+// Closes everything that keeps a loop running, has to run on that loop
+void CloseServerLoop(const FServerLoop& ServerLoop)
+{
+    // App->close() would close it as well, the listen socket is closed first so no connection is accepted in between
+    if (ServerLoop.ListenSocket) {
+        us_listen_socket_close(0, ServerLoop.ListenSocket);
+    }
+
+    ServerLoop.App->close();
+
+    if (ServerLoop.KeepAlive) {
+        us_timer_close(ServerLoop.KeepAlive);
+    }
+}
+
+// Runs Callback on Loop unless the loop is stopping, a loop that left ServerLoops may already be gone
+bool DeferToServerLoop(uWS::Loop* Loop, uWS::MoveOnlyFunction<void()>&& Callback)
+{
+    FScopeLock Lock(&ServerLoopsLock);
+
+    if (!Loop || !ServerLoops.ContainsByPredicate([Loop](const FServerLoop& ServerLoop) { return ServerLoop.Loop == Loop; })) {
+        return false;
+    }
+
+    Loop->defer(std::move(Callback));
+    return true;
+}
+
+// preOpen handler of the accepting loop, hands accepted sockets round-robin to all running loops
+LIBUS_SOCKET_DESCRIPTOR DistributeAcceptedSocket(LIBUS_SOCKET_DESCRIPTOR Socket)
+{
+    FScopeLock Lock(&ServerLoopsLock);
+
+    if (ServerLoops.Num() < 2) return Socket;
+
+    const FServerLoop& Target = ServerLoops[NextServerLoop++ % ServerLoops.Num()];
+
+    // sockets assigned to the accepting loop are kept without a round trip through the defer queue
+    if (Target.Loop == uWS::Loop::get()) return Socket;
+
+    uWS::App* App = Target.App;
+    Target.Loop->defer([App, Socket]() {
+        App->adoptSocket(Socket);
+    });
+
+    return (LIBUS_SOCKET_DESCRIPTOR) -1;
+}
+
+int32 GetServerLoopCount()
+{
+    // leave most cores to the game itself
+    return FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() / 2, 1, 4);
+}
 
 AFicsitRemoteMonitoring* AFicsitRemoteMonitoring::Get(UWorld* WorldContext)
 {
+	FRM_AUDIT_TOUCH("TActorIterator");
+
 	for (TActorIterator<AFicsitRemoteMonitoring> It(WorldContext, AFicsitRemoteMonitoring::StaticClass(), EActorIteratorFlags::AllActors); It; ++It) {
 		AFicsitRemoteMonitoring* CurrentActor = *It;
 		return CurrentActor;
@@ -32,6 +116,15 @@ void AFicsitRemoteMonitoring::BeginPlay()
 
     // Load FRM's API Endpoints
     InitAPIRegistry();
+    FFRMItemRegistry::Get().Build();
+    FFRMPowerGraph::InstallHooks();
+    FFRMProductionTracker::InstallHooks();
+    ProductionTracker.Start(GetWorld());
+    EntityIndex.Start(GetWorld());
+    EntityIndex.RefreshSpatial();
+    TileCache.Start(GetWorld(), EntityIndex);
+    Polylines.Start(GetWorld());
+    Snapshots.Publish(FFRMWorldSnapshot::Build(GetWorld(), Polylines, Snapshots.GetNextSequence()));
 
     // If true, autostart web server/socket
     auto WSconfig = FConfig_HTTPStruct::GetActiveConfig(GetWorld());
@@ -60,6 +153,60 @@ void AFicsitRemoteMonitoring::BeginPlay()
         true          // Whether to loop the timer (true = repeating)
     );
 
+    // moving entities are sampled into the spatial index, everything else is placed once, as are new map tile lines
+    world->GetTimerManager().SetTimer(SpatialTimerHandle, FTimerDelegate::CreateWeakLambda(this, [this]() {
+        FFRMGovernor::FScope GovernorScope;
+        EntityIndex.RefreshSpatial();
+        TileCache.Refresh();
+    }), 1.0f, true);
+
+    HistoryMetricsIndex = FFRMMetrics::Get().RegisterEndpoint("history");
+    TilesMetricsIndex = FFRMMetrics::Get().RegisterEndpoint("tiles");
+    History.Reset(FMath::CeilToInt32(HistoryRetention / HistorySampleInterval));
+    world->GetTimerManager().SetTimer(HistoryTimerHandle, this, &AFicsitRemoteMonitoring::SampleHistory, HistorySampleInterval, true);
+
+    if (bPersistHistory) {
+        FString SessionName;
+        if (const AFGGameState* GameState = world->GetGameState<AFGGameState>()) {
+            SessionName = FPaths::MakeValidFileName(GameState->GetSessionName());
+        }
+
+        HistoryStore.Start(FPaths::ProjectDir() + "Mods/FicsitRemoteMonitoring/History/" + (SessionName.IsEmpty() ? TEXT("Default") : *SessionName), FFRMHistoryStoreSettings());
+    }
+
+    FrameTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](const float DeltaTime) {
+        FFRMMetrics::Get().RecordFrame(DeltaTime);
+        return true;
+    }));
+
+    // captured every few frames, pushed at most ten times a second
+    TelemetryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &AFicsitRemoteMonitoring::TickTelemetry));
+
+    SnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &AFicsitRemoteMonitoring::TickSnapshot));
+
+    TimeSlicer.Start(TimeSliceBudget);
+
+    FFRMGovernor::Get().Start(FFRMGovernorSettings());
+
+    FFRMRateLimiter::Get().Start(FFRMRateLimitSettings());
+
+    FFRMScheduler::Get().Start(FFRMSchedulerSettings());
+
+    // catalogs only change with progress, they are warmed up one per frame and then served without the game thread
+    Catalogs.Register("getRecipes", true, [this]() { return UFRM_Production::getRecipes(this); });
+    Catalogs.Register("getSchematics", true, [this]() { return UFRM_Production::getSchematics(this); });
+    Catalogs.Register("getResearchTrees", true, [this]() { return UFRM_World::GetResearchTrees(this); });
+    Catalogs.Register("getSinkList", false, [this]() { return UFRM_Production::getSinkList(this); });
+    Catalogs.Register("getModList", false, [this]() { return UFRM_Factory::getModList(this, FRequestData()); });
+    Catalogs.Start(JSONDebugMode);
+
+    if (AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(world)) {
+        SchematicManager->PurchasedSchematicDelegate.AddDynamic(this, &AFicsitRemoteMonitoring::OnProgressChanged);
+    }
+    if (AFGResearchManager* ResearchManager = AFGResearchManager::Get(world)) {
+        ResearchManager->ResearchCompletedDelegate.AddDynamic(this, &AFicsitRemoteMonitoring::OnProgressChanged);
+    }
+
 	// Register the callback to ensure WebSocket is stopped on crash/exit
 	FCoreDelegates::OnExit.AddUObject(this, &AFicsitRemoteMonitoring::StopWebSocketServer);
 }
@@ -69,44 +216,85 @@ void AFicsitRemoteMonitoring::EndPlay(const EEndPlayReason::Type EndPlayReason)
     // clear the timer
     UWorld* world = GetWorld();
     world->GetTimerManager().ClearTimer(TimerHandle);
+    world->GetTimerManager().ClearTimer(HistoryTimerHandle);
+    world->GetTimerManager().ClearTimer(SpatialTimerHandle);
+    HistoryStore.Stop();
+    TileCache.Stop();
+    Polylines.Stop();
+    EntityIndex.Stop();
+    ProductionTracker.Stop();
+    FTSTicker::GetCoreTicker().RemoveTicker(FrameTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(TelemetryTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(SnapshotTickerHandle);
+    if (TelemetryPush.IsValid()) {
+        TelemetryPush.Wait();
+    }
+    Telemetry.Reset();
+    Snapshots.Reset();
+    TimeSlicer.Stop();
+    FFRMGovernor::Get().Stop();
+    FFRMRateLimiter::Get().Stop();
+    FFRMScheduler::Get().Stop();
+    Catalogs.Stop();
+
+    if (AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(world)) {
+        SchematicManager->PurchasedSchematicDelegate.RemoveDynamic(this, &AFicsitRemoteMonitoring::OnProgressChanged);
+    }
+    if (AFGResearchManager* ResearchManager = AFGResearchManager::Get(world)) {
+        ResearchManager->ResearchCompletedDelegate.RemoveDynamic(this, &AFicsitRemoteMonitoring::OnProgressChanged);
+    }
 
 	// Ensure the server is stopped during normal gameplay exit
 	StopWebSocketServer();
+	FFRMAccessLog::Get().Stop();
 	Super::EndPlay(EndPlayReason);
 }
 
+void AFicsitRemoteMonitoring::OnProgressChanged(TSubclassOf<UFGSchematic> Schematic)
+{
+    Catalogs.Invalidate();
+}
+
 void AFicsitRemoteMonitoring::StopWebSocketServer()
 {
     // Signal the WebSocket server to stop
-    if (WebServer.IsValid())
-    {
-        WebServer.Reset();
-    }
+    WebServers.Empty();
 
-    // Close WebSocket listener
+    // the listen socket itself is closed on its own loop below
     if (SocketListener)
     {
         UE_LOGFMT(LogHttpServer, Log, "Stopping uWS listener");
-        us_listen_socket_close(0, SocketListener);
         SocketListener = nullptr;
+    }
 
+    {
+        FScopeLock Lock(&ClientsLock);
         UE_LOG(LogHttpServer, Log, TEXT("Closing all %d connections"), ConnectedClients.Num());
-        for (const auto ConnectedClient : ConnectedClients)
-        {
-            ConnectedClient->close();
-        }
-        ConnectedClients.Empty();
+
+        // clear endpoint subscribers
+        EndpointSubscribers.Empty();
+    }
+
+    // Every loop closes its own sockets; a loop returns from run() once its listener, clients and keep-alive timer are gone.
+    // The lock is held while deferring so no loop can be torn down in between, loops that have not registered yet see the flag.
+    FScopeLock Lock(&ServerLoopsLock);
+    bServerLoopsStopped = true;
+    for (const FServerLoop& ServerLoop : ServerLoops)
+    {
+        ServerLoop.Loop->defer([ServerLoop]() {
+            CloseServerLoop(ServerLoop);
+        });
     }
+    ServerLoops.Empty();
 
-    // clear endpoint subscribers
-    EndpointSubscribers.Empty();
+    ResponseCache.Empty();
 }
 
 void AFicsitRemoteMonitoring::StartWebSocketServer() 
 {
     UE_LOGFMT(LogHttpServer, Warning, "Initializing WebSocket Service");
 
-    if (SocketRunning)
+    if (SocketRunning > 0)
     {
         UE_LOG(LogHttpServer, Log, TEXT("Old Websocket Thread is still running, try again in 3 seconds..."));
 
@@ -124,223 +312,307 @@ void AFicsitRemoteMonitoring::StartWebSocketServer()
         return;
     }
 
-        // WebSocket server logic runs in a separate thread
-        WebServer = Async(EAsyncExecution::Thread, [this]() {
-            try {
-                auto app = uWS::App();
-                auto World = GetWorld();
-                auto config = FConfig_HTTPStruct::GetActiveConfig(World);
+    // read the config on the game thread, the loops only get a copy
+    const auto config = FConfig_HTTPStruct::GetActiveConfig(GetWorld());
+    const int32 LoopCount = GetServerLoopCount();
+
+    FFRMAccessLog::Get().Start(FPaths::ProjectDir() + "Mods/FicsitRemoteMonitoring/Logs/access.log", FFRMAccessLogSettings());
+
+    UE_LOG(LogHttpServer, Log, TEXT("Starting %d web server loop(s)"), LoopCount);
+
+    // every loop of the previous server has finished, nothing can register before this
+    {
+        FScopeLock Lock(&ServerLoopsLock);
+        bServerLoopsStopped = false;
+    }
+
+    // WebSocket server logic runs in separate threads, one uWS event loop each
+    for (int32 LoopIndex = 0; LoopIndex < LoopCount; LoopIndex++)
+    {
+        SocketRunning++;
+        WebServers.Add(Async(EAsyncExecution::Thread, [this, config, LoopIndex, LoopCount]() {
+            RunServerLoop(config, LoopIndex, LoopCount);
+            SocketRunning--;
+        }));
+    }
+}
+
+void AFicsitRemoteMonitoring::RunServerLoop(const FConfig_HTTPStruct Config, const int32 LoopIndex, const int32 LoopCount)
+{
+    try {
+        auto app = uWS::App();
+
+        FString ModPath = FPaths::ProjectModsDir() + "FicsitRemoteMonitoring/";
+        FString IconsPath = ModPath + "Icons";
+        FString UIPath;
+
+        if (Config.Web_Root.IsEmpty()) {
+            UIPath = ModPath + "www";
+        }
+        else
+        {
+            UIPath = Config.Web_Root;
+        };
+
+        int port = Config.HTTP_Port;
+
+        RegisterRoutes(app, UIPath, IconsPath);
+
+        us_timer_t* KeepAlive = nullptr;
+        us_listen_socket_t* ListenSocket = nullptr;
+
+        if (LoopIndex == 0)
+        {
+            // the first loop accepts every connection and spreads them over all loops
+            if (LoopCount > 1) {
+                app.preOpen(&DistributeAcceptedSocket);
+            }
+
+            app.listen(port, [port, &ListenSocket](us_listen_socket_t* token) {
 
-                FString ModPath = FPaths::ProjectModsDir() + "FicsitRemoteMonitoring/";
-                FString IconsPath = ModPath + "Icons";
-                FString UIPath;
+                UE_LOG(LogHttpServer, Warning, TEXT("Attempting to listen on port %d"), port);
 
-                if (config.Web_Root.IsEmpty()) {
-                    UIPath = ModPath + "www";
+                if (token) {
+                    SocketListener = token;
+                    ListenSocket = token;
+                    UE_LOGFMT(LogHttpServer, Warning, "Listening on port {port}", port);
                 }
-                else
-                {
-                    UIPath = config.Web_Root;
-                };
-
-                int port = config.HTTP_Port;
-
-                // Define WebSocket behavior
-                uWS::App::WebSocketBehavior<FWebSocketUserData> wsBehavior;
-
-                wsBehavior.compression = uWS::SHARED_COMPRESSOR;
-
-                // Close handler (for when a client disconnects)
-                wsBehavior.close = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws, int code, std::string_view message) {
-                    ConnectedClients.Remove(ws);
-                    UE_LOG(LogHttpServer, Log, TEXT("Client Disconnected. Remaining connections: %d"), ConnectedClients.Num());
-                    OnClientDisconnected(ws, code, message);  // Ensure this signature matches
-                };
-
-                // Message handler (for when a client sends a message)
-                wsBehavior.message = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws, std::string_view message, uWS::OpCode opCode) {
-                    OnMessageReceived(ws, message, opCode);  // Make sure this signature matches
-                };
-
-                wsBehavior.open = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws)
-                {
-                    ConnectedClients.Add(ws);
-                    UE_LOG(LogHttpServer, Log, TEXT("Client Disconnected. Connections: %d"), ConnectedClients.Num());
-                };
-
-                app.get("/getCoffee", [this](auto* res, auto* req) {
-                    if (!res || !req) {
-                        UE_LOG(LogHttpServer, Error, TEXT("Invalid request or response pointer!"));
-                        return;
-                    }
-
-                    FString noCoffee = TEXT("Error getting coffee, coffee cup, or red solo cup: (418) I'm a teapot."
-                        "#PraiseAlpaca"
-                        "#BlameSimon");
-
-                    // Set CORS headers
-                    res->writeStatus("418 I'm a teapot");
-                    res->writeHeader("Access-Control-Allow-Methods", "GET, POST");
-                    res->writeHeader("Access-Control-Allow-Headers", "Content-Type");
-                    UFRM_RequestLibrary::AddResponseHeaders(res, false);
-
-                    res->end(TCHAR_TO_UTF8(*noCoffee));
-                });
+                else {
+                    UE_LOGFMT(LogHttpServer, Error, "Failed to listen on port {port}", port);
+                }
+            });
+        }
+        else
+        {
+            // worker loops own no listen socket, this timer keeps them alive until the server is stopped
+            KeepAlive = us_create_timer((us_loop_t*) app.getLoop(), 0, 0);
+            us_timer_set(KeepAlive, [](us_timer_t*) {}, 60000, 60000);
+        }
 
-                app.get("/", [](auto* res, auto* req) {
-                    res->writeStatus("301 Moved Permanently")->writeHeader("Location", "/index.html")->end();
-                });
+        {
+            FScopeLock Lock(&ServerLoopsLock);
+
+            // the server was stopped while this loop was starting up, no stop request will ever reach it
+            if (bServerLoopsStopped) {
+                if (LoopIndex == 0) {
+                    SocketListener = nullptr;
+                }
+                CloseServerLoop({&app, app.getLoop(), KeepAlive, ListenSocket});
+            }
+            else {
+                ServerLoops.Add({&app, app.getLoop(), KeepAlive, ListenSocket});
+            }
+        }
 
-                /* This exists incase the root is redirected from default */
-                app.get("/Icons/*", [this, IconsPath](auto* res, auto* req) {
+        // returns right away after a late stop, the loop has nothing left to wait for
+        app.run();
 
-                    std::string url(req->getUrl().begin(), req->getUrl().end());
+        {
+            FScopeLock Lock(&ServerLoopsLock);
+            ServerLoops.RemoveAll([&app](const FServerLoop& ServerLoop) { return ServerLoop.App == &app; });
+        }
 
-                    // Remove initial '/Icons/'
-                    FString RelativePath = FString(url.c_str()).Mid(7);
-                    FString FilePath = FPaths::Combine(IconsPath, RelativePath);
+        UE_LOG(LogHttpServer, Log, TEXT("WebSocket Server Thread %d finished."), LoopIndex);
+    } catch (const std::exception& e) {
+        UE_LOG(LogHttpServer, Error, TEXT("WebSocket Server Exception: %s"), *FString(e.what()));
+    } catch (...) {
+        UE_LOG(LogHttpServer, Error, TEXT("Unknown Exception in WebSocket Server"));
+    }
+}
 
-                    UE_LOG(LogHttpServer, Log, TEXT("Request RelativePath: %s"), *RelativePath);
-                    UE_LOG(LogHttpServer, Log, TEXT("Request FilePath: %s"), *FilePath);
+void AFicsitRemoteMonitoring::RegisterRoutes(uWS::App& app, const FString& UIPath, const FString& IconsPath)
+{
+    auto World = GetWorld();
 
-                    if (!res || !req) {
-                        UE_LOG(LogHttpServer, Error, TEXT("Invalid request or response pointer!"));
-                        return;
-                    }
+    // Define WebSocket behavior
+    uWS::App::WebSocketBehavior<FWebSocketUserData> wsBehavior;
 
-                    if (FPaths::FileExists(FilePath)) {
-                        HandleGetRequest(res, req, FilePath);
-                    	return;
-                    }
+    wsBehavior.compression = uWS::SHARED_COMPRESSOR;
 
-                	UFRM_RequestLibrary::SendErrorJson(res, "404 Not Found", "");
-                });
+    // Close handler (for when a client disconnects)
+    wsBehavior.close = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws, int code, std::string_view message) {
+        FFRMMetrics::Get().RecordBackpressure(-ws->getUserData()->BufferedAmount);
 
-                app.get("/api/:APIEndpoint", [this, World](auto* res, auto* req) {
-                    std::string url(req->getParameter("APIEndpoint"));
-                    FString Endpoint = FString(url.c_str());
+        FScopeLock Lock(&ClientsLock);
+        ConnectedClients.Remove(ws->getUserData()->ClientID);
+        UE_LOG(LogHttpServer, Log, TEXT("Client Disconnected. Remaining connections: %d"), ConnectedClients.Num());
+        OnClientDisconnected(ws, code, message);  // Ensure this signature matches
+    };
 
-                    // Log the request URL
-                    UE_LOGFMT(LogHttpServer, Log, "Request URL: {0}", Endpoint);
+    // Message handler (for when a client sends a message)
+    wsBehavior.message = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws, std::string_view message, uWS::OpCode opCode) {
+        OnMessageReceived(ws, message, opCode);  // Make sure this signature matches
+    };
 
-                	FRequestData RequestData;
-                    HandleApiRequest(World, res, req, Endpoint, RequestData);
-                });
+    // Drain handler (for when buffered data could be flushed to a slow client)
+    wsBehavior.drain = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws) {
+        UpdateBackpressure(ws);
+    };
 
-            	app.options("/*", [this, World](auto* res, uWS::HttpRequest* req)
+    wsBehavior.open = [this](uWS::WebSocket<false, true, FWebSocketUserData>* ws)
+    {
+        ws->getUserData()->Loop = uWS::Loop::get();
+        ws->getUserData()->ClientID = NextClientID++;
+
+        FScopeLock Lock(&ClientsLock);
+        ConnectedClients.Add(ws->getUserData()->ClientID, ws);
+        UE_LOG(LogHttpServer, Log, TEXT("Client Connected. Connections: %d"), ConnectedClients.Num());
+    };
+
+    app.get("/getCoffee", [this](auto* res, auto* req) {
+        if (!res || !req) {
+            UE_LOG(LogHttpServer, Error, TEXT("Invalid request or response pointer!"));
+            return;
+        }
+
+        FString noCoffee = TEXT("Error getting coffee, coffee cup, or red solo cup: (418) I'm a teapot."
+            "#PraiseAlpaca"
+            "#BlameSimon");
+
+        // Set CORS headers
+        res->writeStatus("418 I'm a teapot");
+        res->writeHeader("Access-Control-Allow-Methods", "GET, POST");
+        res->writeHeader("Access-Control-Allow-Headers", "Content-Type");
+        UFRM_RequestLibrary::AddResponseHeaders(res, false);
+
+        res->end(TCHAR_TO_UTF8(*noCoffee));
+    });
+
+    app.get("/metrics", [this](auto* res, auto* req) {
+        HandleMetricsRequest(res);
+    });
+
+    app.get("/api/history", [this](auto* res, auto* req) {
+        HandleHistoryRequest(res, req);
+    });
+
+    app.get("/api/history/*", [this](auto* res, auto* req) {
+        HandleHistoryRequest(res, req);
+    });
+
+    app.get("/tiles/*", [this](auto* res, auto* req) {
+        HandleTileRequest(res, req);
+    });
+
+    app.get("/", [](auto* res, auto* req) {
+        res->writeStatus("301 Moved Permanently")->writeHeader("Location", "/index.html")->end();
+    });
+
+    /* This exists incase the root is redirected from default */
+    app.get("/Icons/*", [this, IconsPath](auto* res, auto* req) {
+
+        std::string url(req->getUrl().begin(), req->getUrl().end());
+
+        // Remove initial '/Icons/'
+        FString RelativePath = FString(url.c_str()).Mid(7);
+        FString FilePath = FPaths::Combine(IconsPath, RelativePath);
+
+        if (!res || !req) {
+            UE_LOG(LogHttpServer, Error, TEXT("Invalid request or response pointer!"));
+            return;
+        }
+
+        if (FPaths::FileExists(FilePath)) {
+            HandleGetRequest(res, req, FilePath);
+        	return;
+        }
+
+    	FFRMAccessLog::Get().Record(res->getRemoteAddress(), "GET", req->getUrl(), req->getQuery(), 404, 0);
+    	UFRM_RequestLibrary::SendErrorJson(res, "404 Not Found", "");
+    });
+
+    app.get("/api/:APIEndpoint", [this, World](auto* res, auto* req) {
+        std::string url(req->getParameter("APIEndpoint"));
+        FString Endpoint = FString(url.c_str());
+
+    	FRequestData RequestData;
+        HandleApiRequest(World, res, req, Endpoint, RequestData);
+    });
+
+	app.options("/*", [this, World](auto* res, uWS::HttpRequest* req)
+	{
+		UFRM_RequestLibrary::AddResponseHeaders(res, false);
+		res->writeHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS")
+			->writeHeader("Access-Control-Allow-Headers", "Content-Type, Authorization");
+		res->end();
+	});
+	
+	app.post("/*", [this, World](auto* res, uWS::HttpRequest* req)
+	{
+        const std::string URL(req->getUrl().begin(), req->getUrl().end());
+		FString RelativePath = FString(URL.c_str()).Mid(1);
+
+		res->onData([this, res, req, World, RelativePath](const std::string_view data, bool)
+		{
+            try
+            {
+	            const std::string PostData(data);
+	            const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(PostData.c_str()));
+            	TSharedPtr<FJsonValue> JsonValue;
+
+            	if (!FJsonSerializer::Deserialize(Reader, JsonValue) || !JsonValue.IsValid())
             	{
-            		UFRM_RequestLibrary::AddResponseHeaders(res, false);
-            		res->writeHeader("Access-Control-Allow-Methods", "GET, POST, OPTIONS")
-            			->writeHeader("Access-Control-Allow-Headers", "Content-Type, Authorization");
-            		res->end();
-            	});
+            		return UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
+            	}
+
+            	FRequestData RequestData;
+            	RequestData.Method = "POST";
             	
-            	app.post("/*", [this, World](auto* res, uWS::HttpRequest* req)
+            	if (JsonValue->Type == EJson::Array)
             	{
-		            const std::string URL(req->getUrl().begin(), req->getUrl().end());
-					FString RelativePath = FString(URL.c_str()).Mid(1);
-
-            		res->onData([this, res, req, World, RelativePath](const std::string_view data, bool)
-            		{
-			            try
-			            {
-				            const std::string PostData(data);
-				            const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(PostData.c_str()));
-			            	TSharedPtr<FJsonValue> JsonValue;
-
-			            	if (!FJsonSerializer::Deserialize(Reader, JsonValue) || !JsonValue.IsValid())
-			            	{
-			            		return UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
-			            	}
-
-			            	FRequestData RequestData;
-			            	RequestData.Method = "POST";
-			            	
-			            	if (JsonValue->Type == EJson::Array)
-			            	{
-			            		RequestData.Body = JsonValue->AsArray();
-							}
-			            	else if (JsonValue->Type == EJson::Object)
-			            	{
-			            		RequestData.Body.Add(JsonValue);
-							}
-			            	else
-			            	{
-			            		return UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
-			            	}
-
-			            	HandleApiRequest(World, res, req, RelativePath, RequestData);
-			            }
-			            catch (const std::exception &e)
-			            {
-			            	UE_LOG(LogHttpServer, Error, TEXT("Request Exception: %s"), *e.what());
-			            	UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
-			            }
-            		});
-
-            		res->onAborted([]() {});
-            	});
-
-                app.get("/*", [UIPath, this, World](auto* res, uWS::HttpRequest* req) {
-                    if (!res) return;
-
-                    std::string url(req->getUrl().begin(), req->getUrl().end());
-                    
-                    bool bFileExists = false;
-                    // Remove initial '/'
-                    FString RelativePath = FString(url.c_str()).Mid(1);
-                    FString FilePath = FPaths::Combine(UIPath, RelativePath);
-                    FString FileContent;
-                    bool IsBinary = false; // to flag non-text files (e.g., images)
-
-                    UE_LOG(LogHttpServer, Log, TEXT("Request RelativePath/FilePath: %s %s"), *RelativePath, *FilePath);
-
-                    if (FPaths::FileExists(FilePath)) {
-                        bFileExists = true;
-                    }
-                    else if (FPaths::FileExists(FilePath + ".html")) {
-                        FilePath = FilePath + ".html";
-                        bFileExists = true;
-                    }
-
-                    if (bFileExists) {
-                        HandleGetRequest(res, req, FilePath);
-                    }
-                    else {
-                    	FRequestData RequestData;
-                        HandleApiRequest(World, res, req, RelativePath, RequestData);
-                    }
-                });
-
-                app.ws<FWebSocketUserData>("/*", std::move(wsBehavior));
+            		RequestData.Body = JsonValue->AsArray();
+				}
+            	else if (JsonValue->Type == EJson::Object)
+            	{
+            		RequestData.Body.Add(JsonValue);
+				}
+            	else
+            	{
+            		return UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
+            	}
 
-                app.listen(port, [port](us_listen_socket_t* token) {
+            	HandleApiRequest(World, res, req, RelativePath, RequestData);
+            }
+            catch (const std::exception &e)
+            {
+            	UE_LOG(LogHttpServer, Error, TEXT("Request Exception: %s"), *e.what());
+            	UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", FString("Invalid Request Body"));
+            }
+		});
 
-                    UE_LOG(LogHttpServer, Warning, TEXT("Attempting to listen on port %d"), port);
+		res->onAborted([]() {});
+	});
 
-                    if (token) {
-                        SocketListener = token;
-                        UE_LOGFMT(LogHttpServer, Warning, "Listening on port {port}", port);
-                    }
-                    else {
-                        UE_LOGFMT(LogHttpServer, Error, "Failed to listen on port {port}", port);
-                    }
-                });
+    app.get("/*", [UIPath, this, World](auto* res, uWS::HttpRequest* req) {
+        if (!res) return;
 
-                SocketRunning = true;
-                
-                app.run();
+        std::string url(req->getUrl().begin(), req->getUrl().end());
+        
+        bool bFileExists = false;
+        // Remove initial '/'
+        FString RelativePath = FString(url.c_str()).Mid(1);
+        FString FilePath = FPaths::Combine(UIPath, RelativePath);
+        FString FileContent;
+        bool IsBinary = false; // to flag non-text files (e.g., images)
 
-                SocketRunning = false;
+        if (FPaths::FileExists(FilePath)) {
+            bFileExists = true;
+        }
+        else if (FPaths::FileExists(FilePath + ".html")) {
+            FilePath = FilePath + ".html";
+            bFileExists = true;
+        }
 
-                UE_LOG(LogHttpServer, Log, TEXT("WebSocket Server Thread finished."));
-            } catch (const std::exception& e) {
-                UE_LOG(LogHttpServer, Error, TEXT("WebSocket Server Exception: %s"), *FString(e.what()));
-            } catch (...) {
-                UE_LOG(LogHttpServer, Error, TEXT("Unknown Exception in WebSocket Server"));
-            }
-        });
+        if (bFileExists) {
+            HandleGetRequest(res, req, FilePath);
+        }
+        else {
+        	FRequestData RequestData;
+            HandleApiRequest(World, res, req, RelativePath, RequestData);
+        }
+    });
 
+    app.ws<FWebSocketUserData>("/*", std::move(wsBehavior));
 }
 
 std::string UrlDecode(const std::string &Value) {
@@ -382,6 +654,7 @@ std::unordered_map<std::string, std::string> ParseQueryString(const std::string&
 
 void AFicsitRemoteMonitoring::OnClientDisconnected(uWS::WebSocket<false, true, FWebSocketUserData>* ws, int code, std::string_view message) {
     // Remove the client from all endpoint subscriptions
+    FScopeLock Lock(&ClientsLock);
     for (auto& Elem : EndpointSubscribers) {
         Elem.Value.Remove(ws);
     }
@@ -411,6 +684,12 @@ void AFicsitRemoteMonitoring::ProcessClientRequest(uWS::WebSocket<false, true, F
     const TArray<TSharedPtr<FJsonValue>>* EndpointsArray;
     FString Endpoint;
 
+    const auto LogSubscription = [ws, &Endpoint](const std::string_view Method) {
+        FFRMAccessLog::Get().Record(ws->getRemoteAddress(), Method, std::string_view(TCHAR_TO_UTF8(*Endpoint)), {}, 200, 0);
+    };
+
+    FScopeLock Lock(&ClientsLock);
+
     if (JsonRequest->TryGetArrayField("endpoints", EndpointsArray))
     {
         for (const TSharedPtr<FJsonValue>& EndpointValue : *EndpointsArray)
@@ -419,18 +698,14 @@ void AFicsitRemoteMonitoring::ProcessClientRequest(uWS::WebSocket<false, true, F
 
             if (Action == "subscribe")
             {
-                if (!EndpointSubscribers.Contains(Endpoint)) {
-                    EndpointSubscribers.Add(Endpoint, TSet<uWS::WebSocket<false, true, FWebSocketUserData>*>());
-                }
+                EndpointSubscribers.FindOrAdd(Endpoint).Add(ws);
 
-                EndpointSubscribers[Endpoint].Add(ws);
-
-                UE_LOG(LogHttpServer, Warning, TEXT("Client subscribed to endpoint: %s"), *Endpoint);
+                LogSubscription("SUBSCRIBE");
             }
             else if (Action == "unsubscribe")
             {
-                EndpointSubscribers[Endpoint].Remove(ws);
-                UE_LOG(LogHttpServer, Warning, TEXT("Client unsubscribed from endpoint: %s"), *Endpoint);
+                if (auto* Subscribers = EndpointSubscribers.Find(Endpoint)) Subscribers->Remove(ws);
+                LogSubscription("UNSUBSCRIBE");
             }
         }
     }
@@ -438,46 +713,326 @@ void AFicsitRemoteMonitoring::ProcessClientRequest(uWS::WebSocket<false, true, F
 
         if (Action == "subscribe")
         {
-            if (!EndpointSubscribers.Contains(Endpoint)) {
-                EndpointSubscribers.Add(Endpoint, TSet<uWS::WebSocket<false, true, FWebSocketUserData>*>());
-            }
+            EndpointSubscribers.FindOrAdd(Endpoint).Add(ws);
 
-            EndpointSubscribers[Endpoint].Add(ws);
-
-            UE_LOG(LogHttpServer, Warning, TEXT("Client subscribed to endpoint: %s"), *Endpoint);
+            LogSubscription("SUBSCRIBE");
         }
         else if (Action == "unsubscribe")
         {
-            EndpointSubscribers[Endpoint].Remove(ws);
-            UE_LOG(LogHttpServer, Warning, TEXT("Client unsubscribed from endpoint: %s"), *Endpoint);
+            if (auto* Subscribers = EndpointSubscribers.Find(Endpoint)) Subscribers->Remove(ws);
+            LogSubscription("UNSUBSCRIBE");
         }
     }
 }
 
 void AFicsitRemoteMonitoring::PushUpdatedData() {
+    FFRMGovernor::FScope GovernorScope;
 
-    for (auto& Elem : EndpointSubscribers) {
-        FString Endpoint = Elem.Key;
-        
-        if (Elem.Value.Num() == 0) {
-            continue;
+    // every level of the governor skips another half of the pushes
+    if (++PushCycleCounter < FFRMGovernor::Get().GetMultiplier()) return;
+    PushCycleCounter = 0;
+
+    // snapshot the subscriptions, the loops keep changing them while the endpoints run
+    TMap<FString, TArray<FWebSocketClient>> Subscriptions;
+    {
+        FScopeLock Lock(&ClientsLock);
+        for (auto& Elem : EndpointSubscribers) {
+            // telemetry is pushed by its own ticker
+            if (Elem.Value.Num() == 0 || Elem.Key == FFRMTelemetry::Channel) {
+                continue;
+            }
+
+            auto& Clients = Subscriptions.Add(Elem.Key);
+            for (uWS::WebSocket<false, true, FWebSocketUserData>* Client : Elem.Value) {
+                Clients.Add({Client->getUserData()->Loop, Client->getUserData()->ClientID});
+            }
         }
+    }
 
-        bool bAllocationComplete = false;
-        FString Json = HandleEndpoint(this, Endpoint, FRequestData(), bAllocationComplete);
+    for (auto& Elem : Subscriptions) {
+        bool bSuccess = false;
+        const FCallEndpointResponse Response = CallEndpoint(this, Elem.Key, FRequestData(), bSuccess);
 
-        //block while not complete
-        while (!bAllocationComplete)
-        {
-            //100micros sleep, this should be very quick
-            FPlatformProcess::Sleep(0.0001f);
-        };        
+        // serialize once, every subscriber shares the same payload
+        const double SerializeStart = FPlatformTime::Seconds();
+        const TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload = SerializePayload(Response, bSuccess);
+        FFRMMetrics::Get().RecordPhase(Response.MetricsIndex, EFRMRequestPhase::Serialize, FPlatformTime::Seconds() - SerializeStart);
 
         // Broadcast updated data to all clients subscribed to this endpoint
-        for (uWS::WebSocket<false, true, FWebSocketUserData>* Client : Elem.Value) {
-            Client->send(TCHAR_TO_UTF8(*Json), uWS::OpCode::TEXT);
+        for (const FWebSocketClient& Client : Elem.Value) {
+            SendToClient(Client, Payload);
+        }
+    }
+}
+
+void AFicsitRemoteMonitoring::SampleHistory() {
+    FRM_TRACE_SCOPE("FRM::SampleHistory");
+    FFRMGovernor::FScope GovernorScope;
+
+    TArray<TPair<FString, float>> Sample;
+
+    UFRM_Power::GetCircuitSample(this, Sample);
+
+    TArray<FFRMItemRates> ItemRates;
+    ProductionTracker.GetRates(ItemRates);
+
+    for (const FFRMItemRates& Rates : ItemRates) {
+        const FString Prefix = TEXT("item.") + FFRMNameCache::Find(Rates.Item)->ClassName;
+        if (Rates.MaxProduced > 0.0f) Sample.Emplace(Prefix + TEXT(".production"), Rates.CurrentProduced);
+        if (Rates.MaxConsumed > 0.0f) Sample.Emplace(Prefix + TEXT(".consumption"), Rates.CurrentConsumed);
+    }
+
+    const double Timestamp = FDateTime::UtcNow().ToUnixTimestampDecimal();
+    History.Append(Timestamp, Sample);
+    HistoryStore.Enqueue(Timestamp, MoveTemp(Sample));
+}
+
+bool AFicsitRemoteMonitoring::TickTelemetry(const float DeltaTime)
+{
+    FRM_TRACE_SCOPE("FRM::TickTelemetry");
+    FFRMGovernor::FScope GovernorScope;
+
+    TArray<FWebSocketClient> Clients;
+    {
+        FScopeLock Lock(&ClientsLock);
+        if (const auto* Subscribers = EndpointSubscribers.Find(FFRMTelemetry::Channel)) {
+            for (uWS::WebSocket<false, true, FWebSocketUserData>* Client : *Subscribers) {
+                Clients.Add({Client->getUserData()->Loop, Client->getUserData()->ClientID});
+            }
+        }
+    }
+
+    // nothing is sampled while no one listens
+    if (Clients.IsEmpty()) {
+        TelemetryTicks = 0;
+        return true;
+    }
+
+    if (++TelemetryTicks >= TelemetryCaptureTicks * FFRMGovernor::Get().GetMultiplier()) {
+        TelemetryTicks = 0;
+        Telemetry.Capture(GetWorld(), EntityIndex);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastTelemetryPush < TelemetryInterval * FFRMGovernor::Get().GetMultiplier()) return true;
+
+    // a push still encoding is not stacked up on
+    if (TelemetryPush.IsValid() && !TelemetryPush.IsReady()) return true;
+    LastTelemetryPush = Now;
+
+    // the front buffer is encoded off the game thread while the next capture fills the back one
+    TelemetryPush = Async(EAsyncExecution::TaskGraph, [this, Clients = MoveTemp(Clients)]() {
+        const TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload = Telemetry.Encode();
+        if (!Payload.IsValid()) return;
+
+        for (const FWebSocketClient& Client : Clients) {
+            SendToClient(Client, Payload, uWS::OpCode::BINARY);
+        }
+    });
+
+    return true;
+}
+
+bool AFicsitRemoteMonitoring::TickSnapshot(const float DeltaTime)
+{
+    // copying every belt and storage is only worth it while the server runs and someone reads the copies,
+    // the first request after a pause gets the last copy and brings the refresh back
+    if (!SocketListener || !Snapshots.IsWanted(SnapshotIdleSeconds)) {
+        SnapshotTickCounter = 0;
+        return true;
+    }
+
+    if (++SnapshotTickCounter < SnapshotTicks * FFRMGovernor::Get().GetMultiplier()) return true;
+    SnapshotTickCounter = 0;
+
+    FFRMGovernor::FScope GovernorScope;
+
+    // requests still reading the previous snapshot keep it alive until they are done
+    Snapshots.Publish(FFRMWorldSnapshot::Build(GetWorld(), Polylines, Snapshots.GetNextSequence()));
+    return true;
+}
+
+void AFicsitRemoteMonitoring::SendToClient(const FWebSocketClient& Client, const TSharedPtr<const std::string, ESPMode::ThreadSafe>& Payload, const uWS::OpCode OpCode)
+{
+    // sockets may only be written from their own loop; the client can be gone by the time the loop picks this up,
+    // and a new client may have been given the same socket address since
+    DeferToServerLoop(Client.Loop, [this, ClientID = Client.ClientID, Payload, OpCode]() {
+        FScopeLock Lock(&ClientsLock);
+        if (uWS::WebSocket<false, true, FWebSocketUserData>* Socket = ConnectedClients.FindRef(ClientID)) {
+            Socket->send(*Payload, OpCode);
+            FFRMMetrics::Get().RecordWebSocketMessage(Payload->size());
+            UpdateBackpressure(Socket);
+        }
+    });
+}
+
+void AFicsitRemoteMonitoring::UpdateBackpressure(uWS::WebSocket<false, true, FWebSocketUserData>* Client)
+{
+    // only the delta is recorded, so the merged shards add up to the bytes currently buffered
+    const int64 BufferedAmount = Client->getBufferedAmount();
+    FFRMMetrics::Get().RecordBackpressure(BufferedAmount - Client->getUserData()->BufferedAmount);
+    Client->getUserData()->BufferedAmount = BufferedAmount;
+}
+
+void AFicsitRemoteMonitoring::HandleMetricsRequest(uWS::HttpResponse<false>* res)
+{
+    FFRMServerGauges Gauges;
+    {
+        FScopeLock Lock(&ServerLoopsLock);
+        Gauges.ServerLoops = ServerLoops.Num();
+    }
+
+    const FFRMGovernor& Governor = FFRMGovernor::Get();
+    Gauges.GovernorLevel = Governor.GetLevel();
+    Gauges.GovernorCost = Governor.GetCost();
+    Gauges.GovernorBudget = Governor.GetBudget();
+    Gauges.RateLimitedClients = FFRMRateLimiter::Get().GetTrackedClients();
+
+    const FFRMScheduler& Scheduler = FFRMScheduler::Get();
+    for (int32 Priority = 0; Priority < static_cast<int32>(EFRMPriority::Count); Priority++) {
+        Gauges.SchedulerQueued.Add(Scheduler.GetQueued(static_cast<EFRMPriority>(Priority)));
+    }
+    for (int32 EndpointIndex = 0; EndpointIndex < FFRMMetrics::MaxEndpoints; EndpointIndex++) {
+        Gauges.CostEstimates.Add(Scheduler.GetEstimate(EndpointIndex));
+    }
+    {
+        FScopeLock Lock(&ClientsLock);
+        Gauges.WebSocketClients = ConnectedClients.Num();
+        for (const auto& Elem : EndpointSubscribers) {
+            Gauges.Subscriptions += Elem.Value.Num();
         }
     }
+
+    const FString Metrics = FFRMMetrics::Get().Scrape(Gauges);
+
+    res->writeHeader("Content-Type", "application/openmetrics-text; version=1.0.0; charset=utf-8");
+    UFRM_RequestLibrary::AddResponseHeaders(res, false);
+    res->end(TCHAR_TO_UTF8(*Metrics));
+}
+
+void AFicsitRemoteMonitoring::HandleHistoryRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req)
+{
+    FRM_TRACE_SCOPE("FRM::HandleHistoryRequest");
+    const double RequestStart = FPlatformTime::Seconds();
+
+    // everything after /api/history/, a trailing '*' selects all metrics with that prefix
+    const std::string URL(req->getUrl().begin(), req->getUrl().end());
+    const FString Metric = UTF8_TO_TCHAR(UrlDecode(URL.size() > 13 ? URL.substr(13) : std::string()).c_str());
+
+    FString Payload;
+
+    if (Metric.IsEmpty()) {
+        TArray<TSharedPtr<FJsonValue>> JMetrics;
+        for (const FString& Name : History.GetMetricNames()) {
+            JMetrics.Add(MakeShared<FJsonValueString>(Name));
+        }
+        Payload = UFRM_RequestLibrary::JsonArrayToString(JMetrics, JSONDebugMode);
+    }
+    else {
+        const double Now = FDateTime::UtcNow().ToUnixTimestampDecimal();
+        double Oldest = Now, Newest = Now;
+        const bool bHasSamples = History.GetTimeRange(Oldest, Newest);
+
+        // from/to are Unix seconds, zero or negative values are relative to now
+        const auto QueryParams = ParseQueryString(std::string(req->getQuery().begin(), req->getQuery().end()));
+        const auto GetTime = [&QueryParams, Now](const char* Key, const double Default) {
+            const auto Param = QueryParams.find(Key);
+            if (Param == QueryParams.end() || Param->second.empty()) return Default;
+
+            const double Value = FCString::Atod(UTF8_TO_TCHAR(Param->second.c_str()));
+            return Value <= 0.0 ? Now + Value : Value;
+        };
+
+        const double From = GetTime("from", Oldest);
+        const double To = GetTime("to", Now);
+
+        double Step = FMath::Max((To - From) / 300.0, 1.0);
+        const auto StepParam = QueryParams.find("step");
+        if (StepParam != QueryParams.end() && !StepParam->second.empty()) {
+            Step = FMath::Max(FCString::Atod(UTF8_TO_TCHAR(StepParam->second.c_str())), 0.001);
+        }
+
+        // the store only fills in what is older than the samples still held in memory
+        FFRMHistoryBuckets Buckets(From, To, Step);
+        HistoryStore.Query(Metric, bHasSamples ? Oldest : To + 1.0, Buckets);
+        History.Query(Metric, Buckets);
+
+        const TArray<FFRMHistorySeries> Series = Buckets.ToSeries();
+
+        if (Series.IsEmpty() && !Metric.EndsWith(TEXT("*")) && !History.GetMetricNames().Contains(Metric)) {
+            UFRM_RequestLibrary::SendErrorMessage(res, "404 Not Found", FString::Printf(TEXT("Unknown history metric: %s"), *Metric));
+            FFRMMetrics::Get().RecordUnmatchedRequest();
+            return;
+        }
+
+        const auto ToJson = [](const auto& Values) {
+            TArray<TSharedPtr<FJsonValue>> JValues;
+            JValues.Reserve(Values.Num());
+            for (const auto Value : Values) {
+                JValues.Add(MakeShared<FJsonValueNumber>(Value));
+            }
+            return MakeShared<FJsonValueArray>(JValues);
+        };
+
+        TArray<TSharedPtr<FJsonValue>> JSeries;
+        for (const FFRMHistorySeries& Elem : Series) {
+            TSharedPtr<FJsonObject> JElem = MakeShared<FJsonObject>();
+            JElem->Values.Add("metric", MakeShared<FJsonValueString>(Elem.Metric));
+            JElem->Values.Add("step", MakeShared<FJsonValueNumber>(Elem.Step));
+            JElem->Values.Add("t", ToJson(Elem.Times));
+            JElem->Values.Add("min", ToJson(Elem.Min));
+            JElem->Values.Add("max", ToJson(Elem.Max));
+            JElem->Values.Add("avg", ToJson(Elem.Avg));
+            JSeries.Add(MakeShared<FJsonValueObject>(JElem));
+        }
+        Payload = UFRM_RequestLibrary::JsonArrayToString(JSeries, JSONDebugMode);
+    }
+
+    const std::string Body = TCHAR_TO_UTF8(*Payload);
+    FFRMMetrics::Get().RecordPhase(HistoryMetricsIndex, EFRMRequestPhase::Collect, FPlatformTime::Seconds() - RequestStart);
+
+    UFRM_RequestLibrary::AddResponseHeaders(res, true);
+    res->end(Body);
+
+    FFRMMetrics::Get().RecordRequest(HistoryMetricsIndex, Body.size());
+}
+
+void AFicsitRemoteMonitoring::HandleTileRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req)
+{
+    FRM_TRACE_SCOPE("FRM::HandleTileRequest");
+    const double RequestStart = FPlatformTime::Seconds();
+
+    // /tiles/{layer}/{z}/{x}/{y}, an optional extension on y is ignored
+    const std::string URL(req->getUrl().begin(), req->getUrl().end());
+    TArray<FString> Parts;
+    FString(UTF8_TO_TCHAR(URL.c_str())).ParseIntoArray(Parts, TEXT("/"));
+
+    EFRMTileLayer Layer;
+    if (Parts.Num() != 5 || !FFRMTileCache::ParseLayer(Parts[1], Layer)) {
+        UFRM_RequestLibrary::SendErrorMessage(res, "404 Not Found", "Expected /tiles/{belts|rails|cables|pipes}/{z}/{x}/{y}");
+        FFRMMetrics::Get().RecordUnmatchedRequest();
+        return;
+    }
+
+    const FString YPart = FPaths::GetBaseFilename(Parts[4]);
+    if (!Parts[2].IsNumeric() || !Parts[3].IsNumeric() || !YPart.IsNumeric()) {
+        UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", "Tile coordinates must be numbers");
+        return;
+    }
+
+    const TSharedPtr<const std::string, ESPMode::ThreadSafe> Tile = TileCache.GetTile(Layer, FCString::Atoi(*Parts[2]), FCString::Atoi(*Parts[3]), FCString::Atoi(*YPart));
+    if (!Tile.IsValid()) {
+        UFRM_RequestLibrary::SendErrorMessage(res, "404 Not Found", FString::Printf(TEXT("No such tile, zoom levels are 0 to %d"), FFRMTileCache::MaxZoom));
+        return;
+    }
+
+    FFRMMetrics::Get().RecordPhase(TilesMetricsIndex, EFRMRequestPhase::Collect, FPlatformTime::Seconds() - RequestStart);
+
+    res->writeHeader("Content-Type", "application/octet-stream");
+    UFRM_RequestLibrary::AddResponseHeaders(res, false);
+    res->end(*Tile);
+
+    FFRMMetrics::Get().RecordRequest(TilesMetricsIndex, Tile->size());
 }
 
 void AFicsitRemoteMonitoring::HandleGetRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req, FString FilePath)
@@ -522,13 +1077,15 @@ void AFicsitRemoteMonitoring::HandleGetRequest(uWS::HttpResponse<false>* res, uW
         if (FileLoaded) {
             std::string contentLength = std::to_string(BinaryContent.Num());
 
-            UE_LOG(LogHttpServer, Log, TEXT("Binary File Found Returning: %s"), *FilePath);
+            FFRMAccessLog::Get().Record(res->getRemoteAddress(), "GET", req->getUrl(), req->getQuery(), 200, BinaryContent.Num());
 
             res->writeHeader("Content-Type", TCHAR_TO_UTF8(*ContentType));
             res->writeHeader("Content-Length", contentLength.c_str());
             UFRM_RequestLibrary::AddResponseHeaders(res, false);
             res->write(std::string_view((char*)BinaryContent.GetData(), BinaryContent.Num()));
             res->end();
+
+            FFRMMetrics::Get().RecordStaticFile(BinaryContent.Num());
         }
     }
     else {
@@ -536,49 +1093,263 @@ void AFicsitRemoteMonitoring::HandleGetRequest(uWS::HttpResponse<false>* res, uW
         // Text-based files like HTML, CSS, JS
         FileLoaded = FFileHelper::LoadFileToString(FileContent, *FilePath);
         if (FileLoaded) {
-            UE_LOG(LogHttpServer, Log, TEXT("File Found Returning: %s"), *FilePath);
+            const FTCHARToUTF8 Utf8Content(*FileContent);
+            FFRMAccessLog::Get().Record(res->getRemoteAddress(), "GET", req->getUrl(), req->getQuery(), 200, Utf8Content.Length());
 
             res->writeHeader("Content-Type", TCHAR_TO_UTF8(*ContentType));
             UFRM_RequestLibrary::AddResponseHeaders(res, false);
-            res->end(TCHAR_TO_UTF8(*FileContent));
+
+            res->end(std::string_view(Utf8Content.Get(), Utf8Content.Length()));
+
+            FFRMMetrics::Get().RecordStaticFile(Utf8Content.Length());
         }
     }
 
     if (!FileLoaded) {
         UE_LOG(LogHttpServer, Error, TEXT("Failed to load file: %s"), *FilePath);
+        FFRMAccessLog::Get().Record(res->getRemoteAddress(), "GET", req->getUrl(), req->getQuery(), 500, 0);
     	UFRM_RequestLibrary::SendErrorMessage(res, "500 Internal Server Error", "Failed to load file.");
     }
 }
 
 void AFicsitRemoteMonitoring::HandleApiRequest(UObject* World, uWS::HttpResponse<false>* res, uWS::HttpRequest* req, FString Endpoint, FRequestData RequestData)
 {
-	// Parse all query parameters
+	FRM_TRACE_SCOPE("FRM::HandleApiRequest");
+	const double RequestStart = FPlatformTime::Seconds();
+
+	const std::string Url(req->getUrl().begin(), req->getUrl().end());
 	const std::string QueryString(req->getQuery().begin(), req->getQuery().end());
-	const auto QueryParams = ParseQueryString(QueryString);
+
+	const auto LogAccess = [res, &Url, &QueryString, &RequestData](const uint16 Status, const uint64 Bytes) {
+		FFRMAccessLog::Get().Record(res->getRemoteAddress(), std::string_view(TCHAR_TO_UTF8(*RequestData.Method)), Url, QueryString, Status, Bytes);
+	};
+
+	// refused before any work is done, heavy endpoints take more of the client's tokens
+	int32 RetryAfter = 0;
+	if (!FFRMRateLimiter::Get().TryAcquire(res->getRemoteAddress(), Endpoint, RetryAfter)) {
+		TArray<FString> AvailableMethods;
+		const FAPIEndpoint* EndpointInfo = FindEndpoint(Endpoint, RequestData.Method, AvailableMethods);
+		FFRMMetrics::Get().RecordThrottled(EndpointInfo ? EndpointInfo->MetricsIndex : INDEX_NONE);
+
+		LogAccess(429, 0);
+		return UFRM_RequestLibrary::SendRetryLater(res, "429 Too Many Requests", RetryAfter, TEXT("Too many requests from this address, try again once Retry-After has passed."));
+	}
 
 	TMap<FString, FString> RequestQueryParams = TMap<FString, FString>();
-	// Iterate through all query parameters and log them
-	for (const auto& Param : QueryParams) {
-		FString Key(Param.first.c_str());
-		FString Value(Param.second.c_str());
+	{
+		FRM_TRACE_SCOPE("FRM::ParseQuery");
+
+		// Parse all query parameters
+		const auto QueryParams = ParseQueryString(QueryString);
+
+		// Iterate through all query parameters and log them
+		for (const auto& Param : QueryParams) {
+			FString Key(Param.first.c_str());
+			FString Value(Param.second.c_str());
+
+			RequestQueryParams.Add(*Key, *Value);
+		}
+	}
+
+	// ?timing=1 opts into a Server-Timing header, it is not passed on to the endpoint
+	if (RequestQueryParams.Remove(TEXT("timing")) > 0) {
+		RequestData.Timing = MakeShared<FRequestTiming, ESPMode::ThreadSafe>();
+	}
 
-		RequestQueryParams.Add(*Key, *Value);
+	// ?bbox= and ?near= restrict location-bearing endpoints to an area
+	FFRMSpatialQuery AreaQuery;
+	FString AreaError;
+	const bool bAreaQuery = FFRMSpatialQuery::Parse(RequestQueryParams, AreaQuery, AreaError);
+	if (!AreaError.IsEmpty()) {
+		LogAccess(400, 0);
+		return UFRM_RequestLibrary::SendErrorMessage(res, "400 Bad Request", AreaError);
 	}
 
 	RequestData.QueryParams = RequestQueryParams;
+
+	const FApiRequestContext Context{RequestStart, std::string(TCHAR_TO_UTF8(*RequestData.Method)), Url, QueryString, RequestData.Timing};
 	
-    bool bSuccess = false;
-    FString OutJson = this->HandleEndpoint(World, Endpoint, RequestData, bSuccess);
+    // OnDone runs on this loop, inline unless the endpoint has to wait for the game thread
+    uWS::Loop* Loop = uWS::Loop::get();
+    const auto Execute = [this, World, &Endpoint, &RequestData, bAreaQuery, &AreaQuery, Loop](TUniqueFunction<void(const FCachedResponse&)>&& OnDone) {
+        if (bAreaQuery) {
+            const TSharedRef<TSet<FName>, ESPMode::ThreadSafe> AreaFilter = MakeShared<TSet<FName>, ESPMode::ThreadSafe>();
+            EntityIndex.QuerySpatial(AreaQuery, *AreaFilter);
+            RequestData.AreaFilter = AreaFilter;
+        }
+
+        this->CallEndpointAsync(World, Endpoint, RequestData, Loop, [this, Timing = RequestData.Timing, OnDone = MoveTemp(OnDone)](FCallEndpointResponse&& EndpointResponse, const bool bSuccess) {
+            FCachedResponse Response;
+            Response.bSuccess = bSuccess;
+
+            const double SerializeStart = FPlatformTime::Seconds();
+            Response.Payload = SerializePayload(EndpointResponse, Response.bSuccess);
+            Response.MetricsIndex = EndpointResponse.MetricsIndex;
+            Response.Frames = EndpointResponse.Frames;
+            Response.bCutOff = EndpointResponse.bCutOff;
+            FFRMMetrics::Get().RecordPhase(Response.MetricsIndex, EFRMRequestPhase::Serialize, FPlatformTime::Seconds() - SerializeStart, Timing.Get());
+
+            OnDone(Response);
+        });
+    };
+
+    // set before anything can be answered later, a response that is sent right away clears it again
+    const TSharedRef<bool> bAborted = MakeShared<bool>(false);
+    const auto SendLater = [this, res, Context, bAborted](const FCachedResponse& Response, const TCHAR* CacheState) {
+        if (*bAborted) return;
+
+        res->cork([this, res, &Context, &Response, CacheState]() {
+            SendApiResponse(res, Context, Response, CacheState);
+        });
+    };
+    res->onAborted([bAborted]() { *bAborted = true; });
+
+    // identical GETs from all loops share one execution and its serialized result, kept longer while the game is behind
+    const FFRMGovernor& Governor = FFRMGovernor::Get();
+    const float CacheTTL = ResponseCacheTTL * Governor.GetMultiplier();
+    const bool bDefer = Governor.ShouldDefer(Endpoint);
+
+    FCachedResponse Response;
+    const TCHAR* CacheState = TEXT("off");
+
+    // warm catalogs are sent as they are, they never reach the game thread and are never deferred
+    TSharedPtr<const std::string, ESPMode::ThreadSafe> Catalog;
+    if (RequestData.Method == "GET" && RequestQueryParams.IsEmpty()) {
+        Catalog = Catalogs.FindPayload(Endpoint);
+    }
+
+    if (Catalog) {
+        TArray<FString> AvailableMethods;
+        const FAPIEndpoint* EndpointInfo = FindEndpoint(Endpoint, RequestData.Method, AvailableMethods);
+
+        Response.Payload = Catalog;
+        Response.bSuccess = true;
+        Response.MetricsIndex = EndpointInfo ? EndpointInfo->MetricsIndex : INDEX_NONE;
+        CacheState = TEXT("catalog");
+    }
+    else if (RequestData.Method == "GET" && CacheTTL > 0.0f) {
+        RequestQueryParams.KeySort(TLess<FString>());
+
+        FString CacheKey = Endpoint;
+        for (const auto& Param : RequestQueryParams) {
+            CacheKey += FString::Printf(TEXT("&%s=%s"), *Param.Key, *Param.Value);
+        }
+
+        if (bDefer) {
+            const bool bCacheHit = ResponseCache.Find(CacheKey, CacheTTL, Response);
+            FFRMMetrics::Get().RecordCacheLookup(bCacheHit);
+
+            if (!bCacheHit) {
+                LogAccess(503, 0);
+                return UFRM_RequestLibrary::SendRetryLater(res, "503 Service Unavailable", Governor.GetMultiplier(), TEXT("The server is busy, low priority endpoints are paused until the game has caught up."));
+            }
+            CacheState = TEXT("hit");
+        }
+        else {
+            // a request joining one in flight returns to its loop right away and is answered there once the other one completes
+            const EFRMCacheLookup Lookup = ResponseCache.Acquire(CacheKey, CacheTTL, Response, [Loop, SendLater](const FCachedResponse& Joined) {
+                DeferToServerLoop(Loop, [SendLater, Joined]() {
+                    SendLater(Joined, TEXT("hit"));
+                });
+            });
+
+            FFRMMetrics::Get().RecordCacheLookup(Lookup != EFRMCacheLookup::Miss);
+
+            if (Lookup == EFRMCacheLookup::Joined) return;
+
+            if (Lookup == EFRMCacheLookup::Miss) {
+                // the key is completed even when the client is gone, other requests may have joined it
+                return Execute([this, CacheKey, CacheTTL, SendLater](const FCachedResponse& Computed) {
+                    ResponseCache.Complete(CacheKey, CacheTTL, Computed);
+                    SendLater(Computed, TEXT("miss"));
+                });
+            }
+            CacheState = TEXT("hit");
+        }
+    }
+    else if (bDefer) {
+        LogAccess(503, 0);
+        return UFRM_RequestLibrary::SendRetryLater(res, "503 Service Unavailable", Governor.GetMultiplier(), TEXT("The server is busy, low priority endpoints are paused until the game has caught up."));
+    }
+    else {
+        return Execute([SendLater, CacheState](const FCachedResponse& Computed) {
+            SendLater(Computed, CacheState);
+        });
+    }
+
+    SendApiResponse(res, Context, Response, CacheState);
+}
+
+void AFicsitRemoteMonitoring::SendApiResponse(uWS::HttpResponse<false>* res, const FApiRequestContext& Context, const FCachedResponse& Response, const TCHAR* CacheState)
+{
+    FRM_TRACE_SCOPE("FRM::Send");
+    const double SendStart = FPlatformTime::Seconds();
+    const FFRMGovernor& Governor = FFRMGovernor::Get();
+
+    const auto LogAccess = [res, &Context](const uint16 Status, const uint64 Bytes) {
+        FFRMAccessLog::Get().Record(res->getRemoteAddress(), Context.Method, Context.Url, Context.QueryString, Status, Bytes);
+    };
+
+    if (Response.bSuccess) {
+        LogAccess(200, Response.Payload->size());
+
+        // browsers disagree on repeated Access-Control-Expose-Headers, every header below is listed in one
+        TArray<const ANSICHAR*, TInlineAllocator<4>> ExposedHeaders;
+
+        if (const FRequestTiming* Timing = Context.Timing.Get()) {
+            // the send phase is still ahead of us, total covers everything up to the first byte
+            const FString ServerTiming = FString::Printf(
+                TEXT("gt-wait;dur=%.3f, collect;dur=%.3f, serialize;dur=%.3f, cache;desc=%s, total;dur=%.3f"),
+                Timing->Seconds[static_cast<int32>(EFRMRequestPhase::GameThreadWait)] * 1000.0,
+                Timing->Seconds[static_cast<int32>(EFRMRequestPhase::Collect)] * 1000.0,
+                Timing->Seconds[static_cast<int32>(EFRMRequestPhase::Serialize)] * 1000.0,
+                CacheState,
+                (SendStart - Context.RequestStart) * 1000.0
+            );
+            res->writeHeader("Server-Timing", TCHAR_TO_UTF8(*ServerTiming));
+            ExposedHeaders.Add("Server-Timing");
+        }
+
+        // time-sliced collectors, the data of the first and the last object are this many frames apart
+        if (Response.Frames > 1) {
+            res->writeHeader("X-FRM-Frames", TCHAR_TO_UTF8(*FString::FromInt(Response.Frames)));
+            ExposedHeaders.Add("X-FRM-Frames");
+        }
+
+        // data is older or sparser than configured while the governor protects the game
+        if (Governor.GetLevel() > 0) {
+            res->writeHeader("X-FRM-Governor", TCHAR_TO_UTF8(*FString::FromInt(Governor.GetLevel())));
+            ExposedHeaders.Add("X-FRM-Governor");
+        }
+
+        if (ExposedHeaders.Num()) {
+            std::string Exposed = ExposedHeaders[0];
+            for (int32 Index = 1; Index < ExposedHeaders.Num(); Index++) {
+                Exposed.append(", ").append(ExposedHeaders[Index]);
+            }
+            res->writeHeader("Access-Control-Expose-Headers", Exposed);
+        }
 
-    if (bSuccess) {
-        UE_LOGFMT(LogHttpServer, Log, "API Found Returning: {Endpoint}", Endpoint);
         UFRM_RequestLibrary::AddResponseHeaders(res, true);
-        res->end(TCHAR_TO_UTF8(*OutJson));
+        res->end(*Response.Payload);
+    }
+    else if (Response.bCutOff)
+    {
+        LogAccess(503, 0);
+        UFRM_RequestLibrary::SendRetryLater(res, "503 Service Unavailable", 3, TEXT("The server stopped before the request was complete."));
     }
     else
     {
-        UE_LOGFMT(LogHttpServer, Log, "API Not Found: {Endpoint}", Endpoint);
-    	UFRM_RequestLibrary::SendErrorJson(res, "404 Not Found", OutJson);
+        LogAccess(404, 0);
+    	UFRM_RequestLibrary::SendErrorJson(res, "404 Not Found", FString(UTF8_TO_TCHAR(Response.Payload->c_str())));
+    }
+
+    if (Response.MetricsIndex == INDEX_NONE) {
+        FFRMMetrics::Get().RecordUnmatchedRequest();
+    }
+    else {
+        FFRMMetrics::Get().RecordPhase(Response.MetricsIndex, EFRMRequestPhase::Send, FPlatformTime::Seconds() - SendStart);
+        FFRMMetrics::Get().RecordRequest(Response.MetricsIndex, Response.Payload->size());
     }
 
 }
@@ -587,65 +1358,70 @@ void AFicsitRemoteMonitoring::InitAPIRegistry()
 {
 
 	//Registering Endpoints: API Name, bGetAll, bRequireGameThread, FunctionPtr
+	// Only endpoints that never touch live UObjects run on the web server loops: getBelts, getStorageInv and getWorldInv
+	// answer from the world snapshot, the factory endpoints and getPowerUsage wait for time-sliced game thread passes,
+	// and getAll dispatches its game thread parts itself.
 	RegisterEndpoint("getAssembler", false, false, &AFicsitRemoteMonitoring::getAssembler);
 	RegisterEndpoint("getBelts", true, false, &AFicsitRemoteMonitoring::getBelts);
-	RegisterEndpoint("getBiomassGenerator", false, false, &AFicsitRemoteMonitoring::getBiomassGenerator);
+	RegisterEndpoint("getBiomassGenerator", false, true, &AFicsitRemoteMonitoring::getBiomassGenerator);
 	RegisterEndpoint("getBlender", false, false, &AFicsitRemoteMonitoring::getBlender);
-	RegisterEndpoint("getCables", true, false, &AFicsitRemoteMonitoring::getCables);
-	RegisterEndpoint("getCloudInv", true, false, &AFicsitRemoteMonitoring::getCloudInv);
-	RegisterEndpoint("getCoalGenerator", false, false, &AFicsitRemoteMonitoring::getCoalGenerator);
+	RegisterEndpoint("getById", false, true, &AFicsitRemoteMonitoring::getById);
+	RegisterEndpoint("getCables", true, true, &AFicsitRemoteMonitoring::getCables);
+	RegisterEndpoint("getCloudInv", true, true, &AFicsitRemoteMonitoring::getCloudInv);
+	RegisterEndpoint("getCoalGenerator", false, true, &AFicsitRemoteMonitoring::getCoalGenerator);
     RegisterEndpoint("getConstructor", false, false, &AFicsitRemoteMonitoring::getConstructor);
 	RegisterEndpoint("getConverter", false, false, &AFicsitRemoteMonitoring::getConverter);
 	RegisterEndpoint("getDoggo", true, true, &AFicsitRemoteMonitoring::getDoggo);
 	RegisterEndpoint("getDrone", true, true, &AFicsitRemoteMonitoring::getDrone);
-	RegisterEndpoint("getDroneStation", true, false, &AFicsitRemoteMonitoring::getDroneStation);
+	RegisterEndpoint("getDroneStation", true, true, &AFicsitRemoteMonitoring::getDroneStation);
 	RegisterEndpoint("getDropPod", true, true, &AFicsitRemoteMonitoring::getDropPod);
 	RegisterEndpoint("getEncoder", true, false, &AFicsitRemoteMonitoring::getEncoder);
-	RegisterEndpoint("getExplorationSink", true, false, &AFicsitRemoteMonitoring::getExplorationSink);
+	RegisterEndpoint("getExplorationSink", true, true, &AFicsitRemoteMonitoring::getExplorationSink);
 	RegisterEndpoint("getExplorer", false, true, &AFicsitRemoteMonitoring::getExplorer);
 	RegisterEndpoint("getExtractor", true, true, &AFicsitRemoteMonitoring::getExtractor);
-	RegisterEndpoint("getFactoryCart", false, false, &AFicsitRemoteMonitoring::getFactoryCart);
+	RegisterEndpoint("getFactoryCart", false, true, &AFicsitRemoteMonitoring::getFactoryCart);
 	RegisterEndpoint("getFoundry", false, false, &AFicsitRemoteMonitoring::getFoundry);
-    RegisterEndpoint("getFrackingActivator", false, false, &AFicsitRemoteMonitoring::getFrackingActivator);
-	RegisterEndpoint("getFuelGenerator", false, false, &AFicsitRemoteMonitoring::getFuelGenerator);
-	RegisterEndpoint("getGeothermalGenerator", false, false, &AFicsitRemoteMonitoring::getGeothermalGenerator);
+    RegisterEndpoint("getFrackingActivator", false, true, &AFicsitRemoteMonitoring::getFrackingActivator);
+	RegisterEndpoint("getFuelGenerator", false, true, &AFicsitRemoteMonitoring::getFuelGenerator);
+	RegisterEndpoint("getGeothermalGenerator", false, true, &AFicsitRemoteMonitoring::getGeothermalGenerator);
 	RegisterEndpoint("getHUBTerminal", true, true, &AFicsitRemoteMonitoring::getHUBTerminal);
-  RegisterEndpoint("getHypertube", true, false, &AFicsitRemoteMonitoring::getHypertube);
+  RegisterEndpoint("getHypertube", true, true, &AFicsitRemoteMonitoring::getHypertube);
 	RegisterEndpoint("getManufacturer", false, false, &AFicsitRemoteMonitoring::getManufacturer);
-	RegisterEndpoint("getModList", true, false, &AFicsitRemoteMonitoring::getModList);
-	RegisterEndpoint("getNuclearGenerator", false, false, &AFicsitRemoteMonitoring::getNuclearGenerator);
+	RegisterEndpoint("getModList", true, true, &AFicsitRemoteMonitoring::getModList);
+	RegisterEndpoint("getNuclearGenerator", false, true, &AFicsitRemoteMonitoring::getNuclearGenerator);
     RegisterEndpoint("getPackager", false, false, &AFicsitRemoteMonitoring::getPackager);
 	RegisterEndpoint("getParticle", false, false, &AFicsitRemoteMonitoring::getParticle);
-	RegisterEndpoint("getPaths", true, false, &AFicsitRemoteMonitoring::getPaths);
-	RegisterEndpoint("getPipes", true, false, &AFicsitRemoteMonitoring::getPipes);
+	RegisterEndpoint("getPaths", true, true, &AFicsitRemoteMonitoring::getPaths);
+	RegisterEndpoint("getPipes", true, true, &AFicsitRemoteMonitoring::getPipes);
 	RegisterEndpoint("getPlayer", true, true, &AFicsitRemoteMonitoring::getPlayer);
-  RegisterEndpoint("getPortal", true, false, &AFicsitRemoteMonitoring::getPortal);
-	RegisterEndpoint("getPower", true, false, &AFicsitRemoteMonitoring::getPower);
+  RegisterEndpoint("getPortal", true, true, &AFicsitRemoteMonitoring::getPortal);
+	RegisterEndpoint("getPower", true, true, &AFicsitRemoteMonitoring::getPower);
 	RegisterEndpoint("getPowerSlug", true, true, &AFicsitRemoteMonitoring::getPowerSlug);
 	RegisterEndpoint("getPowerUsage", true, false, &AFicsitRemoteMonitoring::getPowerUsage);
-	RegisterEndpoint("getProdStats", true, false, &AFicsitRemoteMonitoring::getProdStats);
-  RegisterEndpoint("getPump", true, false, &AFicsitRemoteMonitoring::getPump);
-	RegisterEndpoint("getRadarTower", true, false, &AFicsitRemoteMonitoring::getRadarTower);
+	RegisterEndpoint("getPowerGraph", false, true, true, &AFicsitRemoteMonitoring::getPowerGraph);
+	RegisterEndpoint("getProdStats", true, true, &AFicsitRemoteMonitoring::getProdStats);
+  RegisterEndpoint("getPump", true, true, &AFicsitRemoteMonitoring::getPump);
+	RegisterEndpoint("getRadarTower", true, true, &AFicsitRemoteMonitoring::getRadarTower);
 	RegisterEndpoint("getRecipes", true, true, &AFicsitRemoteMonitoring::getRecipes);
 	RegisterEndpoint("getRefinery", false, false, &AFicsitRemoteMonitoring::getRefinery);
 	RegisterEndpoint("getResourceGeyser", true, true, &AFicsitRemoteMonitoring::getResourceGeyser);
 	RegisterEndpoint("getResourceNode", true, true, &AFicsitRemoteMonitoring::getResourceNode);
-	RegisterEndpoint("getResourceSink", true, false, &AFicsitRemoteMonitoring::getResourceSink);
-    RegisterEndpoint("getResourceSinkBuilding", true, false, &AFicsitRemoteMonitoring::getResourceSinkBuilding);
+	RegisterEndpoint("getResourceSink", true, true, &AFicsitRemoteMonitoring::getResourceSink);
+    RegisterEndpoint("getResourceSinkBuilding", true, true, &AFicsitRemoteMonitoring::getResourceSinkBuilding);
 	RegisterEndpoint("getResourceWell", true, true, &AFicsitRemoteMonitoring::getResourceWell);
     RegisterEndpoint("getSessionInfo", true, true, true, &AFicsitRemoteMonitoring::getSessionInfo);
 	RegisterEndpoint("getSchematics", true, true, &AFicsitRemoteMonitoring::getSchematics);
 	RegisterEndpoint("getSinkList", true, true, &AFicsitRemoteMonitoring::getSinkList);
 	RegisterEndpoint("getSmelter", false, false, &AFicsitRemoteMonitoring::getSmelter);
-	RegisterEndpoint("getSpaceElevator", true, false, &AFicsitRemoteMonitoring::getSpaceElevator);
+	RegisterEndpoint("getSpaceElevator", true, true, &AFicsitRemoteMonitoring::getSpaceElevator);
 	RegisterEndpoint("getStorageInv", true, false, &AFicsitRemoteMonitoring::getStorageInv);
-	RegisterEndpoint("getSwitches", true, false, &AFicsitRemoteMonitoring::getSwitches);
-	RegisterEndpoint("getTractor", false, false, &AFicsitRemoteMonitoring::getTractor);
-	RegisterEndpoint("getTrains", true, false, &AFicsitRemoteMonitoring::getTrains);
-	RegisterEndpoint("getTrainRails", true, false, &AFicsitRemoteMonitoring::getTrainRails);
-	RegisterEndpoint("getTrainStation", true, false, &AFicsitRemoteMonitoring::getTrainStation);
-	RegisterEndpoint("getTruck", false, false, &AFicsitRemoteMonitoring::getTruck);
-	RegisterEndpoint("getTruckStation", true, false, &AFicsitRemoteMonitoring::getTruckStation);
+	RegisterEndpoint("getSwitches", true, true, &AFicsitRemoteMonitoring::getSwitches);
+	RegisterEndpoint("getTractor", false, true, &AFicsitRemoteMonitoring::getTractor);
+	RegisterEndpoint("getTrains", true, true, &AFicsitRemoteMonitoring::getTrains);
+	RegisterEndpoint("getTrainRails", true, true, &AFicsitRemoteMonitoring::getTrainRails);
+	RegisterEndpoint("getTrainStation", true, true, &AFicsitRemoteMonitoring::getTrainStation);
+	RegisterEndpoint("getTruck", false, true, &AFicsitRemoteMonitoring::getTruck);
+	RegisterEndpoint("getTruckStation", true, true, &AFicsitRemoteMonitoring::getTruckStation);
 	RegisterEndpoint("getWorldInv", true, false, &AFicsitRemoteMonitoring::getWorldInv);
 	RegisterEndpoint("getResearchTrees", true, true, &AFicsitRemoteMonitoring::getResearchTrees);
 
@@ -655,8 +1431,8 @@ void AFicsitRemoteMonitoring::InitAPIRegistry()
 	//FRM API Endpoint Groups
 	RegisterEndpoint("getAll", false, false, &AFicsitRemoteMonitoring::getAll);
 	RegisterEndpoint("getFactory", true, false, &AFicsitRemoteMonitoring::getFactory);
-	RegisterEndpoint("getGenerators", true, false, &AFicsitRemoteMonitoring::getGenerators);
-	RegisterEndpoint("getVehicles", true, false, &AFicsitRemoteMonitoring::getVehicles);
+	RegisterEndpoint("getGenerators", true, true, &AFicsitRemoteMonitoring::getGenerators);
+	RegisterEndpoint("getVehicles", true, true, &AFicsitRemoteMonitoring::getVehicles);
 
 	// post/write endpoints
 	RegisterPostEndpoint("setSwitches", true, true, &AFicsitRemoteMonitoring::setSwitches);
@@ -735,6 +1511,7 @@ void AFicsitRemoteMonitoring::RegisterEndpoint(const FString& Method, const FStr
 	NewEndpoint.bRequireGameThread = bRequireGameThread;
 	NewEndpoint.bUseFirstObject = bUseFirstObject;
 	NewEndpoint.FunctionPtr = FunctionPtr;
+	NewEndpoint.MetricsIndex = FFRMMetrics::Get().RegisterEndpoint(APIName);
 	
 	APIEndpoints.Add(NewEndpoint);
 
@@ -774,82 +1551,327 @@ void AFicsitRemoteMonitoring::RegisterEndpoint(const FString& Method, const FStr
 
 FCallEndpointResponse AFicsitRemoteMonitoring::CallEndpoint(UObject* WorldContext, FString InEndpoint, FRequestData RequestData, bool& bSuccess)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*InEndpoint, FRMChannel);
+
     FCallEndpointResponse Response;
     Response.bUseFirstObject = false;
     bSuccess = false;
     TArray<TSharedPtr<FJsonValue>> JsonArray;
 
+    // the server is stopping, answered and logged as 503 like a pass it cut off
     if (!SocketListener) {
-        UE_LOG(LogHttpServer, Warning, TEXT("SocketListener is closed. Skipping request for endpoint '%s'."), *InEndpoint);
+        Response.bCutOff = true;
+        AddErrorJson(JsonArray, TEXT("The server stopped before the request was complete."));
+        Response.JsonValues = JsonArray;
         return Response;
     }
 
 	TArray<FString> AvailableMethods;
-    bool bEndpointFound = false;
 
-    for (FAPIEndpoint& EndpointInfo : APIEndpoints)
+    if (const FAPIEndpoint* FoundEndpoint = FindEndpoint(InEndpoint, RequestData.Method, AvailableMethods))
     {
-        if (EndpointInfo.APIName == InEndpoint)
-        {
-	        if (RequestData.Method != EndpointInfo.Method)
-        	{
-	        	AvailableMethods.Add(EndpointInfo.Method);
-        		continue;
-        	}
-
-            bEndpointFound = true;
-            Response.bUseFirstObject = EndpointInfo.bUseFirstObject;
-
-            try {
-                if (EndpointInfo.bRequireGameThread) {
-                    FThreadSafeBool bAllocationComplete = false;
-                    AsyncTask(ENamedThreads::GameThread, [this, &EndpointInfo, WorldContext, RequestData, &JsonArray, &bAllocationComplete, &bSuccess]() {
-						if (SocketListener && EndpointInfo.FunctionPtr)
-						{
-							(this->*EndpointInfo.FunctionPtr)(WorldContext, RequestData, JsonArray);  // Use direct function call
-							bSuccess = true;
-						}
-						bAllocationComplete = true;
-					});
-
-                    while (!bAllocationComplete) {
-                        FPlatformProcess::Sleep(0.0001f);
-                    }
-                }
-				else if (SocketListener && EndpointInfo.FunctionPtr)
+        const FAPIEndpoint& EndpointInfo = *FoundEndpoint;
+        Response.bUseFirstObject = EndpointInfo.bUseFirstObject;
+        Response.MetricsIndex = EndpointInfo.MetricsIndex;
+
+        // only the passes of this call count towards its frames
+        FFRMTimeSlicer::TakeFrames();
+        FFRMTimeSlicer::TakeCutOff();
+
+        try {
+            // no thread waits for the game thread, the loops reach these endpoints through CallEndpointAsync
+            if (EndpointInfo.bRequireGameThread && !IsInGameThread()) {
+                UE_LOG(LogHttpServer, Error, TEXT("'%s' needs the game thread, use CallEndpointAsync off the game thread."), *InEndpoint);
+                AddErrorJson(JsonArray, TEXT("The endpoint could not be run on this thread."));
+            }
+			else if (SocketListener && EndpointInfo.FunctionPtr)
+			{
+				FRM_TRACE_SCOPE("FRM::Collect");
+				const double StartedAt = FPlatformTime::Seconds();
 				{
+					FFRMThreadAudit::FScope AuditScope(EndpointInfo.APIName, EndpointInfo.bRequireGameThread);
 					(this->*EndpointInfo.FunctionPtr)(WorldContext, RequestData, JsonArray);  // Use direct function call
-					bSuccess = true;
 				}
-            } catch (const std::exception& e) {
-                FString err = FString(e.what());
-                UE_LOG(LogHttpServer, Error, TEXT("Exception in CallEndpoint for endpoint '%s': %s"), *InEndpoint, *err);
-                AddErrorJson(JsonArray, TEXT("Exception: ") + err);
-            } catch (...) {
-                UE_LOG(LogHttpServer, Error, TEXT("Unknown exception in CallEndpoint for endpoint '%s'."), *InEndpoint);
-                AddErrorJson(JsonArray, TEXT("Unknown exception occurred."));
-            }
+				bSuccess = true;
+				const double Collect = FPlatformTime::Seconds() - StartedAt;
+				FFRMMetrics::Get().RecordPhase(EndpointInfo.MetricsIndex, EFRMRequestPhase::Collect, Collect, RequestData.Timing.Get());
+				FFRMScheduler::Get().RecordCost(EndpointInfo.MetricsIndex, Collect);
+			}
+
+            Response.Frames = FFRMTimeSlicer::TakeFrames();
 
-            break;
+            // an empty array from an abandoned pass is not an empty world
+            if (FFRMTimeSlicer::TakeCutOff()) {
+                Response.bCutOff = true;
+                bSuccess = false;
+                JsonArray.Reset();
+                AddErrorJson(JsonArray, TEXT("The server stopped before the request was complete."));
+            }
+        } catch (const std::exception& e) {
+            FString err = FString(e.what());
+            UE_LOG(LogHttpServer, Error, TEXT("Exception in CallEndpoint for endpoint '%s': %s"), *InEndpoint, *err);
+            AddErrorJson(JsonArray, TEXT("Exception: ") + err);
+        } catch (...) {
+            UE_LOG(LogHttpServer, Error, TEXT("Unknown exception in CallEndpoint for endpoint '%s'."), *InEndpoint);
+            AddErrorJson(JsonArray, TEXT("Unknown exception occurred."));
         }
     }
-
-	if (AvailableMethods.Num()) {
+	else if (AvailableMethods.Num()) {
 		AddErrorJson(JsonArray, FString::Printf(
 			TEXT("The %s method is not supported for this route. Supported methods: %s."),
 			*RequestData.Method,
 			*FString::Join(AvailableMethods, TEXT(", "))
 		));
 	}
-    else if (!bEndpointFound) {
-        UE_LOG(LogHttpServer, Warning, TEXT("No matching endpoint found for '%s'."), *InEndpoint);
+    else {
+        // ends up in the access log as 404, logging every probe here would flood the game log
         AddErrorJson(JsonArray, TEXT("No matching endpoint found."));
     }
 
+    ApplyAreaFilter(RequestData, JsonArray);
+
     Response.JsonValues = JsonArray;
     return Response;
 }
 
+void AFicsitRemoteMonitoring::CallEndpointAsync(UObject* WorldContext, FString InEndpoint, FRequestData RequestData, uWS::Loop* Loop, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete)
+{
+    TArray<FString> AvailableMethods;
+    const FAPIEndpoint* EndpointInfo = SocketListener ? FindEndpoint(InEndpoint, RequestData.Method, AvailableMethods) : nullptr;
+
+    // errors and calls from the game thread are answered right away
+    if (!EndpointInfo || IsInGameThread()) {
+        bool bSuccess = false;
+        FCallEndpointResponse Response = CallEndpoint(WorldContext, InEndpoint, RequestData, bSuccess);
+        OnComplete(MoveTemp(Response), bSuccess);
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*InEndpoint, FRMChannel);
+
+    if (EndpointInfo->FunctionPtr == &AFicsitRemoteMonitoring::getAll) {
+        GetAllAsync(*EndpointInfo, WorldContext, RequestData, Loop, MoveTemp(OnComplete));
+        return;
+    }
+
+    // cheap endpoints go ahead of expensive ones that are still waiting for the game thread
+    RunEndpointAsync(*EndpointInfo, WorldContext, RequestData, Loop, FFRMScheduler::Get().GetPriority(EndpointInfo->MetricsIndex), MoveTemp(OnComplete));
+}
+
+void AFicsitRemoteMonitoring::RunEndpointAsync(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, uWS::Loop* Loop, const EFRMPriority Priority, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete)
+{
+    const FAPIEndpoint* Endpoint = &EndpointInfo;
+
+    // collectors running on the loop answer inline, unless a time-sliced pass takes the rest of the work to the game thread
+    if (!EndpointInfo.bRequireGameThread) {
+        const double StartedAt = FPlatformTime::Seconds();
+
+        // whichever path finishes the response calls it, the pass callback or the code below
+        const TSharedRef<TUniqueFunction<void(FCallEndpointResponse&&, bool)>, ESPMode::ThreadSafe> Finish = MakeShared<TUniqueFunction<void(FCallEndpointResponse&&, bool)>, ESPMode::ThreadSafe>(MoveTemp(OnComplete));
+
+        FCallEndpointResponse Response;
+        bool bSuccess = false;
+
+        FFRMTimeSlicer::TakeFrames();
+        FFRMTimeSlicer::TakeCutOff();
+        {
+            FFRMTimeSlicer::FDeferScope DeferScope([this, Endpoint, RequestData, Loop, StartedAt, Finish](TArray<TSharedPtr<FJsonValue>>&& Results, const int32 Frames, const bool bCutOff) {
+                DeferToServerLoop(Loop, [this, Endpoint, RequestData, StartedAt, Finish, Results = MoveTemp(Results), Frames, bCutOff]() mutable {
+                    FCallEndpointResponse Response;
+                    Response.JsonValues = MoveTemp(Results);
+                    bool bSuccess = true;
+                    FinishEndpointResponse(*Endpoint, RequestData, StartedAt, Frames, bCutOff, Response, bSuccess);
+                    (*Finish)(MoveTemp(Response), bSuccess);
+                });
+            });
+
+            bSuccess = RunEndpoint(EndpointInfo, WorldContext, RequestData, Response.JsonValues);
+            if (DeferScope.IsQueued()) return;
+        }
+
+        FinishEndpointResponse(EndpointInfo, RequestData, StartedAt, FFRMTimeSlicer::TakeFrames(), FFRMTimeSlicer::TakeCutOff(), Response, bSuccess);
+        (*Finish)(MoveTemp(Response), bSuccess);
+        return;
+    }
+
+    const double QueuedAt = FPlatformTime::Seconds();
+
+    // the loop goes on serving its other sockets while the job is queued, so the scheduler sees every waiting request
+    FFRMScheduler::Get().Dispatch(Priority, [this, WeakThis = TWeakObjectPtr<AFicsitRemoteMonitoring>(this), Endpoint, WorldContext, RequestData, Loop, QueuedAt, OnComplete = MoveTemp(OnComplete)]() mutable {
+        // loops keep queueing until they are stopped after the scheduler, such a job must not touch the ended subsystem Endpoint points into
+        if (!WeakThis.IsValid() || !WeakThis->HasActorBegunPlay()) return;
+
+        FCallEndpointResponse Response;
+        Response.bUseFirstObject = Endpoint->bUseFirstObject;
+        Response.MetricsIndex = Endpoint->MetricsIndex;
+        bool bSuccess = false;
+
+        FFRMTimeSlicer::TakeFrames();
+        bSuccess = CollectOnGameThread(*Endpoint, WorldContext, RequestData, QueuedAt, Response.JsonValues);
+        Response.Frames = FFRMTimeSlicer::TakeFrames();
+
+        // filtering and serializing is left to the loop, the game thread only collects
+        DeferToServerLoop(Loop, [this, RequestData, Response = MoveTemp(Response), bSuccess, OnComplete = MoveTemp(OnComplete)]() mutable {
+            ApplyAreaFilter(RequestData, Response.JsonValues);
+            OnComplete(MoveTemp(Response), bSuccess);
+        });
+    });
+}
+
+void AFicsitRemoteMonitoring::GetAllAsync(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, uWS::Loop* Loop, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete)
+{
+    // only touched on the owning loop, every part hands its result back to it
+    struct FParts
+    {
+        TArray<const FAPIEndpoint*> Endpoints;
+        TArray<TArray<TSharedPtr<FJsonValue>>> Results;
+        int32 Remaining = 0;
+        int32 Frames = 0;
+        bool bCutOff = false;
+        FRequestData RequestData;
+        double StartedAt = 0.0;
+        TUniqueFunction<void(FCallEndpointResponse&&, bool)> OnComplete;
+    };
+
+    const TSharedRef<FParts, ESPMode::ThreadSafe> Parts = MakeShared<FParts, ESPMode::ThreadSafe>();
+    for (const FAPIEndpoint& APIEndpoint : APIEndpoints) {
+        if (APIEndpoint.bGetAll) Parts->Endpoints.Add(&APIEndpoint);
+    }
+    Parts->Results.SetNum(Parts->Endpoints.Num());
+    Parts->RequestData = RequestData;
+    Parts->StartedAt = FPlatformTime::Seconds();
+    Parts->OnComplete = MoveTemp(OnComplete);
+
+    // one more than there are parts until all of them are queued, so parts answering inline cannot finish early
+    Parts->Remaining = Parts->Endpoints.Num() + 1;
+
+    const FAPIEndpoint* Endpoint = &EndpointInfo;
+    const auto PartDone = [this, Endpoint, Parts]() {
+        if (--Parts->Remaining > 0) return;
+
+        FCallEndpointResponse Response;
+        for (int32 Index = 0; Index < Parts->Endpoints.Num(); Index++) {
+            const FAPIEndpoint& APIEndpoint = *Parts->Endpoints[Index];
+            TArray<TSharedPtr<FJsonValue>>& EndpointJsonValues = Parts->Results[Index];
+            TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+
+            if (APIEndpoint.bUseFirstObject && EndpointJsonValues.Num() > 0) {
+                TSharedPtr<FJsonObject> FirstJsonObject = EndpointJsonValues[0]->AsObject();
+                JsonObject->SetObjectField(APIEndpoint.APIName, FirstJsonObject.IsValid() ? FirstJsonObject : MakeShared<FJsonObject>());
+            }
+            else {
+                JsonObject->SetArrayField(APIEndpoint.APIName, EndpointJsonValues);
+            }
+
+            Response.JsonValues.Add(MakeShared<FJsonValueObject>(JsonObject));
+        }
+
+        bool bSuccess = true;
+        FinishEndpointResponse(*Endpoint, Parts->RequestData, Parts->StartedAt, Parts->Frames, Parts->bCutOff, Response, bSuccess);
+        Parts->OnComplete(MoveTemp(Response), bSuccess);
+    };
+
+    // every part is queued at once, the game thread parts run behind interactive requests
+    for (int32 Index = 0; Index < Parts->Endpoints.Num(); Index++) {
+        RunEndpointAsync(*Parts->Endpoints[Index], WorldContext, Parts->RequestData, Loop, EFRMPriority::Bulk, [Parts, Index, PartDone](FCallEndpointResponse&& Response, bool) {
+            Parts->Results[Index] = MoveTemp(Response.JsonValues);
+            Parts->Frames = FMath::Max(Parts->Frames, Response.Frames);
+            Parts->bCutOff |= Response.bCutOff;
+            PartDone();
+        });
+    }
+
+    PartDone();
+}
+
+bool AFicsitRemoteMonitoring::CollectOnGameThread(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, const double QueuedAt, TArray<TSharedPtr<FJsonValue>>& OutJsonArray)
+{
+    FRM_TRACE_SCOPE("FRM::GameThreadCollect");
+    FFRMGovernor::FScope GovernorScope;
+    const double StartedAt = FPlatformTime::Seconds();
+    FFRMMetrics::Get().RecordPhase(EndpointInfo.MetricsIndex, EFRMRequestPhase::GameThreadWait, StartedAt - QueuedAt, RequestData.Timing.Get());
+
+    const bool bSuccess = RunEndpoint(EndpointInfo, WorldContext, RequestData, OutJsonArray);
+
+    const double Collect = FPlatformTime::Seconds() - StartedAt;
+    FFRMMetrics::Get().RecordPhase(EndpointInfo.MetricsIndex, EFRMRequestPhase::Collect, Collect, RequestData.Timing.Get());
+    FFRMScheduler::Get().RecordCost(EndpointInfo.MetricsIndex, Collect);
+    return bSuccess;
+}
+
+bool AFicsitRemoteMonitoring::RunEndpoint(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray)
+{
+    if (!SocketListener || !EndpointInfo.FunctionPtr) return false;
+
+    try {
+        FFRMThreadAudit::FScope AuditScope(EndpointInfo.APIName, EndpointInfo.bRequireGameThread);
+        (this->*EndpointInfo.FunctionPtr)(WorldContext, RequestData, OutJsonArray);  // Use direct function call
+        return true;
+    } catch (const std::exception& e) {
+        FString err = FString(e.what());
+        UE_LOG(LogHttpServer, Error, TEXT("Exception in CallEndpoint for endpoint '%s': %s"), *EndpointInfo.APIName, *err);
+        AddErrorJson(OutJsonArray, TEXT("Exception: ") + err);
+    } catch (...) {
+        UE_LOG(LogHttpServer, Error, TEXT("Unknown exception in CallEndpoint for endpoint '%s'."), *EndpointInfo.APIName);
+        AddErrorJson(OutJsonArray, TEXT("Unknown exception occurred."));
+    }
+    return false;
+}
+
+void AFicsitRemoteMonitoring::FinishEndpointResponse(const FAPIEndpoint& EndpointInfo, const FRequestData& RequestData, const double StartedAt, const int32 Frames, const bool bCutOff, FCallEndpointResponse& Response, bool& bSuccess)
+{
+    Response.bUseFirstObject = EndpointInfo.bUseFirstObject;
+    Response.MetricsIndex = EndpointInfo.MetricsIndex;
+    Response.Frames = Frames;
+
+    // an empty array from an abandoned pass is not an empty world
+    if (bCutOff) {
+        Response.bCutOff = true;
+        bSuccess = false;
+        Response.JsonValues.Reset();
+        AddErrorJson(Response.JsonValues, TEXT("The server stopped before the request was complete."));
+    }
+
+    const double Collect = FPlatformTime::Seconds() - StartedAt;
+    FFRMMetrics::Get().RecordPhase(EndpointInfo.MetricsIndex, EFRMRequestPhase::Collect, Collect, RequestData.Timing.Get());
+    FFRMScheduler::Get().RecordCost(EndpointInfo.MetricsIndex, Collect);
+
+    ApplyAreaFilter(RequestData, Response.JsonValues);
+}
+
+void AFicsitRemoteMonitoring::ApplyAreaFilter(const FRequestData& RequestData, TArray<TSharedPtr<FJsonValue>>& JsonArray) const
+{
+    // entities outside the requested area are dropped, anything that is not an entity (recipes, circuits) is kept
+    if (!RequestData.AreaFilter.IsValid()) return;
+
+    FRM_TRACE_SCOPE("FRM::AreaFilter");
+    JsonArray.RemoveAll([this, &RequestData](const TSharedPtr<FJsonValue>& Value) {
+        const TSharedPtr<FJsonObject>* Object;
+        FString ID;
+        if (!Value.IsValid() || !Value->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("ID"), ID)) return false;
+
+        const FName Name(*ID, FNAME_Find);
+        return !RequestData.AreaFilter->Contains(Name) && EntityIndex.Contains(Name);
+    });
+}
+
+const FAPIEndpoint* AFicsitRemoteMonitoring::FindEndpoint(const FString& InEndpoint, const FString& Method, TArray<FString>& OutAvailableMethods) const
+{
+    for (const FAPIEndpoint& EndpointInfo : APIEndpoints)
+    {
+        if (EndpointInfo.APIName != InEndpoint) continue;
+
+        if (EndpointInfo.Method == Method)
+        {
+            return &EndpointInfo;
+        }
+
+        OutAvailableMethods.Add(EndpointInfo.Method);
+    }
+
+    return nullptr;
+}
+
 // Helper function to add error messages to JsonArray
 void AFicsitRemoteMonitoring::AddErrorJson(TArray<TSharedPtr<FJsonValue>>& JsonArray, const FString& ErrorMessage)
 {
@@ -862,7 +1884,15 @@ FString AFicsitRemoteMonitoring::HandleEndpoint(UObject* WorldContext, FString I
 {
 	bSuccess = false;
 
-	auto [JsonValues, bUseFirstObject] = this->CallEndpoint(WorldContext, InEndpoint, RequestData, bSuccess);
+	return SerializeResponse(this->CallEndpoint(WorldContext, InEndpoint, RequestData, bSuccess), bSuccess);
+}
+
+FString AFicsitRemoteMonitoring::SerializeResponse(const FCallEndpointResponse& Response, const bool bSuccess) const
+{
+	FRM_TRACE_SCOPE("FRM::SerializeResponse");
+
+	const TArray<TSharedPtr<FJsonValue>>& JsonValues = Response.JsonValues;
+	const bool bUseFirstObject = Response.bUseFirstObject;
 
 	if (bSuccess && !bUseFirstObject) return UFRM_RequestLibrary::JsonArrayToString(JsonValues, JSONDebugMode);
 
@@ -874,6 +1904,31 @@ FString AFicsitRemoteMonitoring::HandleEndpoint(UObject* WorldContext, FString I
 	return UFRM_RequestLibrary::JsonObjectToString(FirstJsonObject, JSONDebugMode);
 }
 
+TSharedRef<const std::string, ESPMode::ThreadSafe> AFicsitRemoteMonitoring::SerializePayload(const FCallEndpointResponse& Response, const bool bSuccess) const
+{
+	if (JSONDebugMode) {
+		const FString OutJson = SerializeResponse(Response, bSuccess);
+
+		FRM_TRACE_SCOPE("FRM::EncodeUtf8");
+		return MakeShared<const std::string, ESPMode::ThreadSafe>(TCHAR_TO_UTF8(*OutJson));
+	}
+
+	FRM_TRACE_SCOPE("FRM::SerializeResponse");
+	std::string Payload;
+
+	if (bSuccess && !Response.bUseFirstObject) {
+		FFRMJsonWriter::WriteArray(Payload, Response.JsonValues);
+	}
+	else if (Response.JsonValues.Num() == 0) {
+		Payload = "{}";
+	}
+	else {
+		FFRMJsonWriter::WriteObject(Payload, Response.JsonValues[0]->AsObject());
+	}
+
+	return MakeShared<const std::string, ESPMode::ThreadSafe>(MoveTemp(Payload));
+}
+
 /*FFGServerErrorResponse AFicsitRemoteMonitoring::HandleCSSEndpoint(FString& out_json, FString InEndpoin)
 {
     bool bSuccess = false;
@@ -896,6 +1951,10 @@ void AFicsitRemoteMonitoring::getAll(UObject* WorldContext, FRequestData Request
 {
     TArray<TSharedPtr<FJsonValue>> JsonArray;  // The composite JSON array to hold data from each endpoint
 
+    // the parts are merged below, a time-sliced part must not hand its array to the caller's deferred pass
+    FFRMTimeSlicer::FDeferScope WaitForPasses(nullptr);
+
+    // the loops go through GetAllAsync, this runs for the push timer and Blueprint callers on the game thread
     // Loop through all registered endpoints
     for (const FAPIEndpoint& APIEndpoint : APIEndpoints)
     {
@@ -906,20 +1965,10 @@ void AFicsitRemoteMonitoring::getAll(UObject* WorldContext, FRequestData Request
         bool bSuccess = false;
         TArray<TSharedPtr<FJsonValue>> EndpointJsonValues;
 
-        if (APIEndpoint.bRequireGameThread)
+        if (APIEndpoint.bRequireGameThread && !IsInGameThread())
         {
-            // If the endpoint requires the GameThread, execute the call asynchronously
-            FThreadSafeBool bAllocationComplete = false;
-            AsyncTask(ENamedThreads::GameThread, [this, &APIEndpoint, WorldContext, RequestData, &EndpointJsonValues, &bAllocationComplete, &bSuccess]() {
-                (this->*APIEndpoint.FunctionPtr)(WorldContext, RequestData, EndpointJsonValues);
-                bSuccess = !EndpointJsonValues.IsEmpty();
-                bAllocationComplete = true;
-            });
-
-            // Block until completion
-            while (!bAllocationComplete) {
-                FPlatformProcess::Sleep(0.0001f);
-            }
+            // nothing waits for the game thread here, off the game thread getAll is answered by GetAllAsync
+            AddErrorJson(EndpointJsonValues, TEXT("The endpoint could not be run on this thread."));
         }
         else
         {
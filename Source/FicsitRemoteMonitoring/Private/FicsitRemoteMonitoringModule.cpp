@@ -13,6 +13,8 @@ DEFINE_LOG_CATEGORY(LogFRMDebug);
 DEFINE_LOG_CATEGORY(LogFRMNotification);
 DEFINE_LOG_CATEGORY(LogWebSocketServer);
 
+UE_TRACE_CHANNEL_DEFINE(FRMChannel);
+
 #define LOCTEXT_NAMESPACE "FFicsitRemoteMonitoringModule"
 
 void FFicsitRemoteMonitoringModule::StartupModule()
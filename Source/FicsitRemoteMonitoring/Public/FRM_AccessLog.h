@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <string_view>
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/StringFwd.h"
+#include "HAL/Event.h"
+
+struct FFRMAccessLogSettings
+{
+	// 0 = off, 1 = failed requests only, 2 = every request and WebSocket subscription
+	int32 Level = 1;
+
+	// at level 2, one in SampleRate successful requests is logged; failed requests always are
+	int32 SampleRate = 1;
+
+	// the file is rotated once it grows past MaxFileSize, keeping MaxFiles files including the current one
+	int64 MaxFileSize = 10 * 1024 * 1024;
+	int32 MaxFiles = 5;
+};
+
+/**
+ * Access log of the web server in Common Log Format.
+ *
+ * The loop threads only copy a fixed-size record into a lock-free ring buffer, records that find it full are counted
+ * and dropped. A writer thread formats them and appends them to access.log, which is rotated to access.1.log and so on.
+ */
+class FICSITREMOTEMONITORING_API FFRMAccessLog
+{
+public:
+	static FFRMAccessLog& Get();
+
+	~FFRMAccessLog();
+
+	void Start(const FString& InPath, const FFRMAccessLogSettings& InSettings);
+
+	/* Writes everything recorded so far and waits for the writer thread */
+	void Stop();
+
+	void SetLevel(int32 InLevel) { Level.store(InLevel, std::memory_order_relaxed); }
+	int32 GetLevel() const { return Level.load(std::memory_order_relaxed); }
+
+	/* Never blocks. Address is the raw IPv4 or IPv6 address as uWS reports it */
+	void Record(std::string_view Address, std::string_view Method, std::string_view Path, std::string_view Query, uint16 Status, uint64 Bytes);
+
+private:
+	struct FRecord
+	{
+		int64 Ticks = 0;
+		uint64 Bytes = 0;
+		uint16 Status = 0;
+		uint8 AddressLength = 0;
+		uint8 Address[16];
+		char Method[12];
+		char Target[180];
+	};
+
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence;
+		FRecord Record;
+	};
+
+	static constexpr uint64 Capacity = 4096;
+
+	bool Push(const FRecord& InRecord);
+	bool Pop(FRecord& OutRecord);
+
+	void WriterLoop();
+	void Rotate();
+	static void Format(const FRecord& InRecord, FAnsiStringBuilderBase& Out);
+
+	FString Path;
+	FFRMAccessLogSettings Settings;
+
+	std::atomic<int32> Level = 0;
+	std::atomic<uint32> SampleCounter = 0;
+	std::atomic<uint64> Dropped = 0;
+
+	TUniquePtr<FSlot[]> Slots;
+	std::atomic<uint64> Head = 0;
+	uint64 Tail = 0;
+
+	FEvent* WakeUp = nullptr;
+	std::atomic<bool> bRunning = false;
+	std::atomic<bool> bStopRequested = false;
+	TFuture<void> Writer;
+};
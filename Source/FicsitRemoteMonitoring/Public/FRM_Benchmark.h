@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "FRM_Factory.h"
+#include "FRM_Polylines.h"
+#include "FRM_WorldSnapshot.h"
+#include "Resources/FGItemDescriptor.h"
+
+class AFicsitRemoteMonitoring;
+
+/**
+ * Deterministic stand-in for a save game, used to benchmark FRM without loading a factory of the wanted size.
+ * Entities are the same plain rows the live collectors build their JSON from, and the item, recipe and building
+ * classes are the ones currently loaded, so every row goes through the same builders and name lookups as in a live game.
+ */
+class FICSITREMOTEMONITORING_API FFRMSyntheticWorld
+{
+public:
+	/* Builds Count factories and belts and Count / 10 storage containers */
+	void Generate(int32 Count, int32 Seed = 1337);
+
+	// Rows of the matching live endpoints, built by their own collectors
+	TArray<TSharedPtr<FJsonValue>> GetFactory() const;
+	TArray<TSharedPtr<FJsonValue>> GetBelts() const;
+	TArray<TSharedPtr<FJsonValue>> GetStorageInv() const;
+	TArray<TSharedPtr<FJsonValue>> GetWorldInv() const;
+
+	TArray<TSubclassOf<UFGItemDescriptor>> Items;
+	TArray<FFRMFactoryRow> Factories;
+
+	// belts, storages and the world inventory, read by getBelts, getStorageInv and getWorldInv
+	FFRMSnapshotStore Snapshots;
+
+private:
+	// stays empty, the benchmark requests no ?lod=
+	FFRMPolylineCache Polylines;
+};
+
+struct FFRMBenchmarkResult
+{
+	FString Name;
+	int32 Count = 0;
+	int32 Iterations = 0;
+	double MinSeconds = 0.0;
+	double MedianSeconds = 0.0;
+	double MeanSeconds = 0.0;
+	uint64 Bytes = 0;
+};
+
+/**
+ * Times the request pipeline stage by stage (router, query parser, collectors, serializers, response cache)
+ * against a synthetic world, and writes the results as a JSON baseline for before/after comparisons.
+ */
+class FICSITREMOTEMONITORING_API FFRMBenchmark
+{
+public:
+	/* The router is only measured when a live subsystem with registered endpoints is passed */
+	explicit FFRMBenchmark(const AFicsitRemoteMonitoring* InSubsystem = nullptr);
+
+	void Run(const TArray<int32>& Counts);
+
+	/* Writes the results to Path. Results present in BaselinePath are added as baselineMedianMs and changePercent. */
+	bool Save(const FString& Path, const FString& BaselinePath) const;
+
+	FString Summary() const;
+
+	const TArray<FFRMBenchmarkResult>& GetResults() const { return Results; }
+
+	/* Runs the default sizes, or the given ones, and saves to the Debug folder. Returns a message for the caller. */
+	static FString RunToDebugFolder(const AFicsitRemoteMonitoring* Subsystem, const TArray<int32>& Counts);
+
+private:
+	/* Body returns the number of bytes it produced, reported alongside the timings */
+	void Measure(const FString& Name, int32 Count, int32 Iterations, TFunctionRef<uint64()> Body);
+
+	const AFicsitRemoteMonitoring* Subsystem;
+	TArray<FFRMBenchmarkResult> Results;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonValue.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Session-lifetime cache of the catalog endpoints, whose data only changes with the game's progress.
+ *
+ * After Start, every registered catalog is built on the game thread, one per frame, and serialized on a background
+ * thread. Requests are then answered from the serialized bytes without touching the game thread. Invalidate drops the
+ * catalogs that depend on progress, they are rebuilt the same way; requests in between build them on the spot.
+ */
+class FICSITREMOTEMONITORING_API FFRMCatalogCache
+{
+public:
+	/* Collects the catalog, runs on the game thread */
+	using FBuildFunction = TFunction<TArray<TSharedPtr<FJsonValue>>()>;
+
+	FFRMCatalogCache();
+
+	/* bProgress marks catalogs that change with purchased schematics or completed research */
+	void Register(const FString& APIName, bool bProgress, FBuildFunction Build);
+
+	void Start(bool bInDebugMode);
+	void Stop();
+
+	/* Drops the progress catalogs, called when a schematic is purchased or research completes */
+	void Invalidate();
+
+	/* Serialized catalog, nullptr for other endpoints and while the catalog is not warm */
+	TSharedPtr<const std::string, ESPMode::ThreadSafe> FindPayload(const FString& APIName) const;
+
+	/* Catalog as JSON, built on the spot if it is not warm. False for endpoints that are no catalog */
+	bool Get(const FString& APIName, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
+
+private:
+	struct FEntry
+	{
+		FBuildFunction Build;
+		bool bProgress = false;
+
+		// renewed by Invalidate, builds and serializations of an older generation are discarded
+		uint32 Generation = 0;
+		bool bBuilt = false;
+
+		TArray<TSharedPtr<FJsonValue>> JsonValues;
+		TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload;
+	};
+
+	// shared with the serialization tasks, which may outlive the cache
+	struct FState
+	{
+		mutable FCriticalSection Mutex;
+		TMap<FString, FEntry> Entries;
+
+		// never reused, so nothing started before a Stop lands in the entries of the next session
+		uint32 Generation = 0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/* Builds the catalog on the calling thread and stores it, unless it was invalidated meanwhile */
+	TArray<TSharedPtr<FJsonValue>> Build(const FString& APIName);
+
+	TSharedRef<FState, ESPMode::ThreadSafe> State;
+	bool bDebugMode = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "HAL/CriticalSection.h"
+#include "FRM_SpatialIndex.h"
+
+/* What an indexed actor is, kept as a byte so binary formats can carry it */
+enum class EFRMEntityKind : uint8
+{
+	Buildable,
+	Drone,
+	RailroadVehicle,
+	Vehicle,
+	Train,
+	Player,
+	Creature,
+	ResourceNode,
+	DropPod,
+	ItemPickup,
+	Num
+};
+
+struct FFRMEntity
+{
+	TWeakObjectPtr<AActor> Actor;
+	EFRMEntityKind Kind = EFRMEntityKind::Num;
+
+	// Assigned in spawn order and never reused within a session, zero is never assigned
+	uint32 CompactID = 0;
+};
+
+/**
+ * World-wide index from the ID the endpoints report (the actor name) to the actor behind it.
+ *
+ * The index is filled once from the world and then kept up to date by the world's actor spawned and destroyed
+ * callbacks, so a lookup never walks a category. Every entity also gets a compact numeric ID for formats that
+ * cannot afford names. Modifications happen on the game thread, lookups are safe from any thread but the
+ * actor pointer may only be dereferenced on the game thread.
+ *
+ * The XY bounds of every entity are kept in a spatial index. New entities are placed by the next RefreshSpatial,
+ * which also moves whatever can move (vehicles, trains, players, creatures); buildings are placed once.
+ */
+class FICSITREMOTEMONITORING_API FFRMEntityIndex
+{
+public:
+	void Start(UWorld* World);
+	void Stop();
+
+	bool Find(const FString& ID, FFRMEntity& OutEntity) const;
+	bool FindByCompactID(uint32 CompactID, FFRMEntity& OutEntity) const;
+
+	/* Compact ID of an indexed actor, zero if the actor is not indexed */
+	uint32 GetCompactID(const AActor* Actor) const;
+
+	int32 Num() const;
+
+	/* Every entity that can move: vehicles, trains, players, creatures */
+	void GetMobile(TArray<FFRMEntity>& OutEntities) const;
+	bool Contains(FName ID) const;
+
+	/* Places new entities and moves the mobile ones in the spatial index. Game thread only. */
+	void RefreshSpatial();
+
+	/* IDs of every placed entity within the area */
+	void QuerySpatial(const FFRMSpatialQuery& Query, TSet<FName>& OutIDs) const;
+
+	static EFRMEntityKind GetKind(const AActor* Actor);
+	static FString GetKindName(EFRMEntityKind Kind);
+
+	/* XY extent of an actor; splines and wires are covered along their length, anything else is a point */
+	static bool GetBounds(AActor* Actor, EFRMEntityKind Kind, FBox2D& OutBounds);
+
+private:
+	void Add(AActor* Actor);
+	void Remove(AActor* Actor);
+
+	mutable FRWLock Lock;
+
+	TMap<FName, FFRMEntity> Entities;
+	TMap<uint32, FName> CompactIDs;
+	uint32 NextCompactID = 1;
+
+	FFRMSpatialIndex Spatial;
+
+	// entities not placed yet, and the ones that can move
+	TSet<FName> Unplaced;
+	TSet<FName> Mobile;
+
+	TWeakObjectPtr<UWorld> BoundWorld;
+	FDelegateHandle SpawnedHandle;
+	FDelegateHandle DestroyedHandle;
+};
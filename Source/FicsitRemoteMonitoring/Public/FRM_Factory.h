@@ -46,8 +46,50 @@
 #include "Logging\StructuredLog.h"
 #include "FRM_Library.h"
 #include "FRM_RequestData.h"
+#include "FRM_EntityIndex.h"
+#include "FRM_Polylines.h"
+#include "FRM_TimeSlicer.h"
+#include "FRM_WorldSnapshot.h"
 #include "FRM_Factory.generated.h"
 
+struct FFRMRecipeItemRow
+{
+	TSubclassOf<UFGItemDescriptor> ItemClass;
+
+	// per cycle as the recipe lists it, and what the manufacturer currently holds
+	int32 RecipeAmount = 0;
+	int32 Stored = 0;
+};
+
+/* What getFactory reports for one manufacturer, copied from the actor so the JSON can be built without it */
+struct FFRMFactoryRow
+{
+	FString ID;
+	FString Name;
+	const UClass* Class = nullptr;
+
+	// unset while no recipe is assigned, the row then reports "Unassigned"
+	TSubclassOf<UFGRecipe> Recipe;
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+
+	float CycleTime = 1.0f;
+	float Productivity = 0.0f;
+	float Potential = 1.0f;
+	float ProductionBoost = 1.0f;
+	float ManufacturingSpeed = 1.0f;
+
+	bool bIsConfigured = false;
+	bool bIsProducing = false;
+	bool bIsPaused = false;
+
+	TArray<FFRMRecipeItemRow> Products;
+	TArray<FFRMRecipeItemRow> Ingredients;
+
+	FFRMPowerInfoRow PowerInfo;
+};
+
 UCLASS()
 class FICSITREMOTEMONITORING_API UFRM_Factory : public UFGBlueprintFunctionLibrary
 {
@@ -55,13 +97,16 @@ class FICSITREMOTEMONITORING_API UFRM_Factory : public UFGBlueprintFunctionLibra
 
 public:
 
-	static TArray<TSharedPtr<FJsonValue>> getBelts(UObject* WorldContext, FRequestData RequestData);
-	static TArray<TSharedPtr<FJsonValue>> getFactory(UObject* WorldContext, FRequestData RequestData, UClass* TypedBuildable);
+	static TArray<TSharedPtr<FJsonValue>> getBelts(UObject* WorldContext, FRequestData RequestData, const FFRMPolylineCache& Polylines, const FFRMSnapshotStore& Snapshots);
+	static TArray<TSharedPtr<FJsonValue>> getFactory(UObject* WorldContext, FRequestData RequestData, FFRMTimeSlicer& TimeSlicer, UClass* TypedBuildable);
+	static TSharedPtr<FJsonObject> getFactoryJSON(AFGBuildableManufacturer* Manufacturer);
+	static FFRMFactoryRow GetFactoryRow(AFGBuildableManufacturer* Manufacturer);
+	static TSharedPtr<FJsonObject> GetFactoryRowJSON(const FFRMFactoryRow& Factory);
 	static TArray<TSharedPtr<FJsonValue>> getFrackingActivator(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getHubTerminal(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getPowerSlug(UObject* WorldContext, FRequestData RequestData);
-	static TArray<TSharedPtr<FJsonValue>> getStorageInv(UObject* WorldContext, FRequestData RequestData);
-	static TArray<TSharedPtr<FJsonValue>> getWorldInv(UObject* WorldContext, FRequestData RequestData);
+	static TArray<TSharedPtr<FJsonValue>> getStorageInv(UObject* WorldContext, FRequestData RequestData, const FFRMSnapshotStore& Snapshots);
+	static TArray<TSharedPtr<FJsonValue>> getWorldInv(UObject* WorldContext, FRequestData RequestData, const FFRMSnapshotStore& Snapshots);
 	static TArray<TSharedPtr<FJsonValue>> getDropPod(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getHypertube(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getPortal(UObject* WorldContext, FRequestData RequestData);
@@ -76,6 +121,7 @@ public:
 	static TArray<TSharedPtr<FJsonValue>> getCloudInv(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getSessionInfo(UObject* WorldContext, FRequestData RequestData);
 	static TArray<TSharedPtr<FJsonValue>> getCables(UObject* WorldContext, FRequestData RequestData);
+	static TArray<TSharedPtr<FJsonValue>> getById(UObject* WorldContext, FRequestData RequestData, const FFRMEntityIndex& EntityIndex);
 
 	friend class AFGBuildableConveyorBase;
 	friend class AFGBuildableTradingPost;
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+struct FFRMGovernorSettings
+{
+	// game thread time FRM may use per frame, 0 disables the governor
+	double Budget = 0.002;
+
+	// share of a server frame at its max tick rate FRM may use, whichever of both is lower applies
+	double FrameShare = 0.1;
+
+	// endpoints answered only from the response cache from governor level 2 on
+	TSet<FString> LowPriority = {
+		TEXT("getDropPod"), TEXT("getPowerSlug"), TEXT("getResourceNode"), TEXT("getResourceGeyser"), TEXT("getResourceWell"),
+		TEXT("getFallingGiftBundles"), TEXT("getRecipes"), TEXT("getSchematics"), TEXT("getResearchTrees")
+	};
+};
+
+/**
+ * Keeps FRM's game thread work within a budget per frame.
+ *
+ * Everything FRM runs on the game thread is timed into the current frame. Once the smoothed cost stays above the
+ * budget for a second, the governor goes up a level; it comes down again after five seconds below half the budget.
+ * Every level doubles the WebSocket push and snapshot intervals and the response cache TTL, and from level 2 on,
+ * low priority endpoints that miss the cache are refused with 503 until the game has caught up.
+ */
+class FICSITREMOTEMONITORING_API FFRMGovernor
+{
+public:
+	static constexpr int32 MaxLevel = 3;
+
+	static FFRMGovernor& Get();
+
+	void Start(const FFRMGovernorSettings& InSettings);
+	void Stop();
+
+	/* 0 while FRM is within its budget */
+	int32 GetLevel() const { return Level.load(std::memory_order_relaxed); }
+
+	/* Factor push intervals, snapshot intervals and cache TTLs are stretched by */
+	int32 GetMultiplier() const { return 1 << GetLevel(); }
+
+	/* True if a request for the endpoint should not reach the game thread right now */
+	bool ShouldDefer(const FString& APIName) const;
+
+	/* Smoothed game thread seconds FRM used per frame, and the budget it is held to */
+	double GetCost() const { return Cost.load(std::memory_order_relaxed); }
+	double GetBudget() const { return EffectiveBudget.load(std::memory_order_relaxed); }
+
+	/* Times FRM work on the game thread, nested scopes are counted once */
+	class FICSITREMOTEMONITORING_API FScope
+	{
+	public:
+		FScope();
+		~FScope();
+
+	private:
+		double StartedAt = 0.0;
+		bool bOutermost = false;
+	};
+
+private:
+	bool Tick(float DeltaTime);
+
+	FFRMGovernorSettings Settings;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// game thread only
+	double FrameCost = 0.0;
+	int32 ScopeDepth = 0;
+	double OverSeconds = 0.0;
+	double UnderSeconds = 0.0;
+
+	std::atomic<int32> Level = 0;
+	std::atomic<double> Cost = 0.0;
+	std::atomic<double> EffectiveBudget = 0.0;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/* A series downsampled into fixed-width buckets, columns share the same index */
+struct FFRMHistorySeries
+{
+	FString Metric;
+	double Step = 0.0;
+	TArray<double> Times;
+	TArray<float> Min;
+	TArray<float> Max;
+	TArray<float> Avg;
+};
+
+/* Accumulates samples from one or more sources into the buckets of a single query */
+class FICSITREMOTEMONITORING_API FFRMHistoryBuckets
+{
+public:
+	/* Step is widened to stay below MaxBuckets */
+	FFRMHistoryBuckets(double InFrom, double InTo, double InStep);
+
+	/* Pattern is a metric name, or a prefix followed by '*' */
+	static bool Matches(const FString& Pattern, const FString& Metric);
+
+	int32 AddSeries(const FString& Metric);
+
+	/* Merges an aggregate of Count samples, a single sample is Add(Series, Time, Value, Value, Value, 1) */
+	void Add(int32 Series, double Time, float Min, float Max, float Sum, int32 Count);
+
+	/* Series in the order they were added, empty buckets left out */
+	TArray<FFRMHistorySeries> ToSeries() const;
+
+	bool IsEmpty() const { return Series.IsEmpty(); }
+
+	/* Upper bound on buckets per series */
+	static constexpr int32 MaxBuckets = 10000;
+
+	const double From;
+	const double To;
+	const double Step;
+
+private:
+	struct FBuckets
+	{
+		FString Metric;
+		TArray<float> Min;
+		TArray<float> Max;
+		TArray<float> Sum;
+		TArray<int32> Count;
+	};
+
+	double Start = 0.0;
+	int32 NumBuckets = 0;
+
+	TMap<FString, int32> SeriesIndex;
+	TArray<FBuckets> Series;
+};
+
+/**
+ * In-memory ring buffer of sampled metrics, stored as struct-of-arrays:
+ * one timestamp column shared by every series, as 32-bit millisecond offsets from a base time,
+ * and one float column per series. Slots a series was not sampled in hold NaN.
+ * Written by the game thread, read by the web server loops.
+ */
+class FICSITREMOTEMONITORING_API FFRMHistory
+{
+public:
+	/* Drops all samples and keeps at most Capacity samples from now on */
+	void Reset(int32 InCapacity);
+
+	/* Appends one sample of every series, Timestamp in Unix seconds */
+	void Append(double Timestamp, const TArray<TPair<FString, float>>& Sample);
+
+	/* Adds the samples of every series matching Metric within the range of Buckets */
+	void Query(const FString& Metric, FFRMHistoryBuckets& Buckets) const;
+
+	TArray<FString> GetMetricNames() const;
+
+	/* Oldest and newest sample in Unix seconds, false while empty */
+	bool GetTimeRange(double& OutOldest, double& OutNewest) const;
+
+private:
+	int32 GetSlot(int32 Age) const { return (Head - Num + Age + Capacity) % Capacity; }
+	double GetTime(int32 Slot) const { return (BaseMs + Offsets[Slot]) / 1000.0; }
+
+	mutable FRWLock Lock;
+
+	int32 Capacity = 0;
+	int32 Head = 0;
+	int32 Num = 0;
+
+	// Unix milliseconds the timestamp offsets are relative to
+	int64 BaseMs = 0;
+	TArray<uint32> Offsets;
+
+	TMap<FString, int32> SeriesIndex;
+	TArray<FString> SeriesNames;
+	TArray<TArray<float>> Values;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "FRM_History.h"
+
+enum class EFRMHistoryTier : uint8
+{
+	Raw,
+	Minute,
+	Hour,
+	Num
+};
+
+struct FFRMHistoryStoreSettings
+{
+	// Retention per tier in seconds, 0 disables the tier
+	double Retention[static_cast<int32>(EFRMHistoryTier::Num)] = { 24.0 * 3600.0, 30.0 * 86400.0, 365.0 * 86400.0 };
+};
+
+/**
+ * Persists the sampled history to disk, one directory per tier (raw samples, 1 minute and 1 hour rollups).
+ *
+ * Every tier is a sequence of append-only segment files covering a fixed time window. A segment is a list
+ * of self-contained blocks: the timestamps are written as Gorilla delta-of-delta bit streams and every series
+ * as a Gorilla XOR bit stream of its float values (min, max and avg for rollups). The segment being written
+ * ends in .open and is renamed to .seg once its window has passed; sealed segments are only ever mapped
+ * for reading.
+ *
+ * The game thread only enqueues samples; encoding, file I/O, rollups and retention all run on the writer thread.
+ */
+class FICSITREMOTEMONITORING_API FFRMHistoryStore
+{
+public:
+	~FFRMHistoryStore();
+
+	void Start(const FString& InDirectory, const FFRMHistoryStoreSettings& InSettings);
+
+	/* Flushes everything that is queued or buffered and waits for the writer thread */
+	void Stop();
+
+	bool IsRunning() const { return bRunning; }
+
+	/* Called by the sampler, never blocks on disk */
+	void Enqueue(double Timestamp, TArray<TPair<FString, float>> Sample);
+
+	/* Adds the stored samples of every series matching Metric from Buckets.From up to, but not including, Before, from the finest tier that covers the range */
+	void Query(const FString& Metric, double Before, FFRMHistoryBuckets& Buckets) const;
+
+private:
+	struct FPendingSample
+	{
+		int64 TimeMs = 0;
+		TArray<TPair<FString, float>> Values;
+	};
+
+	// Samples buffered for the next block of a tier, ValuesPerSeries floats per series and sample
+	struct FTierBlock
+	{
+		TArray<int64> Times;
+		TMap<FString, int32> SeriesIndex;
+		TArray<FString> SeriesNames;
+		TArray<TArray<float>> Values;
+	};
+
+	// Rollup of the raw samples within the current bucket of a tier
+	struct FRollup
+	{
+		int64 BucketMs = -1;
+		TMap<FString, int32> SeriesIndex;
+		TArray<FString> SeriesNames;
+		TArray<float> Min;
+		TArray<float> Max;
+		TArray<double> Sum;
+		TArray<int32> Count;
+	};
+
+	struct FTier
+	{
+		EFRMHistoryTier Tier;
+		FString Directory;
+		int64 StepMs = 0;
+		int64 WindowMs = 0;
+		int64 RetentionMs = 0;
+
+		FTierBlock Block;
+		FRollup Rollup;
+		double BlockStarted = 0.0;
+
+		// samples are never written before this, keeps timestamps monotonic and sealed segments untouched
+		int64 LastTimeMs = 0;
+
+		// segment currently being appended to
+		int64 SegmentStartMs = -1;
+		TUniquePtr<IFileHandle> SegmentFile;
+	};
+
+	void WriterLoop();
+	void Process(const FPendingSample& Sample);
+	/* Values holds ValuesPerSeries entries for each of Names */
+	void AddToBlock(FTier& Tier, int64 TimeMs, const TArray<FString>& Names, const TArray<float>& Values);
+	void AddToRollup(FTier& Tier, int64 TimeMs, const TArray<TPair<FString, float>>& Values);
+	void FlushRollup(FTier& Tier);
+	void FlushBlock(FTier& Tier);
+	void SealSegment(FTier& Tier);
+	void RecoverSegments(FTier& Tier);
+	void ApplyRetention(const FTier& Tier, int64 NowMs);
+
+	static int32 GetValuesPerSeries(EFRMHistoryTier Tier) { return Tier == EFRMHistoryTier::Raw ? 1 : 3; }
+	static TArray<uint8> EncodeBlock(const FTierBlock& Block, int32 ValuesPerSeries);
+	/* Length of the intact prefix of a segment, a crash can leave a partial block behind */
+	static int64 ScanSegment(const uint8* Data, int64 Size, int64& OutLastMs);
+	static void DecodeSegment(const uint8* Data, int64 Size, int32 ValuesPerSeries, const FString& Metric, int64 FromMs, int64 ToMs, FFRMHistoryBuckets& Buckets);
+
+	FString Directory;
+	FFRMHistoryStoreSettings Settings;
+	TArray<FTier> Tiers;
+
+	TQueue<FPendingSample, EQueueMode::Spsc> Queue;
+	FEvent* WakeUp = nullptr;
+	std::atomic<bool> bRunning = false;
+	std::atomic<bool> bStopRequested = false;
+	TFuture<void> Writer;
+
+	// Held by the writer while it appends, seals or deletes segments, and by queries while they read them
+	mutable FRWLock SegmentLock;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Resources/FGItemDescriptor.h"
+
+/* Amount of one item, as grouped from the stacks of an inventory */
+struct FFRMItemStack
+{
+	uint16 ID = 0;
+	int32 Amount = 0;
+};
+
+/**
+ * Numbers every item descriptor with a dense ID, so inventories can be grouped and summed in flat arrays instead of
+ * maps keyed by class.
+ *
+ * IDs are handed out in order of class name at startup, items loaded later get the next free ID on first sight. An ID
+ * is never reused or renumbered, so arrays built with it stay valid for the whole process.
+ */
+class FICSITREMOTEMONITORING_API FFRMItemRegistry
+{
+public:
+	static constexpr uint16 InvalidID = 0;
+
+	static FFRMItemRegistry& Get();
+
+	/* Numbers the item descriptors loaded so far. Game thread */
+	void Build();
+
+	/* ID of the item, InvalidID for nullptr and once all IDs are taken */
+	uint16 GetID(const UClass* Item);
+
+	TSubclassOf<UFGItemDescriptor> GetItem(uint16 ID) const;
+
+	/* Size of an array that can be indexed with every ID handed out so far */
+	int32 Num() const;
+
+private:
+	/* Write lock held */
+	uint16 Register(const UClass* Item);
+
+	mutable FRWLock Lock;
+	TMap<const UClass*, uint16> IDs;
+
+	// indexed by ID, item classes are never unloaded during a session
+	TArray<UClass*> Items{nullptr};
+};
+
+/* Amounts of every item, indexed by item ID */
+struct FICSITREMOTEMONITORING_API FFRMItemCounts
+{
+	TArray<int32> Amounts;
+
+	void Add(const TArray<FFRMItemStack>& Stacks);
+
+	/* Non-zero amounts in order of ID */
+	void GetStacks(TArray<FFRMItemStack>& OutStacks) const;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * Writes the rows of a response as condensed JSON straight into the UTF-8 payload the web server sends.
+ *
+ * TJsonWriter builds a TCHAR string that is converted to UTF-8 once more, and escapes the item and class names
+ * again for every row that repeats them. Here the names shared through FFRMNameCache, which inventory and getFactory
+ * rows repeat thousands of times, are copied from their pre-encoded bytes, and everything else is encoded once.
+ * The output is the same as that of TJsonWriter with the condensed print policy.
+ */
+class FICSITREMOTEMONITORING_API FFRMJsonWriter
+{
+public:
+	static void WriteArray(std::string& Out, const TArray<TSharedPtr<FJsonValue>>& Values);
+	static void WriteObject(std::string& Out, const TSharedPtr<FJsonObject>& Object);
+
+	/* Appends Value as a quoted JSON string, escaped like TJsonWriter escapes it */
+	static void WriteString(std::string& Out, const FString& Value);
+
+private:
+	static void WriteValue(std::string& Out, const TSharedPtr<FJsonValue>& Value);
+	static void WriteNumber(std::string& Out, double Value);
+};
@@ -5,6 +5,7 @@
 #include "Configs/Config_FactoryStruct.h"
 #include "FGBlueprintFunctionLibrary.h"
 #include "FicsitRemoteMonitoringModule.h"
+#include "FRM_ItemRegistry.h"
 #include "FGBuildableSubsystem.h"
 #include "Buildables\FGBuildableManufacturer.h"
 #include "FGPowerInfoComponent.h"
@@ -13,6 +14,15 @@
 #include "JsonUtilities.h"
 #include "FRM_Library.generated.h"
 
+/* The circuit and consumption reported as PowerInfo, -1 and zero for buildings without a circuit */
+struct FFRMPowerInfoRow
+{
+	int32 CircuitGroupID = -1;
+	int32 CircuitID = -1;
+	float PowerConsumed = 0.0f;
+	float MaxPowerConsumed = 0.0f;
+};
+
 UCLASS()
 class FICSITREMOTEMONITORING_API UFRM_Library : public UFGBlueprintFunctionLibrary
 {
@@ -23,18 +33,24 @@ public:
 	static TSharedPtr<FJsonObject> getActorFactoryCompXYZ(UFGFactoryConnectionComponent* BeltPipe);
 	static TSharedPtr<FJsonObject> getActorPipeXYZ(UFGPipeConnectionComponent* BeltPipe);
 	static TSharedPtr<FJsonObject> getActorFeaturesJSON(AActor* Actor, FString DisplayName, FString TypeName);
+	static TSharedPtr<FJsonObject> GetLocationJSON(const FVector& Location, float Yaw);
+	static TSharedPtr<FJsonObject> GetPointFeaturesJSON(const FVector& Location, const FString& DisplayName, const FString& TypeName);
 	static TMap<TSubclassOf<UFGItemDescriptor>, int32> GetGroupedInventoryItems(const UFGInventoryComponent* Inventory);
 	static TMap<TSubclassOf<UFGItemDescriptor>, int32> GetGroupedInventoryItems(const TArray<FInventoryStack>& InventoryStacks);
 	static void GetGroupedInventoryItems(const TArray<FInventoryStack>& InventoryStacks, TMap<TSubclassOf<UFGItemDescriptor>, int32>& InventoryItems);
 	static void GetGroupedInventoryItems(const UFGInventoryComponent* Inventory, TMap<TSubclassOf<UFGItemDescriptor>, int32>& InventoryItems);
+	static void GetGroupedInventoryItems(const TArray<FInventoryStack>& InventoryStacks, TArray<FFRMItemStack>& InventoryItems);
+	static void GetGroupedInventoryItems(const UFGInventoryComponent* Inventory, TArray<FFRMItemStack>& InventoryItems);
 	static TArray<TSharedPtr<FJsonValue>> GetInventoryJSON(const TMap<TSubclassOf<UFGItemDescriptor>, int32>& Items);
 	static TArray<TSharedPtr<FJsonValue>> GetInventoryJSON(const TArray<FItemAmount>& Items);
+	static TArray<TSharedPtr<FJsonValue>> GetInventoryJSON(const TArray<FFRMItemStack>& Items);
 	static TSharedPtr<FJsonObject> GetItemValueObject(const TSubclassOf<UFGItemDescriptor>& Item, const int Amount);
 	static TSharedPtr<FJsonObject> GetResourceNodeJSON(AActor* Actor, const bool bIncludeFeatures = false);
 	static TSharedPtr<FJsonObject> CreateBaseJsonObject(const UObject* Actor);
 	static FString APItoJSON(TArray<TSharedPtr<FJsonValue>> JSONArray, UObject* WorldContext);
 	static bool IsIntInRange(int32 Number, int32 LowerBound, int32 UpperBound);
 	static TSharedPtr<FJsonObject> GetActorLineFeaturesJSON(FVector PointOne, FVector PointTwo, FString DisplayName, FString TypeName);
+	static TSharedPtr<FJsonObject> GetActorLineFeaturesJSON(const TArray<FVector>& Points, FString DisplayName, FString TypeName);
 
 	static double SafeDivide_Double(double Numerator, double Denominator)
 	{
@@ -48,5 +64,10 @@ public:
 	
 	static TSharedPtr<FJsonValue> ConvertStringToFJsonValue(const FString& JsonString);
 	static TSharedPtr<FJsonObject> getPowerConsumptionJSON(UFGPowerInfoComponent* powerInfo);
+	static FFRMPowerInfoRow GetPowerInfoRow(UFGPowerInfoComponent* PowerInfo);
+	static TSharedPtr<FJsonObject> GetPowerInfoJSON(const FFRMPowerInfoRow& PowerInfo);
 	static TSharedPtr<FJsonObject> ConvertVectorToFJsonObject(FVector JsonVector);
+
+	/* LoadObject<UClass> of a blueprint class path, recorded by the thread audit */
+	static UClass* LoadClassByPath(const TCHAR* Path);
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/* Phases of an API request, each tracked in its own latency histogram */
+enum class EFRMRequestPhase : uint8
+{
+	GameThreadWait,
+	Collect,
+	Serialize,
+	Send,
+	Count
+};
+
+/* Phase durations of a single request, collected when the client asks for a Server-Timing header */
+struct FRequestTiming
+{
+	double Seconds[static_cast<int32>(EFRMRequestPhase::Count)] = {};
+};
+
+/* Gauges owned by the web server, sampled by the caller at scrape time */
+struct FFRMServerGauges
+{
+	int32 ServerLoops = 0;
+	int32 WebSocketClients = 0;
+	int32 Subscriptions = 0;
+	int32 GovernorLevel = 0;
+	double GovernorCost = 0.0;
+	double GovernorBudget = 0.0;
+	int32 RateLimitedClients = 0;
+
+	// queued game thread jobs by priority class, and the scheduler's cost estimate by endpoint slot
+	TArray<int32> SchedulerQueued;
+	TArray<double> CostEstimates;
+};
+
+/**
+ * Process-wide counters and histograms for FRM's own cost, exported in OpenMetrics text format on /metrics.
+ * Every thread writes into its own shard without locks or atomic read-modify-writes; shards are only merged on scrape.
+ */
+class FICSITREMOTEMONITORING_API FFRMMetrics
+{
+public:
+	static FFRMMetrics& Get();
+
+	/* Returns the metrics slot of an endpoint, registering it on first use. INDEX_NONE once all slots are taken. */
+	int32 RegisterEndpoint(const FString& APIName);
+
+	void RecordRequest(int32 EndpointIndex, uint64 ResponseBytes);
+	void RecordPhase(int32 EndpointIndex, EFRMRequestPhase Phase, double Seconds, FRequestTiming* Timing = nullptr);
+	void RecordUnmatchedRequest();
+	void RecordThrottled(int32 EndpointIndex);
+	void RecordCacheLookup(bool bHit);
+	void RecordStaticFile(uint64 Bytes);
+	void RecordWebSocketMessage(uint64 Bytes);
+	void RecordBackpressure(int64 DeltaBytes);
+
+	/* Game thread frame time, so load on the web server can be correlated with hitches */
+	void RecordFrame(double Seconds);
+
+	FString Scrape(const FFRMServerGauges& Gauges);
+
+	static constexpr int32 MaxEndpoints = 128;
+
+private:
+	struct FShard;
+
+	FShard& GetShard();
+
+	FCriticalSection Mutex;
+	TArray<FShard*> Shards;
+	TArray<FString> EndpointNames;
+};
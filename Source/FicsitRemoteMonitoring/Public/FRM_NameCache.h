@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "HAL/CriticalSection.h"
+
+/* Names of one class, looked up once per session */
+struct FICSITREMOTEMONITORING_API FFRMClassNames
+{
+	// item name for item descriptors, the class name otherwise
+	FString DisplayName;
+	FString ClassName;
+
+	// Solid, Liquid, Gas, Heat, Invalid or Unknown, empty for classes that are no item descriptor
+	FString Form;
+
+	// shared by every row that names the class, so collectors do not allocate a string per row
+	TSharedPtr<FJsonValue> JDisplayName;
+	TSharedPtr<FJsonValue> JClassName;
+	TSharedPtr<FJsonValue> JForm;
+
+	// the same values as quoted and escaped UTF-8, copied by FFRMJsonWriter wherever a row holds one of the values above
+	std::string DisplayNameJson;
+	std::string ClassNameJson;
+	std::string FormJson;
+};
+
+/**
+ * Process-wide cache of item and class names keyed by class.
+ *
+ * UFGItemDescriptor::GetItemName and UKismetSystemLibrary::GetClassDisplayName allocate new strings on every call,
+ * and collectors call them for every row, often for every stack of an inventory. Classes are never unloaded during a
+ * session, so the names are resolved once and shared. The cache is dropped when the language changes.
+ */
+class FICSITREMOTEMONITORING_API FFRMNameCache
+{
+public:
+	static FFRMNameCache& Get();
+
+	/* Names of the class, nullptr is cached as an empty class name like GetClassDisplayName returns it */
+	static TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> Find(const UClass* Class);
+
+	void Empty();
+
+	/* Appends the encoded bytes if Value is one of the shared name values, false for any other value */
+	static bool AppendEncoded(std::string& Out, const FJsonValue* Value);
+
+private:
+	FFRMNameCache();
+
+	static TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe> Resolve(const UClass* Class);
+
+	FRWLock Lock;
+	TMap<const UClass*, TSharedRef<const FFRMClassNames, ESPMode::ThreadSafe>> Names;
+
+	// shared name values to their encoded bytes, owned by the entries of Names
+	TMap<const FJsonValue*, const std::string*> Encoded;
+};
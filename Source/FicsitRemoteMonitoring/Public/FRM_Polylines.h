@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Curved belts and rails as polylines in several levels of detail, behind ?lod= on getBelts and getTrainRails.
+ *
+ * The spline of a segment is sampled densely on first use and simplified with Douglas-Peucker once per level.
+ * Buildables never move after placement, so every segment is computed once and kept until it is dismantled,
+ * and so is the absence of a spline. Get and Prepare read the actor and belong on the game thread, Find is
+ * safe to use from any thread.
+ */
+class FICSITREMOTEMONITORING_API FFRMPolylineCache
+{
+public:
+	static constexpr int32 NumLods = 4;
+
+	void Start(UWorld* World);
+	void Stop();
+
+	/* Polyline of a spline buildable at the level of detail, 0 being the most detailed; false without a spline. Game thread */
+	bool Get(const AActor* Actor, int32 Lod, TArray<FVector>& OutPoints);
+
+	/* Computes the polylines of a spline buildable unless they are cached already. Game thread */
+	void Prepare(const AActor* Actor);
+
+	/* Cached polyline only, for callers that must not touch the actor */
+	bool Find(const FObjectKey& Key, int32 Lod, TArray<FVector>& OutPoints) const;
+
+	/* Level of detail requested by ?lod=, INDEX_NONE without the parameter; OutError is set if it is malformed */
+	static int32 ParseLod(const TMap<FString, FString>& QueryParams, FString& OutError);
+
+	/* Keeps the points that deviate from the simplified line by more than Tolerance, the ends are always kept */
+	static void Simplify(const TArray<FVector>& Points, double Tolerance, TArray<FVector>& OutPoints);
+
+	/* Points along the spline of a belt, pipe or rail every meter in world space, long splines are capped; false without a spline */
+	static bool Sample(const AActor* Actor, TArray<FVector>& OutPoints);
+
+private:
+	// left empty for actors without a spline, like conveyor lifts
+	struct FEntry
+	{
+		TArray<FVector> Lods[NumLods];
+	};
+
+	void OnActorDestroyed(AActor* Actor);
+
+	mutable FRWLock Lock;
+	TMap<FObjectKey, FEntry> Entries;
+
+	TWeakObjectPtr<UWorld> BoundWorld;
+	FDelegateHandle DestroyedHandle;
+};
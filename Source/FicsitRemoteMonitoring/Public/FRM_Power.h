@@ -14,6 +14,8 @@
 #include "FGPowerCircuit.h"
 #include "FGCircuitSubsystem.h"
 #include "FRM_RequestData.h"
+#include "FRM_PowerGraph.h"
+#include "FRM_TimeSlicer.h"
 #include "FRM_Power.generated.h"
 
 UCLASS()
@@ -24,9 +26,13 @@ class FICSITREMOTEMONITORING_API UFRM_Power : public UFGBlueprintFunctionLibrary
 public:
 	static TArray<TSharedPtr<FJsonValue>> getPower(UObject* WorldContext);
 	static TArray<TSharedPtr<FJsonValue>> getSwitches(UObject* WorldContext);
-	static TArray<TSharedPtr<FJsonValue>> setSwitches(UObject* WorldContext, FRequestData RequestData);
+	static TArray<TSharedPtr<FJsonValue>> setSwitches(UObject* WorldContext, FRequestData RequestData, FFRMPowerGraph& Graph);
 	static TArray<TSharedPtr<FJsonValue>> getGenerators(UObject* WorldContext, UClass* TypedBuildable);
-	static TArray<TSharedPtr<FJsonValue>> getPowerUsage(UObject* WorldContext);
+	static TArray<TSharedPtr<FJsonValue>> getPowerUsage(UObject* WorldContext, FFRMTimeSlicer& TimeSlicer);
+	static TArray<TSharedPtr<FJsonValue>> getPowerGraph(UObject* WorldContext, FFRMPowerGraph& Graph);
+
+	/* Appends production, consumption, capacity and battery percentage of every circuit group as power.<CircuitGroupID>.<name> */
+	static void GetCircuitSample(UObject* WorldContext, TArray<TPair<FString, float>>& OutSample);
 	
 private:
 	friend class UFGPowerCircuit;
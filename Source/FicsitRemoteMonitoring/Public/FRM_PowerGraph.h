@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Buildables/FGBuildableCircuitSwitch.h"
+
+/* A power circuit, the wires are summed up since they never connect two circuits */
+struct FFRMPowerGraphNode
+{
+	int32 CircuitID = INDEX_NONE;
+	int32 Wires = 0;
+	float WireLength = 0.0f;
+};
+
+/* A switch between two circuits, its state is read when the graph is served */
+struct FFRMPowerGraphEdge
+{
+	TWeakObjectPtr<AFGBuildableCircuitSwitch> Switch;
+	int32 From = INDEX_NONE;
+	int32 To = INDEX_NONE;
+};
+
+/**
+ * Circuit topology behind getPowerGraph, and the switch ID index behind setSwitches. Walking every wire
+ * and switch is only done again after the circuit subsystem added, removed, connected or disconnected
+ * a circuit connection, which includes building and dismantling switches.
+ */
+class FICSITREMOTEMONITORING_API FFRMPowerGraph
+{
+public:
+	/* Subscribes to the circuit subsystem once per process, the hooks outlive worlds */
+	static void InstallHooks();
+
+	/* Rebuilds the topology if a circuit connection changed since it was built. Game thread only. */
+	void Update(UWorld* World);
+
+	const TArray<FFRMPowerGraphNode>& GetNodes() const { return Nodes; }
+	const TArray<FFRMPowerGraphEdge>& GetEdges() const { return Edges; }
+
+	/* Switch with the given actor name, as reported in getSwitches; nullptr if there is none. Call Update first. */
+	AFGBuildableCircuitSwitch* FindSwitch(const FString& ID) const;
+
+	/* Increments with every rebuild, lets clients skip laying out an unchanged graph */
+	uint32 GetVersion() const { return Version; }
+
+private:
+	static void NotifyTopologyChanged();
+
+	// Frame of the last change; circuits are rebuilt by the subsystem's tick after a change
+	static std::atomic<uint64> LastChangeFrame;
+
+	TArray<FFRMPowerGraphNode> Nodes;
+	TArray<FFRMPowerGraphEdge> Edges;
+	TMap<FName, int32> EdgeIndex;
+	uint64 BuiltFrame = 0;
+	uint32 Version = 0;
+};
@@ -27,6 +27,7 @@
 #include <Buildables/FGBuildableGeneratorNuclear.h>
 #include "FGItemPickup.h"
 #include "FRM_Library.h"
+#include "FRM_ProductionTracker.h"
 #include "FRM_Production.generated.h"
 
 /**
@@ -38,7 +39,7 @@ class FICSITREMOTEMONITORING_API UFRM_Production : public UBlueprintFunctionLibr
 	GENERATED_BODY()
 	
 public:
-	static TArray<TSharedPtr<FJsonValue>> getProdStats(UObject* WorldContext);
+	static TArray<TSharedPtr<FJsonValue>> getProdStats(UObject* WorldContext, FFRMProductionTracker& Tracker);
 	static TArray<TSharedPtr<FJsonValue>> getSinkList(UObject* WorldContext);
 	static TArray<TSharedPtr<FJsonValue>> getResourceSink(UObject* WorldContext, EResourceSinkTrack ResourceSinkTrack);
 	static TArray<TSharedPtr<FJsonValue>> getRecipes(UObject* WorldContext);
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectKey.h"
+#include "Resources/FGItemDescriptor.h"
+
+class AFGBuildable;
+
+/* Current and maximum per-minute rates of one item, summed over every building that produces or consumes it */
+struct FFRMItemRates
+{
+	TSubclassOf<UFGItemDescriptor> Item;
+	float CurrentProduced = 0.0f;
+	float MaxProduced = 0.0f;
+	float CurrentConsumed = 0.0f;
+	float MaxConsumed = 0.0f;
+};
+
+/**
+ * Maintained production and consumption totals of manufacturers, extractors and fuel generators.
+ *
+ * Every building remembers what it added to the per-item totals, together with a signature of what those
+ * rates depend on (recipe or resource, potential, production boost, productivity rounded to whole percent).
+ * The world is scanned once on Start; after that buildings are added and removed as they are built and
+ * dismantled, and recipe, potential and production boost changes are reported by hooks, so only those
+ * buildings are recomputed. Productivity and the fuel a generator burns change without any event, they are
+ * checked round robin for a bounded number of buildings per refresh. The totals are dense arrays indexed by item.
+ */
+class FICSITREMOTEMONITORING_API FFRMProductionTracker
+{
+public:
+	static void InstallHooks();
+
+	/* Scans the world once and follows it from then on, game thread */
+	void Start(UWorld* World);
+	void Stop();
+
+	/* Refreshes when the totals are older than MaxAge seconds, then copies every item with a producer or consumer, sorted by item name. Game thread */
+	void GetRates(TArray<FFRMItemRates>& OutRates, double MaxAge = 1.0);
+
+	void Reset();
+
+private:
+	struct FRate
+	{
+		int32 Item = INDEX_NONE;
+		double CurrentProduced = 0.0;
+		double MaxProduced = 0.0;
+		double CurrentConsumed = 0.0;
+		double MaxConsumed = 0.0;
+	};
+
+	struct FBuilding
+	{
+		uint32 Signature = 0;
+		bool bComputed = false;
+		TArray<FRate> Rates;
+	};
+
+	/* Recorded by the hooks, picked up by the next refresh */
+	static void NotifyChanged(const AFGBuildable* Buildable);
+
+	void Refresh();
+
+	/* Recomputes the rates of Buildable if its signature changed, false while a potential change is still pending */
+	bool Check(AFGBuildable* Buildable);
+
+	void Track(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	/* Swaps the rates of Buildable when Signature changed, Compute is only run in that case */
+	template<typename FComputeRates>
+	void Update(const AFGBuildable* Buildable, uint32 Signature, FComputeRates&& Compute);
+
+	void Apply(const TArray<FRate>& Rates, double Sign);
+	int32 GetItemIndex(TSubclassOf<UFGItemDescriptor> Item);
+
+	static FCriticalSection ChangesLock;
+	static TSet<TObjectKey<AFGBuildable>> Changes;
+
+	FCriticalSection Lock;
+
+	TMap<TObjectKey<AFGBuildable>, FBuilding> Buildings;
+	double LastRefresh = 0.0;
+	bool bRefreshed = false;
+
+	// every tracked building in the order they are checked round robin, and the next one to check
+	TArray<TWeakObjectPtr<AFGBuildable>> Tracked;
+	int32 Cursor = 0;
+
+	// changed buildings whose new potential has not taken effect yet
+	TSet<TObjectKey<AFGBuildable>> Settling;
+
+	TWeakObjectPtr<UWorld> BoundWorld;
+	FDelegateHandle SpawnedHandle;
+	FDelegateHandle DestroyedHandle;
+
+	TMap<UClass*, int32> ItemIndex;
+	TArray<TSubclassOf<UFGItemDescriptor>> Items;
+	TArray<FText> ItemNames;
+	TArray<int32> SortedItems;
+
+	// indexed by ItemIndex; buildings referencing the item, and the summed rates
+	TArray<int32> References;
+	TArray<double> CurrentProduced;
+	TArray<double> MaxProduced;
+	TArray<double> CurrentConsumed;
+	TArray<double> MaxConsumed;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <string_view>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FFRMRateLimitSettings
+{
+	// tokens every client gets back per second, 0 disables the limiter
+	double Rate = 50.0;
+
+	// tokens a client can save up for a burst of requests
+	double Burst = 150.0;
+
+	// tokens a request costs, endpoints not listed cost 1
+	TMap<FString, double> Costs = {
+		{TEXT("getAll"), 30.0},
+		{TEXT("getFactory"), 10.0}, {TEXT("getBelts"), 10.0}, {TEXT("getPipes"), 10.0}, {TEXT("getCables"), 10.0}, {TEXT("getTrainRails"), 10.0},
+		{TEXT("getStorageInv"), 5.0}, {TEXT("getWorldInv"), 5.0}
+	};
+};
+
+/**
+ * Limits the API requests of every remote address with a token bucket.
+ *
+ * Every request takes the cost of its endpoint from the bucket of its address, so a client polling getAll runs out
+ * long before one polling getPower. Requests that find too few tokens are refused with 429 and told when enough
+ * will be back. Buckets that have filled up again are forgotten.
+ */
+class FICSITREMOTEMONITORING_API FFRMRateLimiter
+{
+public:
+	static FFRMRateLimiter& Get();
+
+	void Start(const FFRMRateLimitSettings& InSettings);
+	void Stop();
+
+	/**
+	 * Takes the tokens for a request, or returns false with the seconds until the client may try again.
+	 * Address is the raw IPv4 or IPv6 address as uWS reports it. Thread safe.
+	 */
+	bool TryAcquire(std::string_view Address, const FString& APIName, int32& OutRetryAfter);
+
+	/* Addresses with a bucket, including full ones not swept yet */
+	int32 GetTrackedClients() const;
+
+private:
+	/* IPv4 addresses, also when mapped into IPv6, only fill Low */
+	struct FAddress
+	{
+		uint64 High = 0;
+		uint64 Low = 0;
+
+		bool operator==(const FAddress& Other) const { return High == Other.High && Low == Other.Low; }
+		friend uint32 GetTypeHash(const FAddress& Address) { return HashCombine(GetTypeHash(Address.High), GetTypeHash(Address.Low)); }
+	};
+
+	struct FBucket
+	{
+		double Tokens = 0.0;
+		double UpdatedAt = 0.0;
+	};
+
+	struct FShard
+	{
+		FCriticalSection Mutex;
+		TMap<FAddress, FBucket> Buckets;
+	};
+
+	static constexpr int32 NumShards = 16;
+
+	// a shard is swept for full buckets once it tracks this many addresses
+	static constexpr int32 SweepThreshold = 256;
+
+	static FAddress MakeAddress(std::string_view Address);
+
+	void Sweep(FShard& Shard, double Now, double Rate, double Burst);
+
+	mutable FRWLock SettingsLock;
+	FFRMRateLimitSettings Settings;
+
+	FShard Shards[NumShards];
+	std::atomic<int32> TrackedClients = 0;
+};
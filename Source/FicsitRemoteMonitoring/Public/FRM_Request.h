@@ -13,6 +13,9 @@ public:
 	static void SendErrorJson(uWS::HttpResponse<false>* res, const FString& Status, const FString& Json);
 	static void SendErrorMessage(uWS::HttpResponse<false>* res, const FString& Status, const FString& Message);
 
+	/* Error with a Retry-After header, for requests refused to protect the game */
+	static void SendRetryLater(uWS::HttpResponse<false>* res, const FString& Status, int32 RetryAfterSeconds, const FString& Message);
+
 	static void AddResponseHeaders(uWS::HttpResponse<false>* res, const bool bIncludeContentType);
 
 	static TSharedPtr<FJsonObject> GenerateError(const FString& Message);
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "FRM_Metrics.h"
 #include "FRM_RequestData.generated.h"
 
 USTRUCT(BlueprintType)
@@ -13,4 +14,21 @@ struct FRequestData
 	FString Method = "GET";
 
 	TArray<TSharedPtr<FJsonValue>> Body;
+
+	// Set for ?timing=1 requests, shared by all copies of this request
+	TSharedPtr<FRequestTiming, ESPMode::ThreadSafe> Timing;
+
+	// Set for ?bbox= and ?near= requests, IDs of the entities within the requested area
+	TSharedPtr<const TSet<FName>, ESPMode::ThreadSafe> AreaFilter;
+
+	/* True if the request is restricted to an area that does not contain Object, lets collectors skip it early */
+	bool IsOutsideArea(const UObject* Object) const
+	{
+		return IsOutsideArea(Object->GetFName());
+	}
+
+	bool IsOutsideArea(const FName ID) const
+	{
+		return AreaFilter.IsValid() && !AreaFilter->Contains(ID);
+	}
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/* Serialized API response, shared between every request that hits the same cache entry */
+struct FICSITREMOTEMONITORING_API FCachedResponse
+{
+	TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload;
+	bool bSuccess = false;
+
+	// Metrics slot of the endpoint that produced this response
+	int32 MetricsIndex = INDEX_NONE;
+
+	// Game thread frames the collector spanned
+	int32 Frames = 0;
+
+	// the collector was cut off and the request should be retried, never cached as bSuccess is false
+	bool bCutOff = false;
+};
+
+enum class EFRMCacheLookup : uint8
+{
+	// OutResponse holds the cached response
+	Hit,
+
+	// the caller runs the endpoint and has to Complete the key, successful or not
+	Miss,
+
+	// another request is running the endpoint, OnJoined is called with its result
+	Joined
+};
+
+/**
+ * Thread-safe response cache shared by all web server loops.
+ * Entries are reused for MaxAge seconds. Concurrent misses on the same key are collapsed: only the first request
+ * runs the endpoint, the others register a callback and return, so no loop blocks on another loop's request.
+ */
+class FICSITREMOTEMONITORING_API FFRMResponseCache
+{
+public:
+	EFRMCacheLookup Acquire(const FString& Key, double MaxAge, FCachedResponse& OutResponse, TUniqueFunction<void(const FCachedResponse&)>&& OnJoined);
+
+	/* Caches a successful response and hands it to every joined request, on the calling thread */
+	void Complete(const FString& Key, double MaxAge, const FCachedResponse& Response);
+
+	/* Cached response no older than MaxAge, never computes */
+	bool Find(const FString& Key, double MaxAge, FCachedResponse& OutResponse);
+
+	/* Forgets the entries and the keys in flight, requests that joined one are never answered */
+	void Empty();
+
+private:
+	struct FEntry
+	{
+		FCachedResponse Response;
+		double Timestamp = 0.0;
+	};
+
+	FCriticalSection Mutex;
+	TMap<FString, FEntry> Entries;
+
+	// requests waiting for the key that is being computed
+	TMap<FString, TArray<TUniqueFunction<void(const FCachedResponse&)>>> InFlight;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "FRM_Metrics.h"
+
+/* Order in which queued game thread work runs */
+enum class EFRMPriority : uint8
+{
+	Interactive,
+	Normal,
+	Bulk,
+	Count
+};
+
+struct FFRMSchedulerSettings
+{
+	// endpoints estimated below this many seconds are interactive, above BulkCost they are bulk
+	double InteractiveCost = 0.001;
+	double BulkCost = 0.01;
+
+	// seconds a job waits before it is promoted by one priority
+	double AgingInterval = 0.25;
+};
+
+/**
+ * Orders the endpoint work that waits for the game thread by how expensive the endpoint has been so far.
+ *
+ * Every endpoint keeps a moving average of its measured collect time, which puts it in a priority class. Jobs are
+ * queued by class and every game thread task the scheduler posts runs the most urgent job at that moment instead of
+ * its own, so a getSessionInfo arriving behind a getAll is answered first. A job is promoted by one class for every
+ * AgingInterval it waits, so bulk work is delayed but never starved.
+ */
+class FICSITREMOTEMONITORING_API FFRMScheduler
+{
+public:
+	static FFRMScheduler& Get();
+
+	void Start(const FFRMSchedulerSettings& InSettings);
+
+	/* Forgets the estimates and drops the queued jobs without running them, their requests are never answered */
+	void Stop();
+
+	/* Queues work for the game thread. HTTP requests hand their result back to their loop from Work, other callers wait for it the same way as for AsyncTask */
+	void Dispatch(EFRMPriority Priority, TUniqueFunction<void()>&& Work);
+
+	/* Class of an endpoint by its estimate, Normal until it has been measured */
+	EFRMPriority GetPriority(int32 EndpointIndex) const;
+
+	/* Adds a measured collect time to the estimate of an endpoint */
+	void RecordCost(int32 EndpointIndex, double Seconds);
+
+	/* Smoothed collect seconds of an endpoint, 0 until it has been measured */
+	double GetEstimate(int32 EndpointIndex) const;
+
+	int32 GetQueued(EFRMPriority Priority) const;
+
+private:
+	struct FJob
+	{
+		TUniqueFunction<void()> Work;
+		double QueuedAt = 0.0;
+	};
+
+	/* Runs the most urgent job, game thread */
+	void RunNext();
+
+	std::atomic<double> InteractiveCost = 0.001;
+	std::atomic<double> BulkCost = 0.01;
+	std::atomic<double> AgingInterval = 0.25;
+
+	std::atomic<double> Estimates[FFRMMetrics::MaxEndpoints] = {};
+
+	mutable FCriticalSection Mutex;
+	TArray<FJob> Queues[static_cast<int32>(EFRMPriority::Count)];
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/* Area a request is restricted to by ?bbox=minx,miny,maxx,maxy or ?near=x,y&radius=r, in world units */
+struct FICSITREMOTEMONITORING_API FFRMSpatialQuery
+{
+	FBox2D Box = FBox2D(ForceInit);
+	FVector2D Center = FVector2D::ZeroVector;
+
+	// negative for a bbox query
+	double Radius = -1.0;
+
+	/* False if the request has neither parameter; OutError is set if it has one that is malformed */
+	static bool Parse(const TMap<FString, FString>& QueryParams, FFRMSpatialQuery& OutQuery, FString& OutError);
+
+	bool Intersects(const FBox2D& Bounds) const;
+};
+
+/**
+ * Uniform grid over the XY plane. Every entry is kept in each cell its bounds overlap, so lines like belts,
+ * pipes and rails are found wherever they pass. Entries spanning more cells than MaxCellsPerEntry are tested
+ * on every query instead. Safe to query from any thread.
+ */
+class FICSITREMOTEMONITORING_API FFRMSpatialIndex
+{
+public:
+	void Update(FName ID, const FBox2D& Bounds);
+	void Remove(FName ID);
+	void Reset();
+
+	void Query(const FFRMSpatialQuery& Query, TSet<FName>& OutIDs) const;
+
+private:
+	// 100 m, a little more than a large factory floor
+	static constexpr double CellSize = 10000.0;
+	static constexpr int32 MaxCellsPerEntry = 256;
+
+	struct FEntry
+	{
+		FBox2D Bounds;
+		FIntRect Cells;
+		bool bOversized = false;
+	};
+
+	static FIntRect GetCells(const FBox2D& Bounds);
+
+	void Unlink(FName ID, const FEntry& Entry);
+	void Link(FName ID, const FEntry& Entry);
+
+	mutable FRWLock Lock;
+
+	TMap<FName, FEntry> Entries;
+	TMap<FIntPoint, TArray<FName>> Cells;
+	TSet<FName> Oversized;
+};
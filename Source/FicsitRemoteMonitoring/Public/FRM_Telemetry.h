@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "FRM_EntityIndex.h"
+
+struct FFRMMoverSample
+{
+	uint32 CompactID = 0;
+	EFRMEntityKind Kind = EFRMEntityKind::Num;
+	FVector3f Location = FVector3f::ZeroVector;
+	float Yaw = 0.0f;
+
+	// world units per second
+	FVector3f Velocity = FVector3f::ZeroVector;
+};
+
+/**
+ * Positions of everything that moves, for maps animating trains, drones, vehicles and players between samples.
+ *
+ * Capture takes only what a client needs to dead-reckon, straight from the actors, into a back buffer and swaps it
+ * with the front one, so encoding and sending never hold up the game thread and never see a half written sample.
+ * Subscribers of "telemetry" get the front buffer as a binary WebSocket message, little endian:
+ *   "FRMV", uint32 sequence, float64 game time in seconds, uint32 count, then per mover 36 bytes:
+ *   uint32 compact ID, uint8 kind, 3 bytes reserved, float32 x, y, z, float32 yaw in degrees, float32 vx, vy, vz.
+ */
+class FICSITREMOTEMONITORING_API FFRMTelemetry
+{
+public:
+	// WebSocket subscription the samples are pushed to
+	static constexpr const TCHAR* Channel = TEXT("telemetry");
+
+	/* Samples every mover into the back buffer and publishes it. Game thread only. */
+	void Capture(UWorld* World, const FFRMEntityIndex& EntityIndex);
+
+	/* The latest published sample, nullptr before the first capture */
+	TSharedPtr<const std::string, ESPMode::ThreadSafe> Encode() const;
+
+	void Reset();
+
+private:
+	static bool Sample(AActor* Actor, FFRMMoverSample& OutSample);
+
+	// guards the front buffer, the back buffer belongs to the game thread
+	mutable FRWLock Lock;
+
+	TArray<FFRMMoverSample> Front;
+	double FrontTime = 0.0;
+	uint32 FrontSequence = 0;
+
+	TArray<FFRMMoverSample> Back;
+	TArray<FFRMEntity> Movers;
+};
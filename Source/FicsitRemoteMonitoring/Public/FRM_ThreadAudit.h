@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "FicsitRemoteMonitoringModule.h"
+
+/* Marks an engine or UObject access for the thread audit. Free while no audit is running. Accesses without it are not seen. */
+#define FRM_AUDIT_TOUCH(Api) FFRMThreadAudit::Touch(TEXT(Api))
+
+/* Trace scope around an engine call that is also recorded by the thread audit */
+#define FRM_ENGINE_SCOPE(Name) FRM_AUDIT_TOUCH(Name); FRM_TRACE_SCOPE(Name)
+
+/* Marks a read of one of FRM's own caches for the thread audit. Not an engine access, but shows the collector is instrumented. */
+#define FRM_AUDIT_CACHE(Cache) FFRMThreadAudit::TouchCache(TEXT(Cache))
+
+/**
+ * Diagnostic run that checks the bRequireGameThread flags given in InitAPIRegistry against what the endpoints do.
+ *
+ * While running, every endpoint call records the engine accesses it made through the instrumented paths (actor
+ * lookups, subsystem getters and the actor helpers of UFRM_Library), the thread it ran on and how long it took.
+ * The report flags endpoints that touch the engine off the game thread, and game thread endpoints that never touched
+ * it together with the game thread time they would give back if they ran on the request threads instead.
+ *
+ * The report is advisory: the instrumented paths cover the actor lookups and helpers most collectors share, not every
+ * property read. Endpoints whose calls neither touched the engine nor read a cache through an instrumented path are
+ * listed as uninstrumented and never called movable.
+ */
+class FICSITREMOTEMONITORING_API FFRMThreadAudit
+{
+public:
+	static FFRMThreadAudit& Get();
+
+	/* Clears the previous run */
+	void Start();
+	void Stop();
+	bool IsRunning() const { return bRunning.load(std::memory_order_relaxed); }
+
+	/* Records an access for the endpoint running on this thread, if any */
+	static void Touch(const TCHAR* Api);
+
+	/* Records a cache read for the endpoint running on this thread, if any */
+	static void TouchCache(const TCHAR* Cache);
+
+	/* Endpoint the accesses of this thread are attributed to, carried into work that continues it on another thread */
+	struct FContext
+	{
+		FString APIName;
+		bool bRequireGameThread = false;
+	};
+
+	/* Context of the innermost scope on this thread, an empty APIName without one */
+	static FContext CurrentContext();
+
+	TSharedPtr<FJsonObject> Report() const;
+
+	/* Stops the run and writes the report to the Debug folder, returns a message for the caller */
+	FString StopToDebugFolder();
+
+	/* Attributes the accesses made on this thread to an endpoint for as long as it lives */
+	class FICSITREMOTEMONITORING_API FScope
+	{
+	public:
+		FScope(const FString& APIName, bool bRequireGameThread);
+
+		/* Continues a call on this thread, its accesses and time count towards the call without counting another one */
+		explicit FScope(const FContext& Context);
+
+		~FScope();
+
+	private:
+		friend class FFRMThreadAudit;
+
+		bool bActive = false;
+		bool bContinuation = false;
+		FString APIName;
+		bool bRequireGameThread = false;
+		bool bGameThread = false;
+		double StartedAt = 0.0;
+		TMap<const TCHAR*, int32> Touches;
+		TMap<const TCHAR*, int32> CacheReads;
+		FScope* Outer = nullptr;
+	};
+
+private:
+	struct FTouchCount
+	{
+		uint64 GameThread = 0;
+		uint64 OtherThreads = 0;
+	};
+
+	struct FRecord
+	{
+		bool bRequireGameThread = false;
+		uint64 GameThreadCalls = 0;
+		uint64 OtherThreadCalls = 0;
+		double GameThreadSeconds = 0.0;
+		double OtherThreadSeconds = 0.0;
+		TMap<FString, FTouchCount> Touches;
+		TMap<FString, uint64> CacheReads;
+	};
+
+	void Merge(const FScope& Scope, double Seconds);
+
+	std::atomic<bool> bRunning = false;
+
+	mutable FCriticalSection Mutex;
+	TMap<FString, FRecord> Records;
+	double StartedAt = 0.0;
+	double StoppedAt = 0.0;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <string>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "FRM_SpatialIndex.h"
+
+class FFRMEntityIndex;
+
+enum class EFRMTileLayer : uint8
+{
+	Belts,
+	Rails,
+	Cables,
+	Pipes,
+	Num
+};
+
+/**
+ * Binary vector tiles of belts, rails, cables and pipes behind /tiles/{layer}/{z}/{x}/{y}.
+ *
+ * The polyline of every line buildable is taken once when it is built and kept in a spatial index per layer.
+ * A tile clips the lines it overlaps to its area, quantizes them to a 4096 grid and stays cached until a line
+ * within it is built or dismantled; every change bumps the generation of its layer. Tiles are built on the
+ * requesting thread, only Start, Stop and Refresh run on the game thread.
+ *
+ * Tile 0/0/0 is the whole map, x grows with world X and y with world Y. Layout, little endian:
+ *   "FRMT", uint8 version, uint8 layer, uint8 z, uint8 0, uint32 x, uint32 y, uint32 generation, uint16 extent,
+ *   varint feature count, then per feature: varint compact ID, varint point count, and the points as
+ *   zigzag varint deltas, the first one from 0,0.
+ */
+class FICSITREMOTEMONITORING_API FFRMTileCache
+{
+public:
+	static constexpr int32 MaxZoom = 10;
+	static constexpr int32 Extent = 4096;
+
+	void Start(UWorld* World, const FFRMEntityIndex& EntityIndex);
+	void Stop();
+
+	/* Takes the polylines of lines built since the last refresh. Game thread only. */
+	void Refresh();
+
+	/* Nullptr if the tile is outside the map or the zoom is out of range */
+	TSharedPtr<const std::string, ESPMode::ThreadSafe> GetTile(EFRMTileLayer Layer, int32 Z, int32 X, int32 Y);
+
+	static bool ParseLayer(const FString& Name, EFRMTileLayer& OutLayer);
+
+	/* Polyline in XY of a belt, rail, cable or pipe; false for anything else */
+	static bool GetLine(AActor* Actor, EFRMTileLayer& OutLayer, TArray<FVector2D>& OutPoints);
+
+private:
+	struct FLine
+	{
+		uint32 CompactID = 0;
+		TArray<FVector2D> Points;
+		FBox2D Bounds;
+	};
+
+	struct FTile
+	{
+		// including the clip buffer around the tile
+		FBox2D Bounds;
+		TSharedPtr<const std::string, ESPMode::ThreadSafe> Payload;
+	};
+
+	struct FLayer
+	{
+		TMap<FName, FLine> Lines;
+		FFRMSpatialIndex Spatial;
+		TMap<uint64, FTile> Tiles;
+		uint32 Generation = 1;
+	};
+
+	// Cached tiles per layer, a full layer cache starts over
+	static constexpr int32 MaxCachedTiles = 4096;
+
+	static FBox2D GetTileBounds(int32 Z, int32 X, int32 Y);
+
+	void OnActorSpawned(AActor* Actor);
+	void OnActorDestroyed(AActor* Actor);
+
+	void AddLine(AActor* Actor);
+
+	/* Drops the cached tiles overlapping Bounds. Requires the write lock. */
+	void Invalidate(FLayer& Layer, const FBox2D& Bounds);
+
+	std::string BuildTile(const FLayer& Layer, EFRMTileLayer LayerType, int32 Z, int32 X, int32 Y, const FBox2D& Bounds) const;
+
+	FRWLock Lock;
+	FLayer Layers[static_cast<int32>(EFRMTileLayer::Num)];
+
+	const FFRMEntityIndex* Entities = nullptr;
+
+	// built since the last refresh, their splines are not final while spawning
+	TArray<TWeakObjectPtr<AActor>> Pending;
+
+	TWeakObjectPtr<UWorld> BoundWorld;
+	FDelegateHandle SpawnedHandle;
+	FDelegateHandle DestroyedHandle;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonValue.h"
+#include "FRM_ThreadAudit.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Event.h"
+
+/**
+ * Spreads collectors that visit every buildable of a megabase over several frames, so one request never hitches the
+ * game thread.
+ *
+ * A pass gathers its objects on the game thread, then converts them with a resumable cursor for at most Budget
+ * seconds per frame. The calling thread waits until the pass is complete and gets the whole array at once, unless it
+ * opened an FDeferScope, then the array is handed to a callback instead; objects dismantled in between are skipped.
+ * Passes queued in the same frame share the budget in order of arrival.
+ */
+class FICSITREMOTEMONITORING_API FFRMTimeSlicer
+{
+public:
+	/* Fills the objects of a pass, runs once on the game thread */
+	using FGatherFunction = TFunction<void(TArray<UObject*>&)>;
+
+	/* Converts one object on the game thread, nullptr skips it */
+	using FItemFunction = TFunction<TSharedPtr<FJsonValue>(UObject*)>;
+
+	/* Gets the array of a deferred pass, the frames it spanned and whether Stop() cut it off. Game thread */
+	using FCompleteFunction = TUniqueFunction<void(TArray<TSharedPtr<FJsonValue>>&&, int32, bool)>;
+
+	/**
+	 * While alive on a thread other than the game thread, the next Collect of that thread queues its pass, returns an
+	 * empty array at once and hands the real one to OnComplete. Only for collectors that return the array of Collect as
+	 * it is; further Collects in the same scope wait as usual, and a scope without a callback keeps every nested Collect waiting.
+	 */
+	class FICSITREMOTEMONITORING_API FDeferScope
+	{
+	public:
+		explicit FDeferScope(FCompleteFunction&& InOnComplete);
+		~FDeferScope();
+
+		/* True once a pass took OnComplete, it is called exactly once from then on */
+		bool IsQueued() const { return bQueued; }
+
+	private:
+		friend class FFRMTimeSlicer;
+
+		FCompleteFunction OnComplete;
+		bool bQueued = false;
+		FDeferScope* Previous = nullptr;
+	};
+
+	void Start(double InBudget);
+
+	/* Completes pending passes empty and marks them cut off, so no request thread is left waiting */
+	void Stop();
+
+	/**
+	 * Runs a pass and blocks until it is complete, or queues it under an FDeferScope. On the game thread the pass cannot
+	 * wait for later frames and runs at once. Returns the number of frames the pass spanned, 0 when it was deferred.
+	 */
+	int32 Collect(const FGatherFunction& Gather, const FItemFunction& Item, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
+
+	/* Frames spanned by the passes this thread ran since the last call, 0 without any */
+	static int32 TakeFrames();
+
+	/* True if Stop() cut off a pass this thread waited for since the last call, its array is empty */
+	static bool TakeCutOff();
+
+private:
+	struct FPass
+	{
+		FGatherFunction Gather;
+		FItemFunction Item;
+
+		TArray<TWeakObjectPtr<UObject>> Objects;
+		bool bGathered = false;
+		int32 Cursor = 0;
+		int32 Frames = 0;
+
+		TArray<TSharedPtr<FJsonValue>> Results;
+		FEventRef Done{EEventMode::ManualReset};
+		bool bCutOff = false;
+
+		// set for deferred passes, called instead of triggering Done
+		FCompleteFunction OnComplete;
+
+		// endpoint of the queuing thread, the steps on the game thread are audited as part of its call
+		FFRMThreadAudit::FContext Audit;
+	};
+
+	/* Hands the results to the deferred callback or wakes the waiting thread */
+	static void Finish(FPass& Pass);
+
+	bool Tick(float DeltaTime);
+
+	/* Advances the pass until the deadline, true once it is complete */
+	static bool Step(FPass& Pass, double Deadline);
+
+	double Budget = 0.0015;
+
+	FCriticalSection Mutex;
+	TArray<TSharedPtr<FPass, ESPMode::ThreadSafe>> Pending;
+	bool bRunning = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -12,6 +12,7 @@
 #include "FGPowerCircuit.h"
 #include "FGCircuitSubsystem.h"
 #include "FRM_Library.h"
+#include "FRM_Polylines.h"
 #include "FGLocomotive.h"
 #include "FGTrain.h"
 #include "FGTrainStationIdentifier.h"
@@ -29,7 +30,7 @@ class FICSITREMOTEMONITORING_API UFRM_Trains : public UBlueprintFunctionLibrary
 public:
 	static TArray<TSharedPtr<FJsonValue>> getTrains(UObject* WorldContext);
 	static TArray<TSharedPtr<FJsonValue>> getTrainStation(UObject* WorldContext);
-	static TArray<TSharedPtr<FJsonValue>> getTrainRails(UObject* WorldContext, FRequestData RequestData);
+	static TArray<TSharedPtr<FJsonValue>> getTrainRails(UObject* WorldContext, FRequestData RequestData, FFRMPolylineCache& Polylines);
 
 private:
 	friend class AFGBuildableRailroadStation;
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/ObjectKey.h"
+#include "FRM_ItemRegistry.h"
+
+class FFRMPolylineCache;
+
+struct FFRMBeltRow
+{
+	FName ID;
+
+	// resolves the belt's polylines without touching the actor
+	FObjectKey Key;
+
+	FString Name;
+	FString ClassName;
+	FVector Location = FVector::ZeroVector;
+
+	// relative to the belt, as getBelts has always reported them
+	FVector Location0 = FVector::ZeroVector;
+	FVector Location1 = FVector::ZeroVector;
+
+	bool bConnected0 = false;
+	bool bConnected1 = false;
+	float Length = 0.0f;
+	float Speed = 0.0f;
+};
+
+struct FFRMStorageRow
+{
+	FName ID;
+	FString Name;
+	FString ClassName;
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+	TArray<FFRMItemStack> Inventory;
+};
+
+/**
+ * Plain copy of the monitored entities at one point in game time. Built on the game thread and never modified
+ * afterwards, so any thread can read it while the game keeps simulating.
+ */
+class FICSITREMOTEMONITORING_API FFRMWorldSnapshot
+{
+public:
+	/* Game thread only. Also samples the polylines of new belts, so requests never need the actors for them. */
+	static TSharedRef<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Build(UWorld* World, FFRMPolylineCache& Polylines, uint32 Sequence);
+
+	uint32 Sequence = 0;
+	double GameTime = 0.0;
+
+	TArray<FFRMBeltRow> Belts;
+	TArray<FFRMStorageRow> Storages;
+
+	// inventories of all storages summed up, served by getWorldInv
+	FFRMItemCounts WorldInventory;
+};
+
+/**
+ * Holds the latest snapshot. Publishing swaps the pointer, readers keep the snapshot they took for as long as they
+ * need it, so the previous one stays alive until its last reader is done.
+ */
+class FICSITREMOTEMONITORING_API FFRMSnapshotStore
+{
+public:
+	void Publish(const TSharedRef<const FFRMWorldSnapshot, ESPMode::ThreadSafe>& Snapshot);
+	void Reset();
+
+	/* Nullptr before the first snapshot. Every call counts as demand for the next ones */
+	TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Get() const;
+
+	/* True while a snapshot was read within the last IdleSeconds, false until the first read */
+	bool IsWanted(double IdleSeconds) const;
+
+	uint32 GetNextSequence() const;
+
+private:
+	mutable FRWLock Lock;
+	TSharedPtr<const FFRMWorldSnapshot, ESPMode::ThreadSafe> Current;
+
+	mutable std::atomic<double> LastRead = 0.0;
+};
@@ -2,6 +2,8 @@
 
 #include <thread>
 #include <atomic>
+#include <string>
+#include <unordered_map>
 
 #include "CoreMinimal.h"
 #include "Engine.h"
@@ -11,6 +13,7 @@
 #include "HAL/PlatformFileManager.h"
 #include "UObject/NoExportTypes.h"
 #include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "Templates/Function.h"  // Required for function pointers
 //#include "FactoryDedicatedServer/Public/FGServerSubsystem.h"
 //#include "FactoryDedicatedServer/Public/Networking/FGServerAPIManager.h"
@@ -50,8 +53,18 @@
 #include "Async/Async.h"
 #include "Misc/Paths.h"
 #include "FGResearchTreeNode.h"
+#include "FRM_Catalog.h"
 #include "FRM_Events.h"
 #include "FRM_RequestData.h"
+#include "FRM_ResponseCache.h"
+#include "FRM_Metrics.h"
+#include "FRM_History.h"
+#include "FRM_HistoryStore.h"
+#include "FRM_Telemetry.h"
+#include "FRM_Tiles.h"
+#include "FRM_TimeSlicer.h"
+#include "FRM_Scheduler.h"
+#include "FRM_WorldSnapshot.h"
 
 THIRD_PARTY_INCLUDES_START
 #include "ThirdParty/uWebSockets/App.h"
@@ -61,8 +74,32 @@ THIRD_PARTY_INCLUDES_END
 
 struct FWebSocketUserData {
 	// Add any fields here you want to track for each WebSocket client
-	int32 ClientID;
+	// Never reused, unlike the socket address, so a late send can tell the client is gone
+	uint64 ClientID = 0;
 	FString ClientName;
+
+	// Event loop owning this socket, sends from other threads have to be deferred onto it
+	uWS::Loop* Loop = nullptr;
+
+	// Bytes uWS still buffers for this client, as last reported to the metrics
+	int64 BufferedAmount = 0;
+};
+
+// A client as seen from outside its loop, the socket is only looked up again on Loop by its ClientID
+struct FWebSocketClient
+{
+	uWS::Loop* Loop = nullptr;
+	uint64 ClientID = 0;
+};
+
+// Everything an API response needs once the request itself is gone, when it is sent on a later turn of its loop
+struct FApiRequestContext
+{
+	double RequestStart = 0.0;
+	std::string Method;
+	std::string Url;
+	std::string QueryString;
+	TSharedPtr<FRequestTiming, ESPMode::ThreadSafe> Timing;
 };
 
 struct FClientInfo
@@ -71,6 +108,10 @@ struct FClientInfo
 	TArray<uWS::WebSocket<false, true, FWebSocketUserData>*> Client;  // Add the third template argument for USERDATA
 };
 
+// Query string helpers shared by the HTTP routes and the benchmark
+FICSITREMOTEMONITORING_API std::string UrlDecode(const std::string& Value);
+FICSITREMOTEMONITORING_API std::unordered_map<std::string, std::string> ParseQueryString(const std::string& Query);
+
 typedef void (AFicsitRemoteMonitoring::*FEndpointFunction)(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
 
 USTRUCT()
@@ -94,6 +135,9 @@ struct FAPIEndpoint {
 
 	// Function pointer to the endpoint handler (not a UPROPERTY because function pointers aren’t supported by UPROPERTY)
 	FEndpointFunction FunctionPtr;
+
+	// Slot in FFRMMetrics for this endpoint
+	int32 MetricsIndex = INDEX_NONE;
 };
 
 USTRUCT(BlueprintType)
@@ -103,6 +147,14 @@ struct FCallEndpointResponse
 
 	TArray<TSharedPtr<FJsonValue>> JsonValues;
 	bool bUseFirstObject;
+
+	int32 MetricsIndex = INDEX_NONE;
+
+	// Game thread frames the collector spanned, above 1 for time-sliced passes
+	int32 Frames = 0;
+
+	// a time-sliced pass was abandoned while the server stopped, the data is incomplete
+	bool bCutOff = false;
 };
 
 UCLASS()
@@ -112,9 +164,95 @@ class FICSITREMOTEMONITORING_API AFicsitRemoteMonitoring : public AModSubsystem
 
 private:
 
-	TFuture<void> WebServer;
+	// One future per uWS event loop thread
+	TArray<TFuture<void>> WebServers;
 	
 	bool JSONDebugMode;
+
+	// Serialized GET responses, shared by all event loops
+	FFRMResponseCache ResponseCache;
+	static constexpr float ResponseCacheTTL = 0.5f;
+
+	// Feeds the game thread frame time into the metrics
+	FTSTicker::FDelegateHandle FrameTickerHandle;
+
+	// Mover positions pushed as binary to subscribers of "telemetry"
+	FFRMTelemetry Telemetry;
+	FTSTicker::FDelegateHandle TelemetryTickerHandle;
+	static constexpr int32 TelemetryCaptureTicks = 2;
+	int32 TelemetryTicks = 0;
+	static constexpr double TelemetryInterval = 0.1;
+	double LastTelemetryPush = 0.0;
+
+	// encode and send of the last push, EndPlay waits for it before the subsystem goes away
+	TFuture<void> TelemetryPush;
+
+	// Power and production samples served by /api/history
+	FFRMHistory History;
+	FFRMHistoryStore HistoryStore;
+
+	// seconds between two history samples, and how many seconds of them are kept in memory
+	static constexpr float HistorySampleInterval = 10.0f;
+	static constexpr float HistoryRetention = 6.0f * 3600.0f;
+
+	// the on-disk store stays off until Config_Factory has a setting to switch it on, nothing is written unasked
+	static constexpr bool bPersistHistory = false;
+
+	// Per-item production totals behind getProdStats and the history
+	FFRMProductionTracker ProductionTracker;
+
+	// Circuit topology behind getPowerGraph, and the switch index behind setSwitches
+	FFRMPowerGraph PowerGraph;
+
+	// Actor name and compact ID lookup behind getById, and the spatial index behind ?bbox= and ?near=
+	FFRMEntityIndex EntityIndex;
+	FTimerHandle SpatialTimerHandle;
+
+	// Binary map tiles behind /tiles/{layer}/{z}/{x}/{y}
+	FFRMTileCache TileCache;
+	int32 TilesMetricsIndex = INDEX_NONE;
+
+	// Curved belt and rail geometry behind ?lod= on getBelts and getTrainRails
+	FFRMPolylineCache Polylines;
+
+	// Copy of the monitored entities taken every few frames, read by the endpoints instead of the live actors
+	FFRMSnapshotStore Snapshots;
+	FTSTicker::FDelegateHandle SnapshotTickerHandle;
+	static constexpr int32 SnapshotTicks = 10;
+	int32 SnapshotTickCounter = 0;
+
+	// seconds without a snapshot read after which the copies are no longer refreshed
+	static constexpr double SnapshotIdleSeconds = 300.0;
+
+	// Push timer fires since the last push, pushes are skipped while the governor throttles
+	int32 PushCycleCounter = 0;
+
+	// Spreads getFactory and getPowerUsage over several frames on big worlds
+	FFRMTimeSlicer TimeSlicer;
+
+	// game thread seconds the time-sliced passes may use per frame
+	static constexpr double TimeSliceBudget = 0.0015;
+
+	// getRecipes, getSchematics, getSinkList, getResearchTrees and getModList, built once and kept serialized
+	FFRMCatalogCache Catalogs;
+
+	FTimerHandle HistoryTimerHandle;
+	int32 HistoryMetricsIndex = INDEX_NONE;
+
+	// Guards ConnectedClients and EndpointSubscribers, which are touched from every event loop and the game thread
+	FCriticalSection ClientsLock;
+
+	void RunServerLoop(FConfig_HTTPStruct Config, int32 LoopIndex, int32 LoopCount);
+	void RegisterRoutes(uWS::App& App, const FString& UIPath, const FString& IconsPath);
+	void UpdateBackpressure(uWS::WebSocket<false, true, FWebSocketUserData>* Client);
+	void SendToClient(const FWebSocketClient& Client, const TSharedPtr<const std::string, ESPMode::ThreadSafe>& Payload, uWS::OpCode OpCode = uWS::OpCode::TEXT);
+	void SendApiResponse(uWS::HttpResponse<false>* res, const FApiRequestContext& Context, const FCachedResponse& Response, const TCHAR* CacheState);
+	bool CollectOnGameThread(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, double QueuedAt, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
+	bool RunEndpoint(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
+
+	// Frames, cut-off, collect metrics and area filter of an endpoint that ran on a loop, possibly over several frames
+	void FinishEndpointResponse(const FAPIEndpoint& EndpointInfo, const FRequestData& RequestData, double StartedAt, int32 Frames, bool bCutOff, FCallEndpointResponse& Response, bool& bSuccess);
+	void ApplyAreaFilter(const FRequestData& RequestData, TArray<TSharedPtr<FJsonValue>>& JsonArray) const;
 	
 	friend class UFGPowerCircuitGroup;
 
@@ -141,6 +279,23 @@ public:
 
 	FCallEndpointResponse CallEndpoint(UObject* WorldContext, FString InEndpoint, FRequestData RequestData, bool& bSuccess);
 
+	// Never waits for the game thread: game thread endpoints are queued and OnComplete runs on Loop once they are collected, inline for all others
+	void CallEndpointAsync(UObject* WorldContext, FString InEndpoint, FRequestData RequestData, uWS::Loop* Loop, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete);
+
+	// CallEndpointAsync for a resolved endpoint, game thread work is queued with Priority
+	void RunEndpointAsync(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, uWS::Loop* Loop, EFRMPriority Priority, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete);
+
+	// getAll off the game thread: every part is queued at once and the response is put together on Loop once the last one is back
+	void GetAllAsync(const FAPIEndpoint& EndpointInfo, UObject* WorldContext, const FRequestData& RequestData, uWS::Loop* Loop, TUniqueFunction<void(FCallEndpointResponse&&, bool)>&& OnComplete);
+
+	// Resolves an endpoint by name and method. Methods registered under the same name are collected when none matches.
+	const FAPIEndpoint* FindEndpoint(const FString& InEndpoint, const FString& Method, TArray<FString>& OutAvailableMethods) const;
+
+	FString SerializeResponse(const FCallEndpointResponse& Response, bool bSuccess) const;
+
+	// SerializeResponse as the UTF-8 payload the web server sends, written by FFRMJsonWriter unless JSONDebugMode pretty prints
+	TSharedRef<const std::string, ESPMode::ThreadSafe> SerializePayload(const FCallEndpointResponse& Response, bool bSuccess) const;
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "Ficsit Remote Monitoring")
 	void GetDropPodInfo_BIE(const AFGDropPod* Droppod, TSubclassOf<UFGItemDescriptor>& ItemClass, int32& Amount, float& Power);
 
@@ -174,7 +329,8 @@ public:
 
 	TMap<FString, TSet<uWS::WebSocket<false, true, FWebSocketUserData>*>> EndpointSubscribers;
 
-	TSet<uWS::WebSocket<false, true, FWebSocketUserData>*> ConnectedClients; 
+	// Open sockets by ClientID
+	TMap<uint64, uWS::WebSocket<false, true, FWebSocketUserData>*> ConnectedClients;
 
 	UFUNCTION(BlueprintImplementableEvent, Category = "Ficsit Remote Monitoring")
 	void InitSerialDevice();
@@ -192,8 +348,18 @@ public:
 	void ProcessClientRequest(uWS::WebSocket<false, true, FWebSocketUserData>* ws, const TSharedPtr<FJsonObject>& JsonRequest);
 
 	void PushUpdatedData();
+	void SampleHistory();
+	bool TickTelemetry(float DeltaTime);
+	bool TickSnapshot(float DeltaTime);
+
+	// purchased schematics and completed research change the progress catalogs
+	UFUNCTION()
+	void OnProgressChanged(TSubclassOf<UFGSchematic> Schematic);
 
 	void HandleGetRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req, FString FilePath);
+	void HandleMetricsRequest(uWS::HttpResponse<false>* res);
+	void HandleHistoryRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req);
+	void HandleTileRequest(uWS::HttpResponse<false>* res, uWS::HttpRequest* req);
 	void AddResponseHeaders(uWS::HttpResponse<false>* res, bool bIncludeContentType);
 	void AddErrorJson(TArray<TSharedPtr<FJsonValue>>& JsonArray, const FString& ErrorMessage);
 
@@ -229,19 +395,23 @@ public:
 	FString StoredAPIName;
 	
 	void getAssembler(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/AssemblerMk1/Build_AssemblerMk1.Build_AssemblerMk1_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/AssemblerMk1/Build_AssemblerMk1.Build_AssemblerMk1_C")));
 	}
 	
 	void getBelts(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getBelts(WorldContext, RequestData);
+		OutJsonArray = UFRM_Factory::getBelts(WorldContext, RequestData, Polylines, Snapshots);
 	}
 	
 	void getBiomassGenerator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getGenerators(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorBiomass/Build_GeneratorBiomass_Automated.Build_GeneratorBiomass_Automated_C")));
+		OutJsonArray = UFRM_Power::getGenerators(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorBiomass/Build_GeneratorBiomass_Automated.Build_GeneratorBiomass_Automated_C")));
 	}
 	
 	void getBlender(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/Blender/Build_Blender.Build_Blender_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/Blender/Build_Blender.Build_Blender_C")));
+	}
+
+	void getById(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
+		OutJsonArray = UFRM_Factory::getById(WorldContext, RequestData, EntityIndex);
 	}
 
 	void getCables(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -253,15 +423,15 @@ public:
 	}
 	
 	void getCoalGenerator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getGenerators(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorCoal/Build_GeneratorCoal.Build_GeneratorCoal_C")));
+		OutJsonArray = UFRM_Power::getGenerators(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorCoal/Build_GeneratorCoal.Build_GeneratorCoal_C")));
 	}
 		
 	void getConstructor(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/ConstructorMk1/Build_ConstructorMk1.Build_ConstructorMk1_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/ConstructorMk1/Build_ConstructorMk1.Build_ConstructorMk1_C")));
 	}
 		
 	void getConverter(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/Converter/Build_Converter.Build_Converter_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/Converter/Build_Converter.Build_Converter_C")));
 	}
 		
 	void getDoggo(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -269,7 +439,7 @@ public:
 	}
 	
 	void getResearchTrees(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
-		OutJsonArray = UFRM_World::GetResearchTrees(WorldContext);
+		Catalogs.Get(TEXT("getResearchTrees"), OutJsonArray);
 	}
 	
 	void getFallingGiftBundles(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
@@ -289,7 +459,7 @@ public:
 	}
 	
 	void getEncoder(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/QuantumEncoder/Build_QuantumEncoder.Build_QuantumEncoder_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/QuantumEncoder/Build_QuantumEncoder.Build_QuantumEncoder_C")));
 	}
 	
 	void getExplorationSink(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -297,7 +467,7 @@ public:
 	}
 	
 	void getExplorer(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Vehicle/Explorer/BP_Explorer.BP_Explorer_C")));
+		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Vehicle/Explorer/BP_Explorer.BP_Explorer_C")));
 	}
 	
 	void getExtractor(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -305,11 +475,11 @@ public:
 	}
 	
 	void getFactoryCart(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Vehicle/Golfcart/BP_Golfcart.BP_Golfcart_C")));
+		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Vehicle/Golfcart/BP_Golfcart.BP_Golfcart_C")));
 	}
 	
 	void getFoundry(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/FoundryMk1/Build_FoundryMk1.Build_FoundryMk1_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/FoundryMk1/Build_FoundryMk1.Build_FoundryMk1_C")));
 	}
 	
 	void getFrackingActivator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
@@ -317,11 +487,11 @@ public:
 	}
 	
 	void getFuelGenerator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getGenerators(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorFuel/Build_GeneratorFuel.Build_GeneratorFuel_C")));
+		OutJsonArray = UFRM_Power::getGenerators(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorFuel/Build_GeneratorFuel.Build_GeneratorFuel_C")));
 	}
 	
 	void getGeothermalGenerator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getGenerators(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorGeoThermal/Build_GeneratorGeoThermal.Build_GeneratorGeoThermal_C")));
+		OutJsonArray = UFRM_Power::getGenerators(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorGeoThermal/Build_GeneratorGeoThermal.Build_GeneratorGeoThermal_C")));
 	}
 	
 	void getHUBTerminal(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -333,23 +503,23 @@ public:
 	}
 	
 	void getManufacturer(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/ManufacturerMk1/Build_ManufacturerMk1.Build_ManufacturerMk1_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/ManufacturerMk1/Build_ManufacturerMk1.Build_ManufacturerMk1_C")));
 	}
 	
 	void getModList(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getModList(WorldContext, RequestData);
+		Catalogs.Get(TEXT("getModList"), OutJsonArray);
 	}
 	
 	void getNuclearGenerator(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getGenerators(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorNuclear/Build_GeneratorNuclear.Build_GeneratorNuclear_C")));
+		OutJsonArray = UFRM_Power::getGenerators(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/GeneratorNuclear/Build_GeneratorNuclear.Build_GeneratorNuclear_C")));
 	}
 	
 	void getPackager(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/Packager/Build_Packager.Build_Packager_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/Packager/Build_Packager.Build_Packager_C")));
 	}
 	
 	void getParticle(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/HadronCollider/Build_HadronCollider.Build_HadronCollider_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/HadronCollider/Build_HadronCollider.Build_HadronCollider_C")));
 	}
 	
 	void getPaths(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -379,11 +549,15 @@ public:
 	}
 	
 	void getPowerUsage(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::getPowerUsage(WorldContext);
+		OutJsonArray = UFRM_Power::getPowerUsage(WorldContext, TimeSlicer);
+	}
+
+	void getPowerGraph(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
+		OutJsonArray = UFRM_Power::getPowerGraph(WorldContext, PowerGraph);
 	}
 	
 	void getProdStats(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Production::getProdStats(WorldContext);
+		OutJsonArray = UFRM_Production::getProdStats(WorldContext, ProductionTracker);
 	}
 	
 	void getPump(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
@@ -395,11 +569,11 @@ public:
 	}
 		
 	void getRecipes(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Production::getRecipes(WorldContext);
+		Catalogs.Get(TEXT("getRecipes"), OutJsonArray);
 	}
 	
 	void getRefinery(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/OilRefinery/Build_OilRefinery.Build_OilRefinery_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/OilRefinery/Build_OilRefinery.Build_OilRefinery_C")));
 	}
 	
 	void getResourceGeyser(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -423,15 +597,15 @@ public:
 	}
 	
 	void getSchematics(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Production::getSchematics(WorldContext);
+		Catalogs.Get(TEXT("getSchematics"), OutJsonArray);
 	}
 	
 	void getSinkList(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Production::getSinkList(WorldContext);
+		Catalogs.Get(TEXT("getSinkList"), OutJsonArray);
 	}
 	
 	void getSmelter(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Factory/SmelterMk1/Build_SmelterMk1.Build_SmelterMk1_C")));
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Factory/SmelterMk1/Build_SmelterMk1.Build_SmelterMk1_C")));
 	}
 	
 	void getSessionInfo(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {
@@ -443,7 +617,7 @@ public:
 	}
 	
 	void getStorageInv(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getStorageInv(WorldContext, RequestData);
+		OutJsonArray = UFRM_Factory::getStorageInv(WorldContext, RequestData, Snapshots);
 	}
 
 	
@@ -452,11 +626,11 @@ public:
 	}
 	
 	void setSwitches(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Power::setSwitches(WorldContext, RequestData);
+		OutJsonArray = UFRM_Power::setSwitches(WorldContext, RequestData, PowerGraph);
 	}
 	
 	void getTractor(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Vehicle/Tractor/BP_Tractor.BP_Tractor_C")));
+		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Vehicle/Tractor/BP_Tractor.BP_Tractor_C")));
 	}
 	
 	void getTrains(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -464,7 +638,7 @@ public:
 	}
 
 	void getTrainRails(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Trains::getTrainRails(WorldContext, RequestData);
+		OutJsonArray = UFRM_Trains::getTrainRails(WorldContext, RequestData, Polylines);
 	}
 	
 	void getTrainStation(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -472,7 +646,7 @@ public:
 	}
 	
 	void getTruck(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, LoadObject<UClass>(nullptr, TEXT("/Game/FactoryGame/Buildable/Vehicle/Truck/BP_Truck.BP_Truck_C")));
+		OutJsonArray = UFRM_Vehicles::getVehicles(WorldContext, UFRM_Library::LoadClassByPath(TEXT("/Game/FactoryGame/Buildable/Vehicle/Truck/BP_Truck.BP_Truck_C")));
 	}
 	
 	void getTruckStation(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
@@ -481,13 +655,13 @@ public:
 
 	
 	void getWorldInv(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getWorldInv(WorldContext, RequestData);
+		OutJsonArray = UFRM_Factory::getWorldInv(WorldContext, RequestData, Snapshots);
 	}
 	
 	void getAll(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray);
 	
 	void getFactory(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
-		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, AFGBuildableManufacturer::StaticClass());
+		OutJsonArray = UFRM_Factory::getFactory(WorldContext, RequestData, TimeSlicer, AFGBuildableManufacturer::StaticClass());
 	}
 	
 	void getGenerators(UObject* WorldContext, FRequestData RequestData, TArray<TSharedPtr<FJsonValue>>& OutJsonArray) {		
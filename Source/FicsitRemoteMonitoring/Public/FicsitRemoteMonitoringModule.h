@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogHttpServer, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogWSServer, Log, All);
@@ -12,6 +14,11 @@ DECLARE_LOG_CATEGORY_EXTERN(LogFRMDebug, Log, All);
 
 DECLARE_LOG_CATEGORY_EXTERN(LogWebSocketServer, Log, All);
 
+// Unreal Insights channel for FRM's request phases, enable with -trace=cpu,FRM
+UE_TRACE_CHANNEL_EXTERN(FRMChannel, FICSITREMOTEMONITORING_API);
+
+#define FRM_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, FRMChannel)
+
 class FFicsitRemoteMonitoringModule : public FDefaultGameModuleImpl {
 public:
     virtual void StartupModule() override;
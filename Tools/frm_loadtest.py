@@ -0,0 +1,652 @@
+#!/usr/bin/env python3
+"""
+Load generator for the Ficsit Remote Monitoring web server.
+
+Replays a weighted mix of /api/* GETs over N keep-alive connections, plus WebSocket
+clients subscribed to endpoints, and reports latency percentiles, throughput, errors
+and the game thread frame time reported by /metrics while idle and under load.
+
+    python frm_loadtest.py --host 127.0.0.1 --port 8080 --connections 16 --duration 30
+    python frm_loadtest.py --mock --mock-size 10000
+
+--mock starts a local stand-in for FRM that serves a synthetic world, so the tool can be
+tried and compared without the game. Its "frame time" is the lag of a 60 Hz tick sharing
+the event loop with the request handlers, the same way the game thread pays for FRM work.
+
+Only the Python standard library is used.
+"""
+
+import argparse
+import asyncio
+import base64
+import hashlib
+import json
+import os
+import random
+import re
+import struct
+import sys
+import time
+
+DEFAULT_MIX = "getPower:4,getProdStats:3,getFactory:2,getTrains:2,getPlayer:2,getBelts:1,getStorageInv:1,getWorldInv:1"
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+# same buckets as frm_game_frame_seconds
+FRAME_BUCKETS = [0.0042, 0.0083, 0.0111, 0.0167, 0.0222, 0.0333, 0.05, 0.1, 0.25, 1.0, float("inf")]
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, max(0, int(round(p / 100.0 * len(sorted_values) + 0.5)) - 1))
+    return sorted_values[index]
+
+
+def parse_mix(mix):
+    endpoints = []
+    for part in mix.split(","):
+        part = part.strip()
+        if not part:
+            continue
+        name, _, weight = part.partition(":")
+        endpoints.append((name.strip(), float(weight or 1)))
+    if not endpoints:
+        raise ValueError("the request mix is empty")
+    return endpoints
+
+
+# ---------------------------------------------------------------------------
+# HTTP/1.1 and WebSocket wire helpers
+# ---------------------------------------------------------------------------
+
+async def read_http_response(reader):
+    status_line = await reader.readline()
+    if not status_line:
+        raise ConnectionError("connection closed")
+    status = int(status_line.split(b" ", 2)[1])
+
+    headers = {}
+    while True:
+        line = await reader.readline()
+        if line in (b"\r\n", b"\n", b""):
+            break
+        key, _, value = line.decode("latin-1").partition(":")
+        headers[key.strip().lower()] = value.strip()
+
+    if "content-length" in headers:
+        body = await reader.readexactly(int(headers["content-length"]))
+    elif headers.get("transfer-encoding", "").lower() == "chunked":
+        chunks = []
+        while True:
+            size = int((await reader.readline()).split(b";")[0], 16)
+            if size == 0:
+                await reader.readline()
+                break
+            chunks.append(await reader.readexactly(size))
+            await reader.readline()
+        body = b"".join(chunks)
+    else:
+        body = await reader.read()
+
+    return status, headers, body
+
+
+def ws_frame(opcode, payload, mask):
+    header = bytearray([0x80 | opcode])
+    mask_bit = 0x80 if mask else 0
+    length = len(payload)
+    if length < 126:
+        header.append(mask_bit | length)
+    elif length < 65536:
+        header.append(mask_bit | 126)
+        header += struct.pack("!H", length)
+    else:
+        header.append(mask_bit | 127)
+        header += struct.pack("!Q", length)
+
+    if not mask:
+        return bytes(header) + payload
+
+    key = os.urandom(4)
+    return bytes(header) + key + bytes(b ^ key[i % 4] for i, b in enumerate(payload))
+
+
+async def ws_read_message(reader, writer):
+    """Returns (opcode, payload) of the next complete data message, answering pings on the way."""
+    message = bytearray()
+    message_opcode = None
+
+    while True:
+        first, second = await reader.readexactly(2)
+        opcode = first & 0x0F
+        length = second & 0x7F
+        if length == 126:
+            length = struct.unpack("!H", await reader.readexactly(2))[0]
+        elif length == 127:
+            length = struct.unpack("!Q", await reader.readexactly(8))[0]
+        key = await reader.readexactly(4) if second & 0x80 else None
+        payload = await reader.readexactly(length)
+        if key:
+            payload = bytes(b ^ key[i % 4] for i, b in enumerate(payload))
+
+        if opcode == 0x8:
+            raise ConnectionError("websocket closed")
+        if opcode == 0x9:
+            writer.write(ws_frame(0xA, payload, mask=key is None))
+            continue
+        if opcode == 0xA:
+            continue
+
+        if opcode != 0x0:
+            message_opcode = opcode
+        message += payload
+        if first & 0x80:
+            return message_opcode, bytes(message)
+
+
+# ---------------------------------------------------------------------------
+# OpenMetrics scraping
+# ---------------------------------------------------------------------------
+
+FRAME_LINE = re.compile(r'^frm_game_frame_seconds_(bucket\{le="([^"]+)"\}|sum|count) (\S+)$')
+
+
+async def scrape_frames(host, port):
+    """Returns the cumulative frame histogram as (buckets, sum, count), or None if unavailable."""
+    try:
+        reader, writer = await asyncio.open_connection(host, port)
+        writer.write(f"GET /metrics HTTP/1.1\r\nHost: {host}\r\nConnection: close\r\n\r\n".encode())
+        status, _, body = await read_http_response(reader)
+        writer.close()
+    except (OSError, ConnectionError, asyncio.IncompleteReadError):
+        return None
+    if status != 200:
+        return None
+
+    buckets, total, count = {}, 0.0, None
+    for line in body.decode("utf-8", "replace").splitlines():
+        match = FRAME_LINE.match(line)
+        if not match:
+            continue
+        if match.group(2):
+            buckets[float(match.group(2))] = int(float(match.group(3)))
+        elif match.group(1) == "sum":
+            total = float(match.group(3))
+        else:
+            count = int(float(match.group(3)))
+    return (buckets, total, count) if count is not None else None
+
+
+def frame_window(before, after):
+    """Frame stats between two scrapes, percentiles interpolated from the histogram buckets."""
+    if not before or not after:
+        return None
+
+    count = after[2] - before[2]
+    if count <= 0:
+        return None
+
+    bounds = sorted(after[0])
+    cumulative = [after[0][b] - before[0].get(b, 0) for b in bounds]
+
+    def quantile(q):
+        target = q * count
+        lower, below = 0.0, 0
+        for bound, seen in zip(bounds, cumulative):
+            if seen >= target:
+                if bound == float("inf"):
+                    return lower
+                share = (target - below) / max(seen - below, 1)
+                return lower + (bound - lower) * share
+            lower, below = bound, seen
+        return lower
+
+    return {
+        "frames": count,
+        "meanMs": (after[1] - before[1]) / count * 1000,
+        "p95Ms": quantile(0.95) * 1000,
+        "p99Ms": quantile(0.99) * 1000,
+        "over33msPercent": 100.0 * (count - dict(zip(bounds, cumulative)).get(0.0333, count)) / count,
+    }
+
+
+# ---------------------------------------------------------------------------
+# Load generation
+# ---------------------------------------------------------------------------
+
+class Stats:
+    def __init__(self):
+        self.latencies = {}
+        self.errors = {}
+        self.bytes = {}
+
+    def record(self, endpoint, seconds, size, ok):
+        if ok:
+            self.latencies.setdefault(endpoint, []).append(seconds)
+            self.bytes[endpoint] = self.bytes.get(endpoint, 0) + size
+        else:
+            self.errors[endpoint] = self.errors.get(endpoint, 0) + 1
+
+
+async def http_worker(host, port, endpoints, weights, deadline, stats, rng):
+    reader = writer = None
+
+    while time.monotonic() < deadline:
+        endpoint = rng.choices(endpoints, weights)[0]
+        started = time.perf_counter()
+        try:
+            if writer is None:
+                reader, writer = await asyncio.open_connection(host, port)
+            writer.write(f"GET /api/{endpoint} HTTP/1.1\r\nHost: {host}\r\nAccept-Encoding: identity\r\n\r\n".encode())
+            status, headers, body = await read_http_response(reader)
+            stats.record(endpoint, time.perf_counter() - started, len(body), status == 200)
+            if headers.get("connection", "").lower() == "close":
+                writer.close()
+                writer = None
+        except (OSError, ConnectionError, asyncio.IncompleteReadError, ValueError, IndexError):
+            stats.record(endpoint, time.perf_counter() - started, 0, False)
+            if writer:
+                writer.close()
+            writer = None
+            await asyncio.sleep(0.05)
+
+    if writer:
+        writer.close()
+
+
+async def ws_client(host, port, subscriptions, deadline, result):
+    try:
+        reader, writer = await asyncio.open_connection(host, port)
+        key = base64.b64encode(os.urandom(16)).decode()
+        writer.write((
+            f"GET / HTTP/1.1\r\nHost: {host}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n"
+        ).encode())
+
+        status_line = await reader.readline()
+        while (await reader.readline()) not in (b"\r\n", b"\n", b""):
+            pass
+        if b" 101 " not in status_line:
+            raise ConnectionError(status_line.decode("latin-1").strip())
+
+        subscribed_at = time.perf_counter()
+        writer.write(ws_frame(0x1, json.dumps({"action": "subscribe", "endpoints": subscriptions}).encode(), mask=True))
+
+        last = None
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                break
+            try:
+                _, payload = await asyncio.wait_for(ws_read_message(reader, writer), remaining)
+            except asyncio.TimeoutError:
+                break
+
+            now = time.perf_counter()
+            if last is None:
+                result["firstMessage"].append(now - subscribed_at)
+            else:
+                result["intervals"].append(now - last)
+            last = now
+            result["messages"] += 1
+            result["bytes"] += len(payload)
+
+        writer.write(ws_frame(0x8, struct.pack("!H", 1000), mask=True))
+        writer.close()
+    except (OSError, ConnectionError, asyncio.IncompleteReadError) as error:
+        result["errors"] += 1
+        result["lastError"] = str(error)
+
+
+async def run_load(args, host, port):
+    mix = parse_mix(args.mix)
+    endpoints = [name for name, _ in mix]
+    weights = [weight for _, weight in mix]
+
+    idle_before = await scrape_frames(host, port)
+    if idle_before and args.idle > 0:
+        print(f"Sampling idle frame time for {args.idle:g}s...")
+        await asyncio.sleep(args.idle)
+    idle_after = await scrape_frames(host, port)
+
+    print(f"Running {args.connections} HTTP connections and {args.ws_clients} WebSocket clients for {args.duration:g}s against {host}:{port}...")
+
+    stats = Stats()
+    ws_result = {"messages": 0, "bytes": 0, "errors": 0, "firstMessage": [], "intervals": [], "lastError": None}
+    subscriptions = [name.strip() for name in args.subscribe.split(",") if name.strip()]
+
+    load_before = await scrape_frames(host, port)
+    started = time.monotonic()
+    deadline = started + args.duration
+
+    tasks = [http_worker(host, port, endpoints, weights, deadline, stats, random.Random(args.seed + i)) for i in range(args.connections)]
+    tasks += [ws_client(host, port, subscriptions, deadline, ws_result) for _ in range(args.ws_clients if subscriptions else 0)]
+    await asyncio.gather(*tasks)
+
+    elapsed = time.monotonic() - started
+    load_after = await scrape_frames(host, port)
+
+    return build_report(args, stats, ws_result, elapsed, frame_window(idle_before, idle_after), frame_window(load_before, load_after))
+
+
+def build_report(args, stats, ws_result, elapsed, idle_frames, load_frames):
+    report = {
+        "target": "mock" if args.mock else f"{args.host}:{args.port}",
+        "connections": args.connections,
+        "wsClients": args.ws_clients,
+        "durationSeconds": elapsed,
+        "endpoints": [],
+    }
+
+    all_latencies = []
+    total_requests = total_errors = total_bytes = 0
+
+    for endpoint in sorted(set(stats.latencies) | set(stats.errors)):
+        latencies = sorted(stats.latencies.get(endpoint, []))
+        errors = stats.errors.get(endpoint, 0)
+        size = stats.bytes.get(endpoint, 0)
+
+        all_latencies += latencies
+        total_requests += len(latencies) + errors
+        total_errors += errors
+        total_bytes += size
+
+        report["endpoints"].append({
+            "endpoint": endpoint,
+            "requests": len(latencies) + errors,
+            "errors": errors,
+            "p50Ms": percentile(latencies, 50) * 1000,
+            "p95Ms": percentile(latencies, 95) * 1000,
+            "p99Ms": percentile(latencies, 99) * 1000,
+            "maxMs": (latencies[-1] if latencies else 0) * 1000,
+            "requestsPerSecond": (len(latencies) + errors) / elapsed,
+            "bytes": size,
+        })
+
+    all_latencies.sort()
+    report["total"] = {
+        "requests": total_requests,
+        "errors": total_errors,
+        "errorPercent": 100.0 * total_errors / total_requests if total_requests else 0.0,
+        "p50Ms": percentile(all_latencies, 50) * 1000,
+        "p95Ms": percentile(all_latencies, 95) * 1000,
+        "p99Ms": percentile(all_latencies, 99) * 1000,
+        "requestsPerSecond": total_requests / elapsed,
+        "megabytesPerSecond": total_bytes / elapsed / 1e6,
+    }
+
+    intervals = sorted(ws_result["intervals"])
+    first = sorted(ws_result["firstMessage"])
+    report["websocket"] = {
+        "messages": ws_result["messages"],
+        "bytes": ws_result["bytes"],
+        "errors": ws_result["errors"],
+        "lastError": ws_result["lastError"],
+        "firstMessageP50Ms": percentile(first, 50) * 1000,
+        "messageIntervalP50Ms": percentile(intervals, 50) * 1000,
+        "messageIntervalP99Ms": percentile(intervals, 99) * 1000,
+    }
+
+    report["frameTime"] = {"idle": idle_frames, "load": load_frames}
+    return report
+
+
+def print_report(report):
+    print()
+    print(f"{'endpoint':<20} {'reqs':>8} {'err':>6} {'p50 ms':>9} {'p95 ms':>9} {'p99 ms':>9} {'max ms':>9} {'req/s':>9}")
+    for row in report["endpoints"]:
+        print(f"{row['endpoint']:<20} {row['requests']:>8} {row['errors']:>6} {row['p50Ms']:>9.2f} {row['p95Ms']:>9.2f} "
+              f"{row['p99Ms']:>9.2f} {row['maxMs']:>9.2f} {row['requestsPerSecond']:>9.1f}")
+
+    total = report["total"]
+    print(f"{'total':<20} {total['requests']:>8} {total['errors']:>6} {total['p50Ms']:>9.2f} {total['p95Ms']:>9.2f} "
+          f"{total['p99Ms']:>9.2f} {'':>9} {total['requestsPerSecond']:>9.1f}")
+    print(f"\nThroughput: {total['requestsPerSecond']:.1f} req/s, {total['megabytesPerSecond']:.2f} MB/s, errors {total['errorPercent']:.2f}%")
+
+    ws = report["websocket"]
+    if ws["messages"] or ws["errors"]:
+        print(f"WebSocket: {ws['messages']} messages, {ws['bytes'] / 1e6:.2f} MB, {ws['errors']} failed clients, "
+              f"first message p50 {ws['firstMessageP50Ms']:.1f} ms, message interval p50 {ws['messageIntervalP50Ms']:.1f} ms / p99 {ws['messageIntervalP99Ms']:.1f} ms")
+        if ws["lastError"]:
+            print(f"  last error: {ws['lastError']}")
+
+    idle, load = report["frameTime"]["idle"], report["frameTime"]["load"]
+    if load:
+        line = f"Frame time under load: mean {load['meanMs']:.2f} ms, p95 {load['p95Ms']:.2f} ms, p99 {load['p99Ms']:.2f} ms, {load['over33msPercent']:.1f}% over 33 ms"
+        if idle:
+            line += f" (idle: mean {idle['meanMs']:.2f} ms, p99 {idle['p99Ms']:.2f} ms)"
+        print(line)
+    else:
+        print("Frame time: not available, the server does not expose frm_game_frame_seconds on /metrics")
+
+
+# ---------------------------------------------------------------------------
+# Mock server
+# ---------------------------------------------------------------------------
+
+class MockWorld:
+    """Synthetic world with rows shaped like FRM's, serialized on every request like the live server."""
+
+    ITEMS = ["Iron Plate", "Iron Rod", "Screw", "Reinforced Iron Plate", "Copper Sheet", "Wire", "Cable", "Concrete",
+             "Steel Beam", "Steel Pipe", "Rotor", "Modular Frame", "Computer", "Plastic", "Rubber", "Quickwire"]
+
+    def __init__(self, size, seed):
+        rng = random.Random(seed)
+
+        def location():
+            return {"x": rng.uniform(-320000, 420000), "y": rng.uniform(-370000, 370000), "z": rng.uniform(-5000, 40000)}
+
+        def item(amount):
+            name = rng.choice(self.ITEMS)
+            return {"Name": name, "ClassName": "Desc_" + name.replace(" ", "") + "_C", "Amount": amount, "MaxAmount": 200}
+
+        def features(loc, name):
+            return {"properties": {"name": name, "type": name}, "geometry": {"coordinates": loc, "type": "Point"}}
+
+        factories = []
+        for i in range(size):
+            loc = location()
+            factories.append({
+                "ID": f"Build_AssemblerMk1_C_{i}", "Name": "Assembler", "ClassName": "Build_AssemblerMk1_C",
+                "location": dict(loc, rotation=rng.uniform(0, 360)), "Recipe": "Reinforced Iron Plate",
+                "RecipeClassName": "Recipe_ReinforcedIronPlate_C",
+                "production": [dict(item(rng.randint(0, 200)), CurrentProd=rng.uniform(0, 5), MaxProd=5, ProdPercent=rng.uniform(0, 100))],
+                "ingredients": [dict(item(rng.randint(0, 200)), CurrentConsumed=rng.uniform(0, 30), MaxConsumed=30, ConsPercent=rng.uniform(0, 100)) for _ in range(2)],
+                "Productivity": rng.uniform(0, 100), "ManuSpeed": 100, "IsConfigured": True, "IsProducing": True, "IsPaused": False,
+                "PowerInfo": {"CircuitGroupID": 0, "CircuitID": rng.randint(0, max(1, size // 500)), "PowerConsumed": 15, "MaxPowerConsumed": 15},
+                "features": features(loc, "Assembler"),
+            })
+
+        belts = []
+        for i in range(size):
+            start, end = location(), location()
+            belts.append({
+                "ID": f"Build_ConveyorBeltMk5_C_{i}", "Name": "Conveyor Belt Mk.5", "ClassName": "Build_ConveyorBeltMk5_C",
+                "location0": start, "Connected0": True, "location1": end, "Connected1": True,
+                "Length": rng.uniform(100, 5600), "ItemsPerMinute": 780,
+                "features": {"properties": {"name": "Conveyor Belt Mk.5", "type": "Conveyor Belt Mk.5"},
+                             "geometry": {"coordinates": [list(start.values()), list(end.values())], "type": "LineString"}},
+            })
+
+        storages = [{
+            "ID": f"Build_StorageContainerMk2_C_{i}", "Name": "Storage Container Mk.2", "ClassName": "Build_StorageContainerMk2_C",
+            "location": dict(location(), rotation=0), "Inventory": [item(rng.randint(1, 2400)) for _ in range(6)],
+        } for i in range(max(1, size // 10))]
+
+        trains = [{
+            "ID": f"FGTrain_{i}", "Name": f"Train {i}", "ClassName": "FGTrain", "location": dict(location(), rotation=0),
+            "ForwardSpeed": rng.uniform(0, 120), "TrainStation": f"Station {i % 20}", "Derailed": False, "Status": "Self-Driving",
+            "Vehicles": [{"Name": "Freight Car", "Inventory": [item(rng.randint(1, 1600))]} for _ in range(rng.randint(1, 4))],
+        } for i in range(max(1, size // 100))]
+
+        circuits = [{
+            "CircuitGroupID": i, "CircuitID": i, "PowerProduction": rng.uniform(0, 10000), "PowerConsumed": rng.uniform(0, 10000),
+            "PowerCapacity": 10000, "PowerMaxConsumed": 12000, "BatteryPercent": rng.uniform(0, 100), "FuseTriggered": False,
+        } for i in range(max(1, size // 500))]
+
+        prod_stats = [{
+            "Name": name, "ClassName": "Desc_" + name.replace(" ", "") + "_C", "ProdPerMin": f"P:{rng.uniform(0, 500):.1f}/min",
+            "CurrentProd": rng.uniform(0, 500), "MaxProd": 500, "CurrentConsumed": rng.uniform(0, 500), "MaxConsumed": 500,
+            "ProdPercent": rng.uniform(0, 100), "ConsPercent": rng.uniform(0, 100),
+        } for name in self.ITEMS]
+
+        self.rows = {
+            "getFactory": factories, "getAssembler": factories, "getBelts": belts, "getStorageInv": storages,
+            "getTrains": trains, "getPower": circuits, "getProdStats": prod_stats,
+            "getWorldInv": [item(rng.randint(1, 100000)) for _ in range(len(self.ITEMS))],
+            "getPlayer": [{"ID": "Char_Player_C_0", "Name": "Pioneer", "location": location(), "Online": True, "PlayerHP": 100}],
+        }
+
+    def serialize(self, endpoint):
+        rows = self.rows.get(endpoint)
+        return None if rows is None else json.dumps(rows, separators=(",", ":")).encode()
+
+
+class MockServer:
+    def __init__(self, world, push_cycle):
+        self.world = world
+        self.push_cycle = push_cycle
+        self.frames = [0] * len(FRAME_BUCKETS)
+        self.frame_sum = 0.0
+        self.frame_count = 0
+
+    async def game_loop(self):
+        # a 60 Hz tick sharing the event loop with the handlers stands in for the game thread
+        last = time.perf_counter()
+        while True:
+            await asyncio.sleep(1 / 60)
+            now = time.perf_counter()
+            frame, last = now - last, now
+            self.frames[next(i for i, bound in enumerate(FRAME_BUCKETS) if frame <= bound)] += 1
+            self.frame_sum += frame
+            self.frame_count += 1
+
+    def metrics(self):
+        lines = ["# TYPE frm_game_frame_seconds histogram"]
+        cumulative = 0
+        for bound, count in zip(FRAME_BUCKETS, self.frames):
+            cumulative += count
+            lines.append(f'frm_game_frame_seconds_bucket{{le="{"+Inf" if bound == float("inf") else bound}"}} {cumulative}')
+        lines.append(f"frm_game_frame_seconds_sum {self.frame_sum:.9f}")
+        lines.append(f"frm_game_frame_seconds_count {self.frame_count}")
+        lines.append("# EOF")
+        return ("\n".join(lines) + "\n").encode()
+
+    async def handle(self, reader, writer):
+        try:
+            while True:
+                request_line = await reader.readline()
+                if not request_line:
+                    break
+                _, path, _ = request_line.decode("latin-1").split(" ", 2)
+
+                headers = {}
+                while True:
+                    line = await reader.readline()
+                    if line in (b"\r\n", b"\n", b""):
+                        break
+                    key, _, value = line.decode("latin-1").partition(":")
+                    headers[key.strip().lower()] = value.strip()
+
+                if headers.get("upgrade", "").lower() == "websocket":
+                    await self.handle_websocket(reader, writer, headers)
+                    break
+
+                status, content_type, body = "404 Not Found", "application/json", b'{"error":"No matching endpoint found."}'
+                if path == "/metrics":
+                    status, content_type, body = "200 OK", "application/openmetrics-text; version=1.0.0; charset=utf-8", self.metrics()
+                elif path.startswith("/api/"):
+                    payload = self.world.serialize(path[5:].split("?", 1)[0])
+                    if payload is not None:
+                        status, body = "200 OK", payload
+
+                writer.write(f"HTTP/1.1 {status}\r\nContent-Type: {content_type}\r\nContent-Length: {len(body)}\r\n\r\n".encode() + body)
+                await writer.drain()
+
+                if headers.get("connection", "").lower() == "close":
+                    break
+        except (ConnectionError, asyncio.IncompleteReadError, ValueError, asyncio.CancelledError):
+            pass
+        finally:
+            writer.close()
+
+    async def handle_websocket(self, reader, writer, headers):
+        accept = base64.b64encode(hashlib.sha1((headers["sec-websocket-key"] + WS_GUID).encode()).digest()).decode()
+        writer.write(f"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: {accept}\r\n\r\n".encode())
+
+        subscriptions = set()
+
+        async def push():
+            while True:
+                await asyncio.sleep(self.push_cycle)
+                for endpoint in list(subscriptions):
+                    payload = self.world.serialize(endpoint)
+                    if payload is not None:
+                        writer.write(ws_frame(0x1, payload, mask=False))
+                await writer.drain()
+
+        pusher = asyncio.ensure_future(push())
+        try:
+            while True:
+                _, message = await ws_read_message(reader, writer)
+                request = json.loads(message)
+                endpoints = request.get("endpoints", [])
+                endpoints = [endpoints] if isinstance(endpoints, str) else endpoints
+                if request.get("action") == "subscribe":
+                    subscriptions.update(endpoints)
+                elif request.get("action") == "unsubscribe":
+                    subscriptions.difference_update(endpoints)
+        except (ConnectionError, asyncio.IncompleteReadError, ValueError, asyncio.CancelledError):
+            pass
+        finally:
+            pusher.cancel()
+
+
+# ---------------------------------------------------------------------------
+
+async def main_async(args):
+    if not args.mock:
+        return await run_load(args, args.host, args.port)
+
+    print(f"Generating mock world with {args.mock_size} factories...")
+    mock = MockServer(MockWorld(args.mock_size, args.seed), args.push_cycle)
+    server = await asyncio.start_server(mock.handle, "127.0.0.1", 0)
+    ticker = asyncio.ensure_future(mock.game_loop())
+    try:
+        return await run_load(args, "127.0.0.1", server.sockets[0].getsockname()[1])
+    finally:
+        ticker.cancel()
+        server.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load and latency test for the Ficsit Remote Monitoring web server.")
+    parser.add_argument("--host", default="127.0.0.1", help="FRM host (default: 127.0.0.1)")
+    parser.add_argument("--port", type=int, default=8080, help="FRM HTTP_Port (default: 8080)")
+    parser.add_argument("--connections", "-c", type=int, default=8, help="concurrent keep-alive HTTP connections (default: 8)")
+    parser.add_argument("--duration", "-d", type=float, default=30, help="seconds of load (default: 30)")
+    parser.add_argument("--mix", default=DEFAULT_MIX, help="weighted endpoints, e.g. getPower:4,getFactory:1")
+    parser.add_argument("--ws-clients", "-w", type=int, default=0, help="WebSocket clients (default: 0)")
+    parser.add_argument("--subscribe", default="getPower,getTrains", help="endpoints each WebSocket client subscribes to")
+    parser.add_argument("--idle", type=float, default=5, help="seconds of idle frame time to sample before the load (default: 5)")
+    parser.add_argument("--seed", type=int, default=1337, help="seed for the request mix and the mock world")
+    parser.add_argument("--json", metavar="FILE", help="also write the report to FILE as JSON")
+    parser.add_argument("--mock", action="store_true", help="run against a built-in synthetic server instead of the game")
+    parser.add_argument("--mock-size", type=int, default=10000, help="factories and belts in the mock world (default: 10000)")
+    parser.add_argument("--push-cycle", type=float, default=1.0, help="mock WebSocket push interval in seconds (default: 1)")
+    args = parser.parse_args()
+
+    report = asyncio.run(main_async(args))
+    print_report(report)
+
+    if args.json:
+        with open(args.json, "w", encoding="utf-8") as file:
+            json.dump(report, file, indent=2)
+        print(f"\nReport written to {args.json}")
+
+    return 1 if report["total"]["requests"] == 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())